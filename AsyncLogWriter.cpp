@@ -0,0 +1,209 @@
+#include "AsyncLogWriter.h"
+#include <cerrno>
+#include <chrono>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <unistd.h>
+#define ASYNC_LOG_POSIX
+#endif
+
+AsyncLogWriter::AsyncLogWriter(const string& fileName, Overflow overflow, size_t capacity, size_t batchBytes)
+    : overflow(overflow), batchBytes(batchBytes > 0 ? batchBytes : 1), writePosition(0), writtenPosition(0),
+      dropped(0), blocked(0), written(0), writes(0), bytes(0), sleeping(false), stopping(false), fd(-1) {
+    // A power of two, so a position maps to its slot with a mask
+    this->capacity = 2;
+    while (this->capacity < capacity) this->capacity <<= 1;
+    mask = this->capacity - 1;
+
+    slots.reset(new Slot[this->capacity]);
+    for (size_t i = 0; i < this->capacity; i++) {
+        slots[i].sequence.store(i, memory_order_relaxed);
+    }
+
+#ifdef ASYNC_LOG_POSIX
+    fd = ::open(fileName.c_str(), O_WRONLY | O_CREAT | O_APPEND, 0644);
+#else
+    stream.open(fileName, ios::app | ios::binary);
+#endif
+
+    if (isOpen()) {
+        writer = thread(&AsyncLogWriter::writerLoop, this);
+    }
+}
+
+AsyncLogWriter::~AsyncLogWriter() {
+    if (writer.joinable()) {
+        stopping.store(true, memory_order_release);
+        {
+            lock_guard<mutex> lock(wakeMutex);
+            wake.notify_one();
+        }
+        writer.join();
+    }
+
+#ifdef ASYNC_LOG_POSIX
+    if (fd >= 0) ::close(fd);
+#endif
+}
+
+bool AsyncLogWriter::isOpen() const {
+#ifdef ASYNC_LOG_POSIX
+    return fd >= 0;
+#else
+    return stream.is_open();
+#endif
+}
+
+bool AsyncLogWriter::tryPush(string& record) {
+    size_t position = writePosition.load(memory_order_relaxed);
+    while (true) {
+        Slot& slot = slots[position & mask];
+        size_t sequence = slot.sequence.load(memory_order_acquire);
+        intptr_t turn = static_cast<intptr_t>(sequence) - static_cast<intptr_t>(position);
+
+        if (turn == 0) {
+            // The slot is free for this position: claim it (on failure position holds the new write position)
+            if (writePosition.compare_exchange_weak(position, position + 1, memory_order_relaxed)) {
+                slot.record = move(record);
+                slot.sequence.store(position + 1, memory_order_release);
+                return true;
+            }
+        }
+        else if (turn < 0) {
+            return false; // the writer has not freed this slot yet: the ring is full
+        }
+        else {
+            position = writePosition.load(memory_order_relaxed); // another producer took it
+        }
+    }
+}
+
+bool AsyncLogWriter::tryPop(size_t position, string& record) {
+    Slot& slot = slots[position & mask];
+    if (slot.sequence.load(memory_order_acquire) != position + 1) {
+        return false; // empty, or claimed and not filled yet
+    }
+
+    record = move(slot.record);
+    slot.record.clear();
+    slot.sequence.store(position + capacity, memory_order_release); // free for the producer one lap later
+    return true;
+}
+
+void AsyncLogWriter::notifyWriter() {
+    // Pairs with the fence in writerLoop: either the writer sees the record or this sees it going to sleep
+    atomic_thread_fence(memory_order_seq_cst);
+    if (sleeping.load(memory_order_relaxed)) {
+        lock_guard<mutex> lock(wakeMutex);
+        wake.notify_one();
+    }
+}
+
+bool AsyncLogWriter::push(string record) {
+    if (!isOpen()) return false;
+
+    if (!tryPush(record)) {
+        if (overflow == Overflow::Drop) {
+            dropped.fetch_add(1, memory_order_relaxed);
+            return false;
+        }
+
+        blocked.fetch_add(1, memory_order_relaxed);
+        do {
+            notifyWriter();
+            this_thread::yield();
+        } while (!tryPush(record));
+    }
+
+    notifyWriter();
+    return true;
+}
+
+void AsyncLogWriter::flush() {
+    if (!isOpen()) return;
+
+    size_t target = writePosition.load(memory_order_acquire);
+    unique_lock<mutex> lock(wakeMutex);
+    while (writtenPosition.load(memory_order_acquire) < target) {
+        wake.notify_one();
+        drained.wait_for(lock, chrono::milliseconds(10));
+    }
+}
+
+void AsyncLogWriter::writeBatch(const string& batch) {
+#ifdef ASYNC_LOG_POSIX
+    const char* data = batch.data();
+    size_t remaining = batch.size();
+    while (remaining > 0) {
+        ssize_t count = ::write(fd, data, remaining);
+        if (count < 0) {
+            if (errno == EINTR) continue;
+            break; // nowhere to report it; the records are lost like with a failed stream
+        }
+        data += count;
+        remaining -= static_cast<size_t>(count);
+    }
+#else
+    stream.write(batch.data(), static_cast<streamsize>(batch.size()));
+    stream.flush();
+#endif
+
+    writes.fetch_add(1, memory_order_relaxed);
+    bytes.fetch_add(batch.size(), memory_order_relaxed);
+}
+
+void AsyncLogWriter::writerLoop() {
+    string batch;
+    batch.reserve(batchBytes + 256);
+    string record;
+    size_t position = 0;
+
+    while (true) {
+        size_t popped = 0;
+        while (batch.size() < batchBytes && tryPop(position, record)) {
+            batch += record;
+            batch += '\n';
+            position++;
+            popped++;
+        }
+
+        if (popped > 0) {
+            writeBatch(batch);
+            batch.clear();
+            written.fetch_add(popped, memory_order_relaxed);
+            writtenPosition.store(position, memory_order_release);
+
+            lock_guard<mutex> lock(wakeMutex);
+            drained.notify_all();
+            continue;
+        }
+
+        // Nothing to write: stop once every claimed slot was written, otherwise sleep until a producer calls
+        if (stopping.load(memory_order_acquire) && position == writePosition.load(memory_order_acquire)) {
+            break;
+        }
+
+        unique_lock<mutex> lock(wakeMutex);
+        sleeping.store(true, memory_order_relaxed);
+        atomic_thread_fence(memory_order_seq_cst);
+        if (slots[position & mask].sequence.load(memory_order_acquire) != position + 1 && !stopping.load(memory_order_acquire)) {
+            wake.wait_for(lock, chrono::milliseconds(10));
+        }
+        sleeping.store(false, memory_order_relaxed);
+    }
+}
+
+AsyncLogWriter::Statistics AsyncLogWriter::getStatistics() const {
+    Statistics statistics;
+    statistics.written = written.load(memory_order_relaxed);
+    statistics.dropped = dropped.load(memory_order_relaxed);
+    statistics.blocked = blocked.load(memory_order_relaxed);
+    statistics.writes = writes.load(memory_order_relaxed);
+    statistics.bytes = bytes.load(memory_order_relaxed);
+    return statistics;
+}
+
+size_t AsyncLogWriter::getCapacity() const {
+    return capacity;
+}
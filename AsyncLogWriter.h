@@ -0,0 +1,101 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+using namespace std;
+
+// Appends log records to a file from a background thread, so the threads that log never wait for the disk.
+//
+// Producers move their records into a bounded ring of slots (any number of producers, one consumer). Claiming
+// a slot is a single compare-and-swap on the write position and every slot carries a sequence number telling
+// whose turn it is, so producers never take a lock. The writer thread drains the ring in order, joins records
+// into one buffer (a line each) and hands it to the file with one large write() once it is full or the ring
+// runs dry. Memory stays bounded: a producer that finds the ring full either waits for a free slot (Block) or
+// drops its record (Drop), and both are counted. flush() waits until everything logged so far is written, and
+// the destructor writes every record still queued before closing the file.
+class AsyncLogWriter {
+    public:
+        // What a producer does when the ring is full
+        enum class Overflow {
+            Block, // waits for the writer to free a slot (no record is lost)
+            Drop   // discards the record and counts it (logging never slows the game down)
+        };
+
+        // Counters since the writer was created
+        struct Statistics {
+            uint64_t written = 0;  // records handed to the file
+            uint64_t dropped = 0;  // records discarded because the ring was full (Drop)
+            uint64_t blocked = 0;  // records whose producer had to wait for a free slot (Block)
+            uint64_t writes = 0;   // write() calls made, one per batch
+            uint64_t bytes = 0;    // bytes written
+        };
+
+        // Opens fileName for appending and starts the writer thread; capacity is rounded up to a power of two
+        AsyncLogWriter(const string& fileName, Overflow overflow = Overflow::Block, size_t capacity = 4096,
+                       size_t batchBytes = 64 * 1024);
+
+        // The writer thread works on this object, so it cannot be copied
+        AsyncLogWriter(const AsyncLogWriter& other) = delete;
+        AsyncLogWriter& operator=(const AsyncLogWriter& other) = delete;
+
+        // Writes every record still queued, then stops the writer thread and closes the file
+        ~AsyncLogWriter();
+
+        bool isOpen() const;
+
+        // Queues one line (without its line break); false when it was dropped or the file is not open.
+        // Safe from any thread; records of one thread are written in the order they were pushed.
+        bool push(string record);
+
+        // Waits until every record pushed before the call is written
+        void flush();
+
+        Statistics getStatistics() const;
+        size_t getCapacity() const;
+
+    private:
+        struct Slot {
+            atomic<size_t> sequence; // == position: free for the producer claiming it; == position + 1: holds a record
+            string record;
+        };
+
+        unique_ptr<Slot[]> slots;
+        size_t capacity;
+        size_t mask;
+        Overflow overflow;
+        size_t batchBytes;
+
+        // Producers claim positions here; the writer publishes how far it has written after each batch
+        alignas(64) atomic<size_t> writePosition;
+        alignas(64) atomic<size_t> writtenPosition;
+
+        atomic<uint64_t> dropped;
+        atomic<uint64_t> blocked;
+        atomic<uint64_t> written;
+        atomic<uint64_t> writes;
+        atomic<uint64_t> bytes;
+
+        // The writer sleeps only when the ring is empty; producers wake it, and it wakes flush() after each batch
+        mutex wakeMutex;
+        condition_variable wake;
+        condition_variable drained;
+        atomic<bool> sleeping;
+        atomic<bool> stopping;
+
+        int fd;          // -1 when the file is not open
+        ofstream stream; // used instead of fd where write() is not available
+        thread writer;
+
+        bool tryPush(string& record);
+        bool tryPop(size_t position, string& record);
+        void notifyWriter();
+        void writeBatch(const string& batch);
+        void writerLoop();
+};
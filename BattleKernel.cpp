@@ -0,0 +1,345 @@
+#include "BattleKernel.h"
+#include <algorithm>
+#include <cmath>
+#include "CpuFeatures.h"
+
+// Outcomes must not depend on whether the compiler fuses a * b + c into a single rounding
+#if defined(__clang__)
+#pragma STDC FP_CONTRACT OFF
+#elif defined(__GNUC__)
+#pragma GCC optimize("fp-contract=off")
+#endif
+
+namespace {
+    const uint32_t PhiloxM0 = 0xD2511F53;
+    const uint32_t PhiloxM1 = 0xCD9E8D57;
+    const uint32_t PhiloxW0 = 0x9E3779B9; // key schedule increments
+    const uint32_t PhiloxW1 = 0xBB67AE85;
+    const int PhiloxRounds = 10;
+
+    const double Ln2 = 0.69314718055994530942;
+    const double Sqrt1_2 = 0.70710678118654752440;
+
+    // Bin(n, p) is sampled as Bin(n, min(p, 1 - p)), flipped back when p > 1/2, so inversion walks the short tail
+    struct BinomialRate {
+        double p;      // min(p, 1 - p)
+        double q;      // 1 - this->p
+        double s;      // p / q, the factor of the pmf recurrence
+        bool flipped;
+
+        constexpr explicit BinomialRate(double rate)
+            : p(rate > 0.5 ? 1.0 - rate : rate), q(1.0 - p), s(p / q), flipped(rate > 0.5) {}
+    };
+
+    constexpr BinomialRate AttackerRate(BattleKernel::AttackerKillRate);
+    constexpr BinomialRate DefenderRate(BattleKernel::DefenderKillRate);
+
+    double power(double base, int exponent) {
+        double result = 1.0;
+        for (; exponent > 0; exponent >>= 1) {
+            if (exponent & 1) result *= base;
+            base *= base;
+        }
+        return result;
+    }
+
+    // Natural logarithm from frexp and the atanh series: exact operations and + - * / only
+    double portableLog(double x) {
+        int exponent;
+        double m = frexp(x, &exponent); // x = m * 2^exponent, m in [1/2, 1)
+        if (m < Sqrt1_2) {
+            m *= 2.0;
+            exponent--;
+        }
+
+        // log(m) = 2 atanh(t) = 2t (1 + t^2/3 + t^4/5 + ...), |t| < 0.18 so eleven terms reach double precision
+        double t = (m - 1.0) / (m + 1.0);
+        double t2 = t * t;
+        double sum = 1.0 / 23.0;
+        for (int k = 21; k >= 1; k -= 2) {
+            sum = sum * t2 + 1.0 / k;
+        }
+        return 2.0 * t * sum + exponent * Ln2;
+    }
+
+    // Standard normal quantile (Acklam's rational approximation, relative error below 1.2e-9)
+    double inverseNormal(double u) {
+        static const double a[] = { -3.969683028665376e+01, 2.209460984245205e+02, -2.759285104469687e+02,
+                                    1.383577518672690e+02, -3.066479806614716e+01, 2.506628277459239e+00 };
+        static const double b[] = { -5.447609879822406e+01, 1.615858368580409e+02, -1.556989798598866e+02,
+                                    6.680131188771972e+01, -1.328068155288572e+01 };
+        static const double c[] = { -7.784894002430293e-03, -3.223964580411365e-01, -2.400758277161838e+00,
+                                    -2.549732539343734e+00, 4.374664141464968e+00, 2.938163982698783e+00 };
+        static const double d[] = { 7.784695709041462e-03, 3.224671290700398e-01, 2.445134137142996e+00,
+                                    3.754408661907416e+00 };
+        const double tail = 0.02425;
+
+        if (u < tail || u > 1.0 - tail) {
+            double q = sqrt(-2.0 * portableLog(u < tail ? u : 1.0 - u));
+            double x = (((((c[0] * q + c[1]) * q + c[2]) * q + c[3]) * q + c[4]) * q + c[5])
+                / ((((d[0] * q + d[1]) * q + d[2]) * q + d[3]) * q + 1.0);
+            return u < tail ? x : -x;
+        }
+
+        double q = u - 0.5;
+        double r = q * q;
+        return (((((a[0] * r + a[1]) * r + a[2]) * r + a[3]) * r + a[4]) * r + a[5]) * q
+            / (((((b[0] * r + b[1]) * r + b[2]) * r + b[3]) * r + b[4]) * r + 1.0);
+    }
+
+    bool usesInversion(int n, const BinomialRate& rate) {
+        return n * rate.p < BattleKernel::InversionLimit;
+    }
+
+    // Walks the pmf from 0 until the uniform is used up: f(x) = f(x - 1) * ((n + 1) s / x - s), f(0) = q^n
+    int invert(int n, const BinomialRate& rate, double u) {
+        double a = (n + 1) * rate.s;
+        double r = power(rate.q, n);
+        int x = 0;
+        while (u >= r && x < n) {
+            u -= r;
+            x++;
+            r *= a / x - rate.s;
+        }
+        return x;
+    }
+
+    int approximate(int n, const BinomialRate& rate, double u) {
+        double mean = n * rate.p;
+        double sd = sqrt(mean * rate.q);
+        double x = floor(mean + sd * inverseNormal(u) + 0.5);
+        return static_cast<int>(min(max(x, 0.0), static_cast<double>(n)));
+    }
+
+    int sample(int n, const BinomialRate& rate, double u) {
+        if (n <= 0) return 0;
+        int x = usesInversion(n, rate) ? invert(n, rate, u) : approximate(n, rate, u);
+        return rate.flipped ? n - x : x;
+    }
+}
+
+PhiloxBlock BattleKernel::philox(const PhiloxBlock& counter, uint64_t key) {
+    uint32_t x0 = counter.words[0], x1 = counter.words[1], x2 = counter.words[2], x3 = counter.words[3];
+    uint32_t k0 = static_cast<uint32_t>(key), k1 = static_cast<uint32_t>(key >> 32);
+
+    for (int round = 0; round < PhiloxRounds; round++) {
+        if (round > 0) {
+            k0 += PhiloxW0;
+            k1 += PhiloxW1;
+        }
+        uint64_t product0 = static_cast<uint64_t>(PhiloxM0) * x0;
+        uint64_t product1 = static_cast<uint64_t>(PhiloxM1) * x2;
+        x0 = static_cast<uint32_t>(product1 >> 32) ^ x1 ^ k0;
+        x1 = static_cast<uint32_t>(product1);
+        x2 = static_cast<uint32_t>(product0 >> 32) ^ x3 ^ k1;
+        x3 = static_cast<uint32_t>(product0);
+    }
+
+    return PhiloxBlock{ { x0, x1, x2, x3 } };
+}
+
+PhiloxBlock BattleKernel::philox(uint64_t key, uint64_t counter) {
+    return philox(PhiloxBlock{ { static_cast<uint32_t>(counter), static_cast<uint32_t>(counter >> 32), 0, 0 } }, key);
+}
+
+double BattleKernel::toUniform(uint32_t high, uint32_t low) {
+    uint64_t bits = (static_cast<uint64_t>(high) << 20) | (low >> 12);
+    return static_cast<double>(2 * bits + 1) * 0x1.0p-53; // odd multiples of 2^-53: never 0, never 1
+}
+
+int BattleKernel::sampleBinomial(int n, double p, double u) {
+    return sample(n, BinomialRate(p), u);
+}
+
+BattleResult BattleKernel::makeResult(int attackers, int defenders, int attackerKills, int defenderKills) {
+    BattleResult result;
+    result.defendersLeft = max(0, defenders - attackerKills);
+    result.attackersLeft = max(0, attackers - defenderKills);
+    result.conquered = result.defendersLeft == 0 && result.attackersLeft > 0;
+    return result;
+}
+
+BattleResult BattleKernel::resolve(int attackers, int defenders, uint64_t key, uint64_t counter) {
+    PhiloxBlock block = philox(key, counter);
+    int attackerKills = sample(attackers, AttackerRate, toUniform(block.words[0], block.words[1]));
+    int defenderKills = sample(defenders, DefenderRate, toUniform(block.words[2], block.words[3]));
+    return makeResult(attackers, defenders, attackerKills, defenderKills);
+}
+
+bool BattleKernel::hasAvx2Kernel() {
+    return cpuHasAvx2();
+}
+
+#if defined(CPU_FEATURES_X86)
+namespace {
+    // High and low halves of the 32x32-bit products of every lane with m
+    CPU_TARGET_AVX2 void multiplyHighLow(__m256i x, __m256i m, __m256i& high, __m256i& low) {
+        __m256i even = _mm256_mul_epu32(x, m);                       // lanes 0, 2, 4, 6 as 64-bit products
+        __m256i odd = _mm256_mul_epu32(_mm256_srli_epi64(x, 32), m); // lanes 1, 3, 5, 7
+        low = _mm256_blend_epi32(even, _mm256_slli_epi64(odd, 32), 0xAA);
+        high = _mm256_blend_epi32(_mm256_srli_epi64(even, 32), odd, 0xAA);
+    }
+
+    // Philox blocks of eight consecutive counters, stored word by word: words[w][lane]
+    CPU_TARGET_AVX2 void philoxLanes(uint64_t key, uint64_t firstCounter, uint32_t (*words)[BattleKernel::Lanes]) {
+        alignas(32) uint32_t counterLow[BattleKernel::Lanes];
+        alignas(32) uint32_t counterHigh[BattleKernel::Lanes];
+        for (int l = 0; l < BattleKernel::Lanes; l++) {
+            counterLow[l] = static_cast<uint32_t>(firstCounter + l);
+            counterHigh[l] = static_cast<uint32_t>((firstCounter + l) >> 32);
+        }
+
+        __m256i x0 = _mm256_load_si256(reinterpret_cast<const __m256i*>(counterLow));
+        __m256i x1 = _mm256_load_si256(reinterpret_cast<const __m256i*>(counterHigh));
+        __m256i x2 = _mm256_setzero_si256();
+        __m256i x3 = _mm256_setzero_si256();
+        __m256i k0 = _mm256_set1_epi32(static_cast<int>(static_cast<uint32_t>(key)));
+        __m256i k1 = _mm256_set1_epi32(static_cast<int>(static_cast<uint32_t>(key >> 32)));
+        const __m256i m0 = _mm256_set1_epi32(static_cast<int>(PhiloxM0));
+        const __m256i m1 = _mm256_set1_epi32(static_cast<int>(PhiloxM1));
+
+        for (int round = 0; round < PhiloxRounds; round++) {
+            if (round > 0) {
+                k0 = _mm256_add_epi32(k0, _mm256_set1_epi32(static_cast<int>(PhiloxW0)));
+                k1 = _mm256_add_epi32(k1, _mm256_set1_epi32(static_cast<int>(PhiloxW1)));
+            }
+            __m256i high0, low0, high1, low1;
+            multiplyHighLow(x0, m0, high0, low0);
+            multiplyHighLow(x2, m1, high1, low1);
+            x0 = _mm256_xor_si256(_mm256_xor_si256(high1, x1), k0);
+            x1 = low1;
+            x2 = _mm256_xor_si256(_mm256_xor_si256(high0, x3), k1);
+            x3 = low0;
+        }
+
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(words[0]), x0);
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(words[1]), x1);
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(words[2]), x2);
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(words[3]), x3);
+    }
+
+    // One step of the inversion walk for the active lanes of four, exactly the scalar operations of invert()
+    CPU_TARGET_AVX2 inline __m256d walkStep(__m256d active, __m256d& U, __m256d& R, __m256d& X, __m256d A, __m256d N, __m256d S) {
+        U = _mm256_blendv_pd(U, _mm256_sub_pd(U, R), active);
+        X = _mm256_blendv_pd(X, _mm256_add_pd(X, _mm256_set1_pd(1.0)), active);
+        R = _mm256_blendv_pd(R, _mm256_mul_pd(R, _mm256_sub_pd(_mm256_div_pd(A, X), S)), active);
+        return _mm256_and_pd(active, _mm256_and_pd(_mm256_cmp_pd(U, R, _CMP_GE_OQ), _mm256_cmp_pd(X, N, _CMP_LT_OQ)));
+    }
+
+    // sample() for eight lanes: the inversion walks run as two interleaved groups of four lanes, lanes past the
+    // inversion limit take the scalar normal approximation
+    CPU_TARGET_AVX2 void sampleLanes(const int32_t* n, const BinomialRate& rate, const double* u, int* kills) {
+        const int Lanes = BattleKernel::Lanes;
+        alignas(32) double a[Lanes], r[Lanes], limit[Lanes], walked[Lanes];
+        bool inverted[Lanes];
+        for (int l = 0; l < Lanes; l++) {
+            inverted[l] = n[l] > 0 && usesInversion(n[l], rate);
+            a[l] = (n[l] + 1) * rate.s;
+            r[l] = inverted[l] ? power(rate.q, n[l]) : 0.0;
+            limit[l] = inverted[l] ? n[l] : 0.0; // x < 0 never holds, so the other lanes start finished
+        }
+
+        const __m256d S = _mm256_set1_pd(rate.s);
+        __m256d U0 = _mm256_loadu_pd(u), U1 = _mm256_loadu_pd(u + 4);
+        __m256d R0 = _mm256_load_pd(r), R1 = _mm256_load_pd(r + 4);
+        __m256d A0 = _mm256_load_pd(a), A1 = _mm256_load_pd(a + 4);
+        __m256d N0 = _mm256_load_pd(limit), N1 = _mm256_load_pd(limit + 4);
+        __m256d X0 = _mm256_setzero_pd(), X1 = _mm256_setzero_pd();
+
+        __m256d active0 = _mm256_and_pd(_mm256_cmp_pd(U0, R0, _CMP_GE_OQ), _mm256_cmp_pd(X0, N0, _CMP_LT_OQ));
+        __m256d active1 = _mm256_and_pd(_mm256_cmp_pd(U1, R1, _CMP_GE_OQ), _mm256_cmp_pd(X1, N1, _CMP_LT_OQ));
+        while (_mm256_movemask_pd(_mm256_or_pd(active0, active1))) {
+            active0 = walkStep(active0, U0, R0, X0, A0, N0, S);
+            active1 = walkStep(active1, U1, R1, X1, A1, N1, S);
+        }
+        _mm256_store_pd(walked, X0);
+        _mm256_store_pd(walked + 4, X1);
+
+        for (int l = 0; l < Lanes; l++) {
+            if (!inverted[l]) {
+                kills[l] = sample(n[l], rate, u[l]);
+                continue;
+            }
+            int x = static_cast<int>(walked[l]);
+            kills[l] = rate.flipped ? n[l] - x : x;
+        }
+    }
+}
+
+CPU_TARGET_AVX2 void BattleKernel::resolveBlockAvx2(const int32_t* attackers, const int32_t* defenders, uint64_t key, uint64_t firstCounter,
+                                    BattleResult* results) {
+    uint32_t words[4][Lanes];
+    philoxLanes(key, firstCounter, words);
+
+    double attackerUniforms[Lanes], defenderUniforms[Lanes];
+    for (int l = 0; l < Lanes; l++) {
+        attackerUniforms[l] = toUniform(words[0][l], words[1][l]);
+        defenderUniforms[l] = toUniform(words[2][l], words[3][l]);
+    }
+
+    int attackerKills[Lanes], defenderKills[Lanes];
+    sampleLanes(attackers, AttackerRate, attackerUniforms, attackerKills);
+    sampleLanes(defenders, DefenderRate, defenderUniforms, defenderKills);
+
+    for (int l = 0; l < Lanes; l++) {
+        results[l] = makeResult(attackers[l], defenders[l], attackerKills[l], defenderKills[l]);
+    }
+}
+#else
+void BattleKernel::resolveBlockAvx2(const int32_t* attackers, const int32_t* defenders, uint64_t key, uint64_t firstCounter,
+                                    BattleResult* results) {
+    for (int l = 0; l < Lanes; l++) {
+        results[l] = resolve(attackers[l], defenders[l], key, firstCounter + l);
+    }
+}
+#endif
+
+void BattleKernel::resolveBatch(const int32_t* attackers, const int32_t* defenders, int count,
+                                uint64_t key, uint64_t firstCounter, BattleResult* results, bool vectorized) {
+    int i = 0;
+    if (vectorized && hasAvx2Kernel()) {
+        for (; i + Lanes <= count; i += Lanes) {
+            resolveBlockAvx2(attackers + i, defenders + i, key, firstCounter + i, results + i);
+        }
+    }
+    for (; i < count; i++) {
+        results[i] = resolve(attackers[i], defenders[i], key, firstCounter + i);
+    }
+}
+
+BattleStream::BattleStream(uint64_t seed) : key(seed), position(0), vectorized(BattleKernel::hasAvx2Kernel()) {}
+
+void BattleStream::seed(uint64_t seed) {
+    key = seed;
+    position = 0;
+}
+
+void BattleStream::seek(uint64_t position) {
+    this->position = position;
+}
+
+uint64_t BattleStream::getSeed() const {
+    return key;
+}
+
+uint64_t BattleStream::getPosition() const {
+    return position;
+}
+
+BattleResult BattleStream::resolve(int attackers, int defenders) {
+    return BattleKernel::resolve(attackers, defenders, key, position++);
+}
+
+void BattleStream::resolve(const int32_t* attackers, const int32_t* defenders, int count, BattleResult* results) {
+    if (count <= 0) return;
+    BattleKernel::resolveBatch(attackers, defenders, count, key, position, results, vectorized);
+    position += count;
+}
+
+void BattleStream::setVectorized(bool enabled) {
+    vectorized = enabled && BattleKernel::hasAvx2Kernel();
+}
+
+bool BattleStream::isVectorized() const {
+    return vectorized;
+}
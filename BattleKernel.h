@@ -0,0 +1,80 @@
+#pragma once
+
+#include <cstdint>
+using namespace std;
+
+// Survivors of a single battle resolved by Advance::resolveBattle or a BattleStream
+struct BattleResult
+{
+    int attackersLeft;
+    int defendersLeft;
+    bool conquered; // all defenders killed with at least one attacker left
+};
+
+// The four 32-bit words Philox produces for one counter
+struct PhiloxBlock {
+    uint32_t words[4];
+};
+
+// Battle randomness that does not depend on the standard library. Each battle is identified by a key (the seed)
+// and a counter (its position in the stream): Philox4x32-10 turns the pair into four random words, two of them
+// make the uniform behind the attacker's kills and two the defender's. A battle's outcome is therefore a pure
+// function of (seed, position, armies), whether it is resolved alone, in a batch or on another thread.
+//
+// Kill counts are binomial, sampled with our own code rather than std::binomial_distribution (whose algorithm
+// differs between libstdc++ and libc++): inversion of the distribution function when n * min(p, 1 - p) is below
+// InversionLimit, a continuity-corrected normal approximation above it. Both use only correctly rounded IEEE
+// operations (no libm transcendental functions, no contracted multiply-adds), so the same seed gives the same
+// battles on every host that computes in IEEE double precision.
+class BattleKernel {
+    public:
+        static constexpr double AttackerKillRate = 0.60; // share of the defenders each attack kills
+        static constexpr double DefenderKillRate = 0.70; // share of the attackers the defence kills
+        static const int InversionLimit = 64;
+        static const int Lanes = 8; // battles per step of the AVX2 kernel
+
+        // Philox4x32-10 of a 128-bit counter under a 64-bit key (low word first in both)
+        static PhiloxBlock philox(const PhiloxBlock& counter, uint64_t key);
+        static PhiloxBlock philox(uint64_t key, uint64_t counter); // counter words 2 and 3 are zero
+        // 52 random bits from two words, as a double strictly inside (0, 1)
+        static double toUniform(uint32_t high, uint32_t low);
+        // Bin(n, p) from a single uniform u in (0, 1); 0 when n <= 0
+        static int sampleBinomial(int n, double p, double u);
+
+        static BattleResult resolve(int attackers, int defenders, uint64_t key, uint64_t counter);
+        // results[i] = resolve(attackers[i], defenders[i], key, firstCounter + i), eight battles per step when vectorized
+        // and the processor has AVX2
+        static void resolveBatch(const int32_t* attackers, const int32_t* defenders, int count,
+                                 uint64_t key, uint64_t firstCounter, BattleResult* results, bool vectorized = true);
+
+        static bool hasAvx2Kernel(); // true when this build contains the AVX2 kernel and this processor can run it
+
+    private:
+        static BattleResult makeResult(int attackers, int defenders, int attackerKills, int defenderKills);
+        static void resolveBlockAvx2(const int32_t* attackers, const int32_t* defenders, uint64_t key, uint64_t firstCounter,
+                                     BattleResult* results);
+};
+
+// A seeded sequence of battles: the n-th battle resolved after seed() always uses counter n
+class BattleStream {
+    private:
+        uint64_t key;
+        uint64_t position;
+        bool vectorized;
+
+    public:
+        explicit BattleStream(uint64_t seed = 0);
+
+        void seed(uint64_t seed); // restarts the stream at its first battle
+        void seek(uint64_t position); // continues with the battle at this position
+        uint64_t getSeed() const;
+        uint64_t getPosition() const; // battles resolved since the last seed()
+
+        BattleResult resolve(int attackers, int defenders);
+        // Resolves count battles at once, with the same results as count calls to resolve()
+        void resolve(const int32_t* attackers, const int32_t* defenders, int count, BattleResult* results);
+
+        // Forces the scalar kernel even when the AVX2 one is available (used to compare the two)
+        void setVectorized(bool enabled);
+        bool isVectorized() const;
+};
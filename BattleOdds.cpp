@@ -0,0 +1,149 @@
+#include "BattleOdds.h"
+#include <algorithm>
+#include <cmath>
+
+namespace {
+    const double AttackerKillRate = 0.60;
+    const double DefenderKillRate = 0.70;
+    const double Pi = 3.14159265358979323846;
+
+    // pmf[n][k] = P(Bin(n, p) = k) for n up to size, built row by row from the previous one
+    vector<vector<double>> binomialRows(int size, double p) {
+        vector<vector<double>> pmf(size + 1);
+        pmf[0] = { 1.0 };
+        for (int n = 1; n <= size; n++) {
+            pmf[n].assign(n + 1, 0.0);
+            for (int k = 0; k < n; k++) {
+                pmf[n][k] += pmf[n - 1][k] * (1.0 - p);
+                pmf[n][k + 1] += pmf[n - 1][k] * p;
+            }
+        }
+        return pmf;
+    }
+
+    double normalCdf(double x) {
+        return 0.5 * erfc(-x / sqrt(2.0));
+    }
+
+    double normalPdf(double x) {
+        return exp(-0.5 * x * x) / sqrt(2.0 * Pi);
+    }
+
+    // E[max(0, X)] for X ~ N(mean, sd^2)
+    double expectedPositivePart(double mean, double sd) {
+        if (sd <= 0.0) return max(0.0, mean);
+        return mean * normalCdf(mean / sd) + sd * normalPdf(mean / sd);
+    }
+
+    // P(Bin(n, p) >= k) with a continuity-corrected normal tail
+    double approximateAtLeast(int n, double p, int k) {
+        if (k <= 0) return 1.0;
+        if (k > n) return 0.0;
+        double sd = sqrt(n * p * (1.0 - p));
+        return 1.0 - normalCdf((k - 0.5 - n * p) / sd);
+    }
+}
+
+void BattleOdds::initialize() {
+    tables();
+}
+
+const BattleOdds::Tables& BattleOdds::tables() {
+    static const Tables instance = build(); // thread-safe one-time initialisation
+    return instance;
+}
+
+int BattleOdds::cell(int attackers, int defenders) {
+    return attackers * (GridSize + 1) + defenders;
+}
+
+BattleOdds::Tables BattleOdds::build() {
+    vector<vector<double>> attackerKills = binomialRows(GridSize, AttackerKillRate);
+    vector<vector<double>> defenderKills = binomialRows(GridSize, DefenderKillRate);
+
+    Tables result;
+    result.conquest.assign((GridSize + 1) * (GridSize + 1), 0.0);
+    result.occupying.assign(result.conquest.size(), 0.0);
+    result.defendersLeft.assign(result.conquest.size(), 0.0);
+
+    for (int a = 0; a <= GridSize; a++) {
+        // Tail sums over the attacker's kills, from the top: atLeast[k] = P(Bin(a, 0.6) >= k)
+        vector<double> atLeast(a + 2, 0.0);
+        for (int k = a; k >= 0; k--) {
+            atLeast[k] = atLeast[k + 1] + attackerKills[a][k];
+        }
+
+        for (int d = 0; d <= GridSize; d++) {
+            double defendersDie = d <= a ? atLeast[d] : 0.0;
+
+            // Attackers left is a - K for K ~ Bin(d, 0.7), and they occupy only if K < a
+            double attackersLive = 0.0;
+            double survivors = 0.0;
+            for (int k = 0; k < min(a, d + 1); k++) {
+                attackersLive += defenderKills[d][k];
+                survivors += (a - k) * defenderKills[d][k];
+            }
+
+            double defendersLeft = 0.0;
+            for (int k = 0; k < min(d, a + 1); k++) {
+                defendersLeft += (d - k) * attackerKills[a][k];
+            }
+
+            result.conquest[cell(a, d)] = defendersDie * attackersLive;
+            result.occupying[cell(a, d)] = defendersDie * survivors;
+            result.defendersLeft[cell(a, d)] = defendersLeft;
+        }
+    }
+
+    return result;
+}
+
+double BattleOdds::conquestProbability(int attackers, int defenders) {
+    if (attackers <= 0) return 0.0;
+    defenders = max(0, defenders);
+    if (attackers <= GridSize && defenders <= GridSize) {
+        return tables().conquest[cell(attackers, defenders)];
+    }
+
+    return approximateAtLeast(attackers, AttackerKillRate, defenders)
+        * (1.0 - approximateAtLeast(defenders, DefenderKillRate, attackers));
+}
+
+double BattleOdds::expectedOccupyingArmies(int attackers, int defenders) {
+    if (attackers <= 0) return 0.0;
+    defenders = max(0, defenders);
+    if (attackers <= GridSize && defenders <= GridSize) {
+        return tables().occupying[cell(attackers, defenders)];
+    }
+
+    // a - Bin(d, 0.7) is roughly normal; only its positive part occupies the territory
+    double mean = attackers - defenders * DefenderKillRate;
+    double sd = sqrt(defenders * DefenderKillRate * (1.0 - DefenderKillRate));
+    return approximateAtLeast(attackers, AttackerKillRate, defenders) * expectedPositivePart(mean, sd);
+}
+
+double BattleOdds::expectedDefendersLeft(int attackers, int defenders) {
+    if (defenders <= 0) return 0.0;
+    attackers = max(0, attackers);
+    if (attackers <= GridSize && defenders <= GridSize) {
+        return tables().defendersLeft[cell(attackers, defenders)];
+    }
+
+    double mean = defenders - attackers * AttackerKillRate;
+    double sd = sqrt(attackers * AttackerKillRate * (1.0 - AttackerKillRate));
+    return expectedPositivePart(mean, sd);
+}
+
+int BattleOdds::attackersNeeded(int defenders, double probability, int maxAttackers) {
+    // Conquest odds only grow with more attackers, so binary search the smallest count
+    if (maxAttackers < 1 || conquestProbability(maxAttackers, defenders) < probability) return -1;
+
+    int low = 1;
+    int high = maxAttackers;
+    while (low < high) {
+        int mid = low + (high - low) / 2;
+        if (conquestProbability(mid, defenders) >= probability) high = mid;
+        else low = mid + 1;
+    }
+    return low;
+}
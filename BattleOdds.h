@@ -0,0 +1,36 @@
+#pragma once
+
+#include <vector>
+using namespace std;
+
+// Exact odds of a single Advance battle (attacker kills 60% of defenders, defender kills 70% of attackers).
+// Both kill counts are independent binomials, so the territory is conquered with probability
+// P(Bin(a, 0.6) >= d) * P(Bin(d, 0.7) < a). Values are tabulated once over a grid of army counts
+// and approximated with normal tails beyond it, so every query is O(1).
+class BattleOdds {
+    public:
+        static const int GridSize = 128; // exact for attackers and defenders up to this many armies
+
+        // Builds the tables (otherwise done on the first query)
+        static void initialize();
+
+        // Probability that the target is conquered
+        static double conquestProbability(int attackers, int defenders);
+        // Expected armies occupying the target afterwards (0 when the attack fails)
+        static double expectedOccupyingArmies(int attackers, int defenders);
+        // Expected defenders left on the target
+        static double expectedDefendersLeft(int attackers, int defenders);
+        // Fewest attackers (up to maxAttackers) conquering with at least the given probability, or -1
+        static int attackersNeeded(int defenders, double probability, int maxAttackers);
+
+    private:
+        struct Tables {
+            vector<double> conquest;
+            vector<double> occupying;
+            vector<double> defendersLeft;
+        };
+
+        static const Tables& tables();
+        static Tables build();
+        static int cell(int attackers, int defenders);
+};
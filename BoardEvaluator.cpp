@@ -0,0 +1,216 @@
+#include "BoardEvaluator.h"
+#include <algorithm>
+#include <numeric>
+#include "CpuFeatures.h"
+
+BoardEvaluator::BoardEvaluator(const BoardTopology* topology, const EvaluationWeights& weights)
+    : topology(topology), weights(weights), vectorized(hasAvx2Kernel()) {
+    territoryCount = topology->getTerritoryCount();
+
+    totalBonus = 0;
+    continentOf.assign(territoryCount, -1);
+    for (int c = 0; c < topology->getContinentCount(); c++) {
+        int size = static_cast<int>(topology->continentEnd(c) - topology->continentBegin(c));
+        totalBonus += topology->getContinentBonus(c);
+        continentWeights.push_back(size > 0 ? static_cast<double>(topology->getContinentBonus(c)) / (size * size) : 0.0);
+        for (const int* t = topology->continentBegin(c); t != topology->continentEnd(c); ++t) {
+            continentOf[*t] = c;
+        }
+    }
+
+    adjacencyOffsets.push_back(0);
+    for (int t = 0; t < territoryCount; t++) {
+        adjacency.insert(adjacency.end(), topology->neighboursBegin(t), topology->neighboursEnd(t));
+        adjacencyOffsets.push_back(static_cast<int32_t>(adjacency.size()));
+    }
+
+    // Highest degree first, so the territories sharing a block need about the same number of neighbour rows
+    vector<int32_t> order(territoryCount);
+    iota(order.begin(), order.end(), 0);
+    auto degree = [topology](int t) { return static_cast<int>(topology->neighboursEnd(t) - topology->neighboursBegin(t)); };
+    stable_sort(order.begin(), order.end(), [&](int a, int b) { return degree(a) > degree(b); });
+
+    int blocks = (territoryCount + Lanes - 1) / Lanes;
+    lanes.assign(blocks * Lanes, 0);
+    laneValid.assign(blocks * Lanes, 0);
+
+    for (int b = 0; b < blocks; b++) {
+        int blockDegree = 0;
+        for (int l = 0; l < Lanes && b * Lanes + l < territoryCount; l++) {
+            lanes[b * Lanes + l] = order[b * Lanes + l];
+            laneValid[b * Lanes + l] = -1;
+            blockDegree = max(blockDegree, degree(order[b * Lanes + l]));
+        }
+
+        blockOffsets.push_back(static_cast<int>(neighbours.size()));
+        blockDegrees.push_back(blockDegree);
+
+        for (int k = 0; k < blockDegree; k++) {
+            for (int l = 0; l < Lanes; l++) {
+                int t = lanes[b * Lanes + l];
+                neighbours.push_back(laneValid[b * Lanes + l] && k < degree(t) ? topology->neighboursBegin(t)[k] : t);
+            }
+        }
+    }
+}
+
+bool BoardEvaluator::hasAvx2Kernel() {
+    return cpuHasAvx2();
+}
+
+void BoardEvaluator::setVectorized(bool enabled) {
+    vectorized = enabled && hasAvx2Kernel();
+}
+
+bool BoardEvaluator::isVectorized() const {
+    return vectorized;
+}
+
+void BoardEvaluator::accumulateScalar(const int32_t* owners, const int32_t* armies, int seatCount, SeatFeatures* features) const {
+    for (int t = 0; t < territoryCount; t++) {
+        int owner = owners[t];
+        if (owner < 0 || owner >= seatCount) continue;
+
+        int pressure = 0;
+        bool frontier = false;
+        for (int i = adjacencyOffsets[t]; i < adjacencyOffsets[t + 1]; i++) {
+            bool enemy = owners[adjacency[i]] != owner;
+            pressure += enemy ? armies[adjacency[i]] : 0;
+            frontier |= enemy;
+        }
+
+        // Masks instead of branches: on a real board these conditions are close to coin flips
+        SeatFeatures& seat = features[owner];
+        seat.territories++;
+        seat.armies += armies[t];
+        seat.frontierArmies += armies[t] & -static_cast<int>(frontier);
+        seat.enemyPressure += pressure; // 0 away from the frontier
+        seat.armiesAtRisk += armies[t] & -static_cast<int>(pressure > armies[t]);
+    }
+}
+
+#if defined(CPU_FEATURES_X86)
+namespace {
+    CPU_TARGET_AVX2 int horizontalSum(__m256i v) {
+        __m128i sum = _mm_add_epi32(_mm256_castsi256_si128(v), _mm256_extracti128_si256(v, 1));
+        sum = _mm_add_epi32(sum, _mm_shuffle_epi32(sum, _MM_SHUFFLE(1, 0, 3, 2)));
+        sum = _mm_add_epi32(sum, _mm_shuffle_epi32(sum, _MM_SHUFFLE(2, 3, 0, 1)));
+        return _mm_cvtsi128_si32(sum);
+    }
+}
+
+CPU_TARGET_AVX2 void BoardEvaluator::accumulateAvx2(const int32_t* owners, const int32_t* armies, int seatCount, SeatFeatures* features) const {
+    // Per seat: territories, armies, frontier armies, enemy pressure, armies at risk
+    __m256i totals[MaxSeats][5];
+    for (int s = 0; s < seatCount; s++) {
+        for (__m256i& total : totals[s]) total = _mm256_setzero_si256();
+    }
+
+    const int blocks = static_cast<int>(blockDegrees.size());
+    for (int b = 0; b < blocks; b++) {
+        __m256i territory = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(&lanes[b * Lanes]));
+        __m256i valid = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(&laneValid[b * Lanes]));
+        __m256i owner = _mm256_i32gather_epi32(owners, territory, 4);
+        __m256i army = _mm256_i32gather_epi32(armies, territory, 4);
+
+        __m256i pressure = _mm256_setzero_si256();
+        __m256i frontier = _mm256_setzero_si256();
+        const int32_t* row = &neighbours[blockOffsets[b]];
+        for (int k = 0; k < blockDegrees[b]; k++, row += Lanes) {
+            __m256i neighbour = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(row));
+            __m256i enemy = _mm256_andnot_si256(_mm256_cmpeq_epi32(_mm256_i32gather_epi32(owners, neighbour, 4), owner),
+                                                _mm256_set1_epi32(-1));
+            pressure = _mm256_add_epi32(pressure, _mm256_and_si256(enemy, _mm256_i32gather_epi32(armies, neighbour, 4)));
+            frontier = _mm256_or_si256(frontier, enemy);
+        }
+
+        __m256i frontierArmies = _mm256_and_si256(frontier, army);
+        __m256i atRisk = _mm256_and_si256(_mm256_cmpgt_epi32(pressure, army), army);
+
+        for (int s = 0; s < seatCount; s++) {
+            __m256i mine = _mm256_and_si256(valid, _mm256_cmpeq_epi32(owner, _mm256_set1_epi32(s)));
+            totals[s][0] = _mm256_sub_epi32(totals[s][0], mine); // mine is -1 per owned lane
+            totals[s][1] = _mm256_add_epi32(totals[s][1], _mm256_and_si256(mine, army));
+            totals[s][2] = _mm256_add_epi32(totals[s][2], _mm256_and_si256(mine, frontierArmies));
+            totals[s][3] = _mm256_add_epi32(totals[s][3], _mm256_and_si256(mine, pressure));
+            totals[s][4] = _mm256_add_epi32(totals[s][4], _mm256_and_si256(mine, atRisk));
+        }
+    }
+
+    for (int s = 0; s < seatCount; s++) {
+        features[s].territories += horizontalSum(totals[s][0]);
+        features[s].armies += horizontalSum(totals[s][1]);
+        features[s].frontierArmies += horizontalSum(totals[s][2]);
+        features[s].enemyPressure += horizontalSum(totals[s][3]);
+        features[s].armiesAtRisk += horizontalSum(totals[s][4]);
+    }
+}
+#else
+void BoardEvaluator::accumulateAvx2(const int32_t* owners, const int32_t* armies, int seatCount, SeatFeatures* features) const {
+    accumulateScalar(owners, armies, seatCount, features);
+}
+#endif
+
+void BoardEvaluator::computeFeatures(const int32_t* owners, const int32_t* armies, int seatCount, SeatFeatures* features) const {
+    seatCount = min(seatCount, static_cast<int>(MaxSeats));
+    for (int s = 0; s < seatCount; s++) {
+        features[s] = SeatFeatures{ 0, 0, 0, 0, 0, 0.0 };
+    }
+
+    if (vectorized) accumulateAvx2(owners, armies, seatCount, features);
+    else accumulateScalar(owners, armies, seatCount, features);
+
+    // Territories held per (continent, seat) in one pass, then bonus * share^2 summed without any division
+    const int continents = static_cast<int>(continentWeights.size());
+    if (continents == 0) return;
+
+    // Counted on the stack unless the board is unusually large (an allocation would cost as much as the whole pass)
+    int32_t localCounts[1024];
+    vector<int32_t> heapCounts;
+    int32_t* owned = localCounts;
+    if (continents * seatCount > 1024) {
+        heapCounts.resize(continents * seatCount);
+        owned = heapCounts.data();
+    }
+    fill(owned, owned + continents * seatCount, 0);
+
+    for (int t = 0; t < territoryCount; t++) {
+        int owner = owners[t];
+        if (continentOf[t] >= 0 && owner >= 0 && owner < seatCount) owned[continentOf[t] * seatCount + owner]++;
+    }
+
+    for (int s = 0; s < seatCount; s++) {
+        double progress = 0.0;
+        for (int c = 0; c < continents; c++) {
+            int count = owned[c * seatCount + s];
+            progress += continentWeights[c] * (count * count);
+        }
+        features[s].continentProgress = progress;
+    }
+}
+
+double BoardEvaluator::score(const SeatFeatures& features) const {
+    if (features.territories == 0) return 0.0;
+
+    double value = weights.territories * features.territories / territoryCount;
+    if (totalBonus > 0) value += weights.continents * features.continentProgress / totalBonus;
+
+    int contested = features.frontierArmies + features.enemyPressure;
+    value += weights.frontier * (contested > 0 ? static_cast<double>(features.frontierArmies) / contested : 1.0);
+    value += weights.risk * (features.armies > 0 ? 1.0 - static_cast<double>(features.armiesAtRisk) / features.armies : 1.0);
+    return value;
+}
+
+void BoardEvaluator::evaluate(const int32_t* owners, const int32_t* armies, int seatCount, double* scores) const {
+    SeatFeatures features[MaxSeats];
+    seatCount = min(seatCount, static_cast<int>(MaxSeats));
+    computeFeatures(owners, armies, seatCount, features);
+
+    for (int s = 0; s < seatCount; s++) {
+        scores[s] = score(features[s]);
+    }
+}
+
+void BoardEvaluator::evaluate(const BoardState& state, double* scores) const {
+    evaluate(state.getOwnerData(), state.getArmyData(), state.getSeatCount(), scores);
+}
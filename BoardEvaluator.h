@@ -0,0 +1,74 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+#include "Simulation.h"
+using namespace std;
+
+// Raw position features of one seat
+struct SeatFeatures {
+    int territories;
+    int armies;
+    int frontierArmies;        // armies on territories with at least one enemy neighbour
+    int enemyPressure;         // enemy armies next to those territories (an enemy counts once per territory it borders)
+    int armiesAtRisk;          // armies on territories outnumbered by their enemy neighbours together
+    double continentProgress;  // sum over continents of bonus * (owned share of the continent)^2
+};
+
+// How much each feature weighs in a seat's score
+struct EvaluationWeights {
+    double territories = 1.0;  // share of the board
+    double continents = 1.0;   // continent progress over the board's total bonus
+    double frontier = 0.5;     // frontier armies / (frontier armies + enemy pressure)
+    double risk = 0.5;         // subtracted: share of the seat's armies at risk
+};
+
+// Static evaluation of a board for every seat in one pass over territory-indexed owner and army arrays.
+// Territories are laid out in blocks of 8 sorted by degree, each with a padded neighbour table, so the
+// AVX2 kernel (in every x86 build, picked at run time when the processor has AVX2) handles a block with
+// gathers and no branches. Otherwise a scalar kernel walks the board's adjacency. Both produce exactly the same features.
+class BoardEvaluator {
+    public:
+        static const int MaxSeats = 16;
+        static const int Lanes = 8;
+
+        explicit BoardEvaluator(const BoardTopology* topology, const EvaluationWeights& weights = EvaluationWeights());
+
+        // Fills features[0 .. seatCount) (seatCount <= MaxSeats); territories owned by seats outside the range are ignored
+        void computeFeatures(const int32_t* owners, const int32_t* armies, int seatCount, SeatFeatures* features) const;
+        // Fills scores[0 .. seatCount): 0 for an eliminated seat, higher is better
+        void evaluate(const int32_t* owners, const int32_t* armies, int seatCount, double* scores) const;
+        void evaluate(const BoardState& state, double* scores) const;
+
+        double score(const SeatFeatures& features) const;
+
+        // Forces the scalar kernel even when the AVX2 one is available (used to compare the two)
+        void setVectorized(bool enabled);
+        bool isVectorized() const;
+        static bool hasAvx2Kernel(); // true when this build contains the AVX2 kernel and this processor can run it
+
+    private:
+        const BoardTopology* topology;
+        EvaluationWeights weights;
+        bool vectorized;
+        int territoryCount;
+        int totalBonus;
+
+        // Block layout: lanes[b * Lanes + l] is a territory, laneValid marks real lanes (-1) against padding (0).
+        // The neighbours of block b are neighbours[blockOffsets[b] + k * Lanes + l] for k < blockDegrees[b];
+        // a lane with fewer neighbours repeats its own territory, which never counts as an enemy.
+        vector<int32_t> lanes;
+        vector<int32_t> laneValid;
+        vector<int32_t> neighbours;
+        vector<int> blockOffsets;
+        vector<int> blockDegrees;
+
+        // Plain copies of the board for the scalar kernel and the continent pass (no calls into the topology per territory)
+        vector<int32_t> adjacencyOffsets;
+        vector<int32_t> adjacency;
+        vector<int32_t> continentOf;       // -1 for territories outside every continent
+        vector<double> continentWeights;   // bonus / size^2, so progress is weight * owned^2
+
+        void accumulateScalar(const int32_t* owners, const int32_t* armies, int seatCount, SeatFeatures* features) const;
+        void accumulateAvx2(const int32_t* owners, const int32_t* armies, int seatCount, SeatFeatures* features) const;
+};
@@ -4,6 +4,9 @@
 #include <cstdlib>
 #include <ctime>
 #include <algorithm>
+#include <cstdint>
+#include <iterator>
+#include "ConsoleLog.h"
 
 // ---------------------- Card ----------------------------
 
@@ -38,41 +41,51 @@ string Card::getTypeAsString() const {
 }
 
 void Card::play(Player* player, Deck* deck, Hand* hand, const CardPlayContext& context) {
-    cout << "[Card] Played: " << getTypeAsString() << endl;
-    cout << "Generated ";
+    Order* order = createOrder(player, context);
+    if (order)
+        player->issueOrder(order);
 
+    // Capture type before removing this from the hand
+    CardType currentType = this->getType();
+    hand->removeCard(this);
+    deck->addCard(make_unique<Card>(currentType));
+}
+
+Order* Card::createOrder(Player* player, const CardPlayContext& context) const {
+    ostream& out = ConsoleLog::out();
+
+    out << "[Card] Played: " << getTypeAsString() << endl;
+    out << "Generated ";
+
+    Order* order = nullptr;
     switch (type) {
     case CardType::Bomb:
-		player->issueOrder(new Bomb(player, context.target));
-        cout << "Bomb";
+        order = new Bomb(player, context.target);
+        out << "Bomb";
         break;
     case CardType::Reinforcement:
-        player->issueOrder( new Deploy(player, context.target, context.armies));
-        cout << "Reinforcement";
+        order = new Deploy(player, context.target, context.armies);
+        out << "Reinforcement";
         break;
     case CardType::Blockade:
-		player->issueOrder(new Blockade(player, context.target));
-        cout << "Blockade";
+        order = new Blockade(player, context.target);
+        out << "Blockade";
         break;
     case CardType::Airlift:
-		player->issueOrder(new Airlift(player, context.source, context.target, context.armies));
-		cout << "Airlift";
+        order = new Airlift(player, context.source, context.target, context.armies);
+        out << "Airlift";
         break;
     case CardType::Diplomacy:
-		player->issueOrder(new Negotiate(player, context.targetPlayer));
-		cout << "Diplomacy";
+        order = new Negotiate(player, context.targetPlayer);
+        out << "Diplomacy";
         break;
-	default:
-		cout << "Unknown";
+    default:
+        out << "Unknown";
         break;
     }
 
-    cout << " Order and added it to " + player->getName() + "'s OrdersList.\n\n";
-
-    // Capture type before removing this from the hand
-    CardType currentType = this->getType();
-    hand->removeCard(this);
-    deck->addCard(make_unique<Card>(currentType));
+    out << " Order and added it to " + player->getName() + "'s OrdersList.\n\n";
+    return order;
 }
 
 ostream& operator<<(ostream& os, const Card& card) {
@@ -82,117 +95,182 @@ ostream& operator<<(ostream& os, const Card& card) {
 
 // ---------------------- Deck ----------------------------
 
-Deck::Deck() {
-    srand(static_cast<unsigned>(time(nullptr))); // Randomness for draw()
-}
+Deck::Deck() {} // playGame and the startup phase seed each game's deck
 
-Deck::Deck(const Deck& other) {
-    for (const auto& card : other.cards)
-        cards.push_back(make_unique<Card>(*card));
+Deck::Deck(const Deck& other) : total(other.total), gen(other.gen) {
+    copy(begin(other.counts), end(other.counts), begin(counts));
 }
 
 Deck& Deck::operator=(const Deck& other) {
     if (this != &other) {
-        cards.clear();
-        for (const auto& card : other.cards)
-            cards.push_back(make_unique<Card>(*card));
+        copy(begin(other.counts), end(other.counts), begin(counts));
+        total = other.total;
+        gen = other.gen;
     }
     return *this;
 }
 
 void Deck::addCard(unique_ptr<Card> card) {
-    cards.push_back(move(card));
+    if (card)
+        addCard(card->getType());
+}
+
+void Deck::addCard(CardType type, int count) {
+    counts[static_cast<int>(type)] += count;
+    total += count;
+}
+
+void Deck::takeAll(Deck& other) {
+    for (int t = 0; t < CardTypeCount; ++t) {
+        counts[t] += other.counts[t];
+        other.counts[t] = 0;
+    }
+    total += other.total;
+    other.total = 0;
 }
 
 unique_ptr<Card> Deck::draw() {
-    if (cards.empty()) return nullptr;
-    int i = rand() % static_cast<int>(cards.size());
-    auto selected = move(cards[i]);
-    cards.erase(cards.begin() + i);
-    return selected;
+    if (total == 0) return nullptr;
+    return make_unique<Card>(drawType());
+}
+
+CardType Deck::drawType() {
+    // Scale one 32-bit draw to [0, total) with a multiply and shift, then find the type whose cards cover it
+    uint32_t pick = static_cast<uint32_t>((static_cast<uint64_t>(gen()) * static_cast<uint64_t>(total)) >> 32);
+    int t = 0;
+    while (pick >= static_cast<uint32_t>(counts[t])) {
+        pick -= counts[t];
+        ++t;
+    }
+    --counts[t];
+    --total;
+    return static_cast<CardType>(t);
+}
+
+void Deck::seed(unsigned int seed) {
+    gen.seed(seed);
 }
 
 int Deck::size() const {
-    return static_cast<int>(cards.size());
+    return total;
+}
+
+int Deck::count(CardType type) const {
+    return counts[static_cast<int>(type)];
 }
 
 ostream& operator<<(ostream& os, const Deck& deck) {
     os << "Deck[" << deck.size() << "]: ";
-    for (const auto& card : deck.cards)
-        os << *card << " ";
+    for (int t = 0; t < CardTypeCount; ++t) {
+        Card card(static_cast<CardType>(t));
+        for (int i = 0; i < deck.counts[t]; ++i)
+            os << card << " ";
+    }
     return os;
 }
 
 bool Deck::isEmpty() const {
-    return cards.empty();
+    return total == 0;
 }
 
 // ---------------------- Hand ----------------------------
 
-Hand::Hand(const Hand& other) {
-    for (const auto& card : other.cards)
-        cards.push_back(make_unique<Card>(*card));
+Hand::Hand(const Hand& other) : viewStale(true) {
+    copy(begin(other.counts), end(other.counts), begin(counts));
 }
 
 Hand& Hand::operator=(const Hand& other) {
     if (this != &other) {
-        cards.clear();
-        for (const auto& card : other.cards)
-            cards.push_back(make_unique<Card>(*card));
+        copy(begin(other.counts), end(other.counts), begin(counts));
+        viewStale = true;
     }
     return *this;
 }
 
 void Hand::addCard(unique_ptr<Card> card) {
-    cards.push_back(move(card));
+    if (card)
+        addCard(card->getType());
+}
+
+void Hand::addCard(CardType type) {
+    ++counts[static_cast<int>(type)];
+    viewStale = true;
 }
 
 void Hand::removeCard(const Card* card) {
-    cards.erase(remove_if(cards.begin(), cards.end(),
-        [card](const unique_ptr<Card>& c) { return c.get() == card; }), cards.end());
+    // Dropping the card from the view keeps the rest of the view (and its pointers) in step with the counts
+    auto found = find_if(view.begin(), view.end(),
+        [card](const unique_ptr<Card>& c) { return c.get() == card; });
+    if (found == view.end())
+        return;
+    --counts[static_cast<int>(card->getType())];
+    view.erase(found);
+}
+
+bool Hand::removeCard(CardType type) {
+    int& n = counts[static_cast<int>(type)];
+    if (n == 0)
+        return false;
+    --n;
+    viewStale = true;
+    return true;
 }
 
 void Hand::playAll(Player* player, Deck* deck, const vector<CardPlayContext>& contexts) {
     vector<Card*> toPlay;
-    toPlay.reserve(cards.size());
-    for (const auto& c : cards)
+    for (const auto& c : getCards())
         toPlay.push_back(c.get());
 
     for (size_t i = 0; i < toPlay.size() && i < contexts.size(); ++i) {
-        cout << "[Hand] Playing card #" << i + 1 << ": " << toPlay[i]->getTypeAsString() << endl;
+        ConsoleLog::out() << "[Hand] Playing card #" << i + 1 << ": " << toPlay[i]->getTypeAsString() << endl;
         toPlay[i]->play(player, deck, this, contexts[i]);
     }
 }
 
-const vector<unique_ptr<Card>>& Hand::getCards() const {
-    return cards;
+int Hand::count(CardType type) const {
+    return counts[static_cast<int>(type)];
 }
 
-ostream& operator<<(ostream& os, const Hand& hand) {
-    os << "Hand[" << hand.cards.size() << "]: ";
-    for (const auto& card : hand.cards)
-        os << *card << " ";
-    return os;
+bool Hand::has(CardType type) const {
+    return counts[static_cast<int>(type)] > 0;
 }
 
-bool operator==(const Hand& playerOneHand, const Hand& playerTwoHand) {
-    const auto& cards1 = playerOneHand.getCards();
-    const auto& cards2 = playerTwoHand.getCards();
+int Hand::size() const {
+    int n = 0;
+    for (int c : counts)
+        n += c;
+    return n;
+}
 
-    if (cards1.size() != cards2.size())
-        return false;
+vector<CardType> Hand::getTypes() const {
+    vector<CardType> types;
+    types.reserve(size());
+    for (int t = 0; t < CardTypeCount; ++t)
+        types.insert(types.end(), counts[t], static_cast<CardType>(t));
+    return types;
+}
 
-    for (size_t i = 0; i < cards1.size(); ++i) {
-        if (cards1[i]->getType() != cards2[i]->getType())
-            return false;
+const vector<unique_ptr<Card>>& Hand::getCards() const {
+    if (viewStale) {
+        view.clear();
+        for (CardType type : getTypes())
+            view.push_back(make_unique<Card>(type));
+        viewStale = false;
     }
-
-    return true;
+    return view;
 }
 
-bool operator!=(const Hand& playerOneHand, const Hand& playerTwoHand) {
-    return !(playerOneHand == playerTwoHand);
+ostream& operator<<(ostream& os, const Hand& hand) {
+    os << "Hand[" << hand.size() << "]: ";
+    for (CardType type : hand.getTypes())
+        os << Card(type) << " ";
+    return os;
 }
 
+bool operator==(const Hand& playerOneHand, const Hand& playerTwoHand) {
+    return equal(begin(playerOneHand.counts), end(playerOneHand.counts), begin(playerTwoHand.counts));
+}
 
-
+bool operator!=(const Hand& playerOneHand, const Hand& playerTwoHand) {
+    return !(playerOneHand == playerTwoHand);
+}
\ No newline at end of file
@@ -4,6 +4,7 @@
 #include <iostream>
 #include <vector>
 #include <memory>
+#include <random>
 #include <string>
 
 using namespace std;
@@ -29,6 +30,8 @@ enum class CardType {
     Diplomacy       ///< Prevents mutual attacks between two players for the turn
 };
 
+const int CardTypeCount = 5; ///< Number of card types (decks and hands keep one count per type)
+
 /**
  * @class CardPlayContext
  * @brief Encapsulates contextual information used when a card is played.
@@ -68,6 +71,13 @@ public:
      */
     void play(Player* player, class Deck* deck, class Hand* hand, const CardPlayContext& context);
 
+    /**
+     * @brief Creates (and reports) the order this card generates, without touching any hand or deck.
+     *
+     * Used by play() and by turn plans, which return the card to the deck only once the plan is issued.
+     */
+    Order* createOrder(Player* player, const CardPlayContext& context) const;
+
     friend ostream& operator<<(ostream& os, const Card& card);  ///< Stream print of card
 private:
     Card() = delete;       ///< Disables default construction
@@ -79,52 +89,73 @@ private:
  * @brief Represents a draw pile of cards available in the game.
  *
  * Cards are drawn from the deck into a player's hand and returned
- * after they are played. Internally uses a vector of unique pointers.
+ * after they are played. Cards of a type are interchangeable, so the deck
+ * only keeps how many of each type it holds: a draw picks a type weighted
+ * by its count in O(1), using the deck's own generator (each game seeds its deck).
  */
 class Deck {
 public:
-    Deck();                                 ///< Constructs an empty deck
-    Deck(const Deck& other);                ///< Copy constructor (deep copies all cards)
-    Deck& operator=(const Deck& other);     ///< Assignment operator (deep copies)
+    Deck();                                 ///< Constructs an empty deck with a fixed default seed
+    Deck(const Deck& other);                ///< Copy constructor (copies the counts and the generator)
+    Deck& operator=(const Deck& other);     ///< Assignment operator
     ~Deck() = default;
 
-    void addCard(unique_ptr<Card> card);    ///< Adds a card back into the deck
-    unique_ptr<Card> draw();                ///< Draws a random card (removes from deck)
+    void addCard(unique_ptr<Card> card);    ///< Adds a card back into the deck (only its type is kept)
+    void addCard(CardType type, int count = 1); ///< Adds count cards of a type
+    void takeAll(Deck& other);              ///< Moves every card of other into this deck
+    unique_ptr<Card> draw();                ///< Draws a random card (removes from deck), nullptr when empty
+    CardType drawType();                    ///< Draws a random card by type; the deck must not be empty
+    void seed(unsigned int seed);           ///< Reseeds the generator draws use
     int size() const;                       ///< Returns the number of cards in the deck
+    int count(CardType type) const;         ///< Returns the number of cards of a type in the deck
 
 	// Checks if the deck is empty
 	bool isEmpty() const;
 
     friend ostream& operator<<(ostream& os, const Deck& deck);  ///< Stream print of deck
 private:
-    vector<unique_ptr<Card>> cards;         ///< Internal list of cards
+    int counts[CardTypeCount] = {};         ///< Cards of each type
+    int total = 0;                          ///< Sum of counts
+    mt19937 gen;                            ///< Per-deck generator used by draws
 };
 
 /**
  * @class Hand
  * @brief Represents a player's collection of cards.
  *
- * Cards are stored as unique pointers and can be added, removed,
- * or played. The hand supports comparison operators and printing.
+ * Cards can be added, removed, or played. The hand keeps one count per
+ * card type, so asking how many cards of a type it holds is O(1).
+ * getCards() is a view built from the counts (grouped by type) for code
+ * that plays cards one at a time: its pointers stay valid until getCards()
+ * is called again after the hand changed. The hand supports comparison
+ * operators and printing.
  */
 class Hand {
 public:
     Hand() = default;
-    Hand(const Hand& other);                      ///< Deep copy constructor
-    Hand& operator=(const Hand& other);           ///< Deep assignment operator
+    Hand(const Hand& other);                      ///< Copy constructor (copies the counts)
+    Hand& operator=(const Hand& other);           ///< Assignment operator
     ~Hand() = default;
 
-    void addCard(unique_ptr<Card> card);          ///< Adds a new card to the hand
-    void removeCard(const Card* card);            ///< Removes a specific card (by pointer)
+    void addCard(unique_ptr<Card> card);          ///< Adds a new card to the hand (only its type is kept)
+    void addCard(CardType type);                  ///< Adds a card of a type
+    void removeCard(const Card* card);            ///< Removes a card seen through getCards() (one of its type)
+    bool removeCard(CardType type);               ///< Removes a card of a type, false when the hand has none
     void playAll(Player* player, Deck* deck, const vector<CardPlayContext>& contexts); ///< Plays all cards with given contexts
 
+    int count(CardType type) const;               ///< Returns the number of cards of a type in the hand
+    bool has(CardType type) const;                ///< Returns whether the hand holds a card of a type
+    int size() const;                             ///< Returns the number of cards in the hand
+    vector<CardType> getTypes() const;            ///< Returns the type of every card, grouped by type
     const vector<unique_ptr<Card>>& getCards() const; ///< Returns read-only view of cards
 
     friend ostream& operator<<(ostream& os, const Hand& hand);                   ///< Stream print of hand
     friend bool operator==(const Hand& playerOneHand, const Hand& playerTwoHand);///< Equality comparison
     friend bool operator!=(const Hand& playerOneHand, const Hand& playerTwoHand);///< Inequality comparison
 private:
-    vector<unique_ptr<Card>> cards;        ///< Internal list of cards
+    int counts[CardTypeCount] = {};        ///< Cards of each type
+    mutable vector<unique_ptr<Card>> view; ///< Cards handed out by getCards()
+    mutable bool viewStale = false;        ///< Whether the counts changed since the view was built
 };
 
 /**
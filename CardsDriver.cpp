@@ -56,5 +56,40 @@ void testCards() {
     delete player;
     delete deck;
 
+    // Cards are kept as counts per type: draws are weighted by those counts and seeded per deck
+    cout << "\n--- Counted Deck and Hand ---\n";
+
+    Deck counted;
+    counted.addCard(CardType::Bomb, 600);
+    counted.addCard(CardType::Reinforcement, 300);
+    counted.addCard(CardType::Diplomacy, 100);
+    counted.seed(345);
+    Deck replay(counted);
+
+    Hand hand;
+    bool sameDraws = true;
+    for (int i = 0; i < 500; ++i) {
+        CardType type = counted.drawType();
+        sameDraws = sameDraws && replay.drawType() == type;
+        hand.addCard(type);
+    }
+
+    cout << "Drew 500 of 1000 cards (600 Bomb, 300 Reinforcement, 100 Diplomacy): "
+         << hand.count(CardType::Bomb) << " Bomb, " << hand.count(CardType::Reinforcement) << " Reinforcement, "
+         << hand.count(CardType::Diplomacy) << " Diplomacy, " << hand.count(CardType::Airlift) << " Airlift\n";
+    cout << "[Check] Deck and hand add up: " << (counted.size() + hand.size() == 1000 ? "yes" : "NO") << "\n";
+    cout << "[Check] Copy of the seeded deck drew the same cards: " << (sameDraws ? "yes" : "NO") << "\n";
+
+    // Cards played through the getCards() view leave the hand one at a time
+    int bombs = hand.count(CardType::Bomb);
+    const Card* first = hand.getCards().front().get();
+    hand.removeCard(first);
+    hand.removeCard(CardType::Bomb);
+    cout << "[Check] Bomb count after removing two: " << hand.count(CardType::Bomb)
+         << " (expected " << bombs - 2 << ")\n";
+
+    counted.takeAll(replay);
+    cout << "[Check] Deck after taking the copy's cards: " << counted.size() << " (expected 1000)\n";
+
     cout << "\n=== Cards Testing Complete ===\n\n";
 }
\ No newline at end of file
@@ -1,7 +1,18 @@
 #include "CommandProcessing.h"
 #include "GameEngine.h"
+#include "StrategyRegistry.h"
+#include "ConsoleLog.h"
 #include <sstream>
 #include <cstdlib>
+#include <cstring>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define COMMAND_SCRIPT_MMAP
+#endif
 
 // Command Class Implementation:
 
@@ -65,27 +76,141 @@
     }
 
 
+// CommandHistory Class Implementation:
+
+    // Default Constructor
+    CommandHistory::CommandHistory() : oldest(0), capacity(0), total(0), spill(nullptr) {}
+
+    // Copy Constructor
+    CommandHistory::CommandHistory(const CommandHistory& other)
+    : oldest(0), capacity(other.capacity), total(other.total), spill(nullptr) {
+        // deep copy, oldest first
+        for (size_t i = 0; i < other.size(); i++) {
+            ring.push_back(new Command(*other.at(i)));
+        }
+    }
+
+    // Assignment Operator
+    CommandHistory& CommandHistory::operator=(const CommandHistory& other) {
+        if (this == &other) return *this;
+
+        clear();
+        delete spill;
+        spill = nullptr;
+
+        for (size_t i = 0; i < other.size(); i++) {
+            ring.push_back(new Command(*other.at(i)));
+        }
+        capacity = other.capacity;
+        total = other.total;
+        return *this;
+    }
+
+    // Destructor
+    CommandHistory::~CommandHistory() {
+        clear();
+        delete spill;
+    }
+
+    void CommandHistory::release(Command* cmd) {
+        if (spill) {
+            *spill << *cmd << '\n';
+        }
+        delete cmd;
+    }
+
+    void CommandHistory::setCapacity(size_t newCapacity, const string& spillFile) {
+        if (spill) {
+            delete spill;
+            spill = nullptr;
+        }
+        if (!spillFile.empty()) {
+            spill = new ofstream(spillFile, ios::app);
+            if (!spill->is_open()) {
+                cerr << "Error opening spill file: " << spillFile << endl;
+                delete spill;
+                spill = nullptr;
+            }
+        }
+
+        // Lay the commands out oldest first again, dropping the ones the new capacity has no room for
+        vector<Command*> ordered;
+        ordered.reserve(ring.size());
+        for (size_t i = 0; i < ring.size(); i++) {
+            ordered.push_back(at(i));
+        }
+
+        size_t excess = (newCapacity != 0 && ordered.size() > newCapacity) ? ordered.size() - newCapacity : 0;
+        for (size_t i = 0; i < excess; i++) {
+            release(ordered[i]);
+        }
+
+        ring.assign(ordered.begin() + excess, ordered.end());
+        oldest = 0;
+        capacity = newCapacity;
+    }
+
+    void CommandHistory::add(Command* cmd) {
+        total++;
+        if (capacity == 0 || ring.size() < capacity) {
+            ring.push_back(cmd);
+            return;
+        }
+
+        // Full: the new command takes the oldest one's slot
+        release(ring[oldest]);
+        ring[oldest] = cmd;
+        oldest = (oldest + 1) % capacity;
+    }
+
+    Command* CommandHistory::back() const {
+        if (ring.empty()) return nullptr;
+        return at(ring.size() - 1);
+    }
+
+    Command* CommandHistory::at(size_t i) const {
+        return ring[(oldest + i) % ring.size()];
+    }
+
+    size_t CommandHistory::size() const {
+        return ring.size();
+    }
+
+    size_t CommandHistory::getTotal() const {
+        return total;
+    }
+
+    size_t CommandHistory::getCapacity() const {
+        return capacity;
+    }
+
+    void CommandHistory::clear() {
+        for (size_t i = 0; i < ring.size(); i++) {
+            release(at(i));
+        }
+        ring.clear();
+        oldest = 0;
+        if (spill) spill->flush();
+    }
+
+
 // CommandProcessor Class Implementation:
 
     // Default Constructor
     CommandProcessor::CommandProcessor() {
-        commands = new vector<Command*>();
+        commands = new CommandHistory();
         currentState = new GameState(Start);
     }
 
     // Parameterized Constructor
     CommandProcessor::CommandProcessor(GameState* state) {
-        commands = new vector<Command*>();
+        commands = new CommandHistory();
         currentState = new GameState(*(state));
     }
 
     // Copy Constructor
     CommandProcessor::CommandProcessor(const CommandProcessor& other) {
-        commands = new vector<Command*>();
-        // deep copy
-        for (auto cmd : *(other.commands)) {
-            commands->push_back(new Command(*cmd));
-        }
+        commands = new CommandHistory(*(other.commands)); // deep copy
         currentState = new GameState(*(other.currentState));
     }
 
@@ -93,33 +218,24 @@
     CommandProcessor& CommandProcessor::operator=(const CommandProcessor& other) {
         if (this == &other) return *this;
 
-        for (auto cmd : *(commands)) delete cmd;
-        delete commands;
-        delete currentState;
-
-        commands = new vector<Command*>();
-        for (auto cmd : *(other.commands)) {
-            commands->push_back(new Command(*cmd));
-        }
-
-        currentState = new GameState(*(other.currentState));
+        *commands = *(other.commands);
+        *currentState = *(other.currentState);
         return *this;
     }
 
     // Destructor
     CommandProcessor::~CommandProcessor() {
-        for (auto cmd : *(commands)) delete cmd;
         delete commands;
         delete currentState;
     }
 
     // Stream Insertion operator
     ostream& operator<<(ostream& os, const CommandProcessor& cp) {
-        os << "CommandProcessor [" << cp.commands->size()
+        os << "CommandProcessor [" << cp.commands->getTotal()
            << " commands], State: " << cp.getStateString();
-        // List all commands
-        for (auto cmd : *(cp.commands)) {
-            os << "\n - " << *cmd;
+        // List the commands still in memory
+        for (size_t i = 0; i < cp.commands->size(); i++) {
+            os << "\n - " << *(cp.commands->at(i));
         }
         return os;
     }
@@ -133,10 +249,14 @@
     }
 
     void CommandProcessor::saveCommand(Command* cmd) {
-        commands->push_back(cmd);
+        commands->add(cmd);
         Notify(this);
     }
 
+    void CommandProcessor::setHistoryLimit(size_t capacity, const string& spillFile) {
+        commands->setCapacity(capacity, spillFile);
+    }
+
     // set method
     void CommandProcessor::setCurrentState(GameState state) {
         *currentState = state;
@@ -144,19 +264,20 @@
 
     // get methods
     Command* CommandProcessor::getCommand() {
-        if (!commands->empty()) {
-            return commands->back(); // return the last command
-        }
-        return nullptr;
+        return commands->back(); // return the last command (nullptr when there is none)
     }
 
     GameState CommandProcessor::getCurrentState() const {
         return *currentState;
     }
 
+    const CommandHistory& CommandProcessor::getHistory() const {
+        return *commands;
+    }
+
     void CommandProcessor::printCommands() const {
-        for (auto cmd : *(commands)) {
-            cout << *cmd << endl;
+        for (size_t i = 0; i < commands->size(); i++) {
+            cout << *(commands->at(i)) << endl;
         }
     }
 
@@ -297,7 +418,7 @@
     }
 
     string CommandProcessor::stringToLog() const {
-        return "CommandProcessor [" + to_string(commands->size()) +
+        return "CommandProcessor [" + to_string(commands->getTotal()) +
                " commands], State: " + getStateString();
     }
 
@@ -376,11 +497,8 @@
         if (strategies.size() < 2 || strategies.size() > 4) return false;
 
         for (string s : strategies) {
-            if (s == "Human") return false; // Human forbidden in tournament
-            if (s != "Aggressive" &&
-                s != "Benevolent" &&
-                s != "Neutral" &&
-                s != "Cheater")
+            // Registered strategy spec that may play tournaments (Human is forbidden)
+            if (!StrategyRegistry::isValid(s, true))
                 return false;
         }
 
@@ -391,15 +509,95 @@
     }
 
 
+// CommandScript Class Implementation
+
+    // Parameterized Constructor
+    CommandScript::CommandScript(const string& fileName)
+    : data(nullptr), length(0), position(0), mapped(false), open(false) {
+#ifdef COMMAND_SCRIPT_MMAP
+        int fd = ::open(fileName.c_str(), O_RDONLY);
+        if (fd < 0) return;
+
+        struct stat info;
+        if (fstat(fd, &info) == 0) {
+            open = true;
+            length = static_cast<size_t>(info.st_size);
+            if (length > 0) {
+                void* mapping = mmap(nullptr, length, PROT_READ, MAP_PRIVATE, fd, 0);
+                if (mapping == MAP_FAILED) {
+                    open = false;
+                    length = 0;
+                }
+                else {
+                    madvise(mapping, length, MADV_SEQUENTIAL); // read once, front to back
+                    data = static_cast<const char*>(mapping);
+                    mapped = true;
+                }
+            }
+        }
+        ::close(fd); // the mapping stays valid
+#else
+        ifstream file(fileName, ios::binary | ios::ate);
+        if (!file.is_open()) return;
+
+        open = true;
+        length = static_cast<size_t>(file.tellg());
+        if (length > 0) {
+            char* buffer = new char[length];
+            file.seekg(0);
+            file.read(buffer, static_cast<streamsize>(length));
+            data = buffer;
+        }
+#endif
+    }
+
+    // Destructor
+    CommandScript::~CommandScript() {
+#ifdef COMMAND_SCRIPT_MMAP
+        if (mapped) munmap(const_cast<char*>(data), length);
+#endif
+        if (!mapped) delete[] data;
+    }
+
+    bool CommandScript::isOpen() const {
+        return open;
+    }
+
+    bool CommandScript::nextLine(string_view& line) {
+        if (position >= length) return false;
+
+        const char* start = data + position;
+        const char* newline = static_cast<const char*>(memchr(start, '\n', length - position));
+        size_t lineLength = newline ? static_cast<size_t>(newline - start) : length - position;
+        position += lineLength + (newline ? 1 : 0);
+
+        if (lineLength > 0 && start[lineLength - 1] == '\r') lineLength--; // Windows line breaks
+        line = string_view(start, lineLength);
+        return true;
+    }
+
+    void CommandScript::rewind() {
+        position = 0;
+    }
+
+    size_t CommandScript::getPosition() const {
+        return position;
+    }
+
+    size_t CommandScript::getLength() const {
+        return length;
+    }
+
+
 // FileCommandProcessorAdapter Class Implementation
 
     // Parameterized Constructor
     FileCommandProcessorAdapter::FileCommandProcessorAdapter(const string& fName)
     : CommandProcessor()  {
         fileName = new string(fName);
-        commandFile = new ifstream(fName);
+        commandFile = new CommandScript(fName);
 
-        if (!commandFile->is_open()) {
+        if (!commandFile->isOpen()) {
             cerr << "Error opening file: " << fName << endl;
         }
     }
@@ -408,7 +606,7 @@
     FileCommandProcessorAdapter::FileCommandProcessorAdapter(const FileCommandProcessorAdapter& other)
     : CommandProcessor(other) {
         fileName = new string(*(other.fileName));
-        commandFile = new ifstream(*fileName);
+        commandFile = new CommandScript(*fileName);
     }
 
     // Assignent Operator
@@ -418,14 +616,11 @@
 
         // Clean up existing resources
         delete fileName;
-        if (commandFile) {
-            commandFile->close();
-            delete commandFile;
-        }
+        delete commandFile;
 
         // Deep copy
         fileName = new std::string(*(other.fileName));
-        commandFile = new std::ifstream(*fileName);
+        commandFile = new CommandScript(*fileName);
 
         // Call base assignment
         CommandProcessor::operator=(other);
@@ -436,22 +631,22 @@
     // Destructor
     FileCommandProcessorAdapter::~FileCommandProcessorAdapter() {
         delete fileName;
-        if (commandFile) {
-            if (commandFile->is_open())
-                commandFile->close();
-            delete commandFile;
-        }
+        delete commandFile;
     }
 
     void FileCommandProcessorAdapter::readCommand() {
-        string fileCmd;
+        string_view fileCmd;
 
-        if (commandFile->is_open() && getline(*commandFile, fileCmd)) {
-            cout << "File command: " << fileCmd << endl;
-            Command* cmd = new Command(fileCmd, " Effect not yet executed.");
+        if (commandFile->isOpen() && commandFile->nextLine(fileCmd)) {
+            ConsoleLog::out() << "File command: " << fileCmd << "\n";
+            Command* cmd = new Command(string(fileCmd), " Effect not yet executed.");
             this->saveCommand(cmd);
         }
         else {
-            cout << "End of command file reached or file not open." << endl;
+            ConsoleLog::out() << "End of command file reached or file not open." << endl;
         }
     }
+
+    bool FileCommandProcessorAdapter::isOpen() const {
+        return commandFile->isOpen();
+    }
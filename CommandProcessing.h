@@ -2,8 +2,10 @@
 
 #include <iostream>
 #include <string>
+#include <string_view>
 #include <vector>
 #include <fstream>
+#include <cstddef>
 #include "LoggingObserver.h"
 using namespace std;
 
@@ -55,10 +57,48 @@ class Command : public Subject, public ILoggable {
 
 };
 
+// Commands a processor has saved, oldest first. Unbounded unless given a capacity: then only the newest
+// commands stay in memory, in a ring, and the oldest one is deleted whenever a new one comes in. With a spill
+// file, every command leaving memory (evicted, cleared or destroyed) is first appended to it, one per line.
+class CommandHistory {
+    private:
+        vector<Command*> ring;
+        size_t oldest;    // slot of the oldest command once the ring is full
+        size_t capacity;  // 0 when unbounded
+        size_t total;     // commands ever added, including the ones no longer in memory
+        ofstream* spill;  // nullptr unless spilling
+
+        void release(Command* cmd);
+
+    public:
+        // Default Constructor
+        CommandHistory();
+
+        // Copy Constructor (copies the commands in memory and the capacity, not the spill file)
+        CommandHistory(const CommandHistory& other);
+
+        // Assignment Operator
+        CommandHistory& operator=(const CommandHistory& other);
+
+        // Destructor
+        ~CommandHistory();
+
+        // Keeps at most capacity commands in memory (0 for no bound), spilling to spillFile unless it is empty
+        void setCapacity(size_t capacity, const string& spillFile = "");
+
+        void add(Command* cmd);        // takes ownership
+        Command* back() const;         // newest command, nullptr when there is none
+        Command* at(size_t i) const;   // i-th command in memory, oldest first
+        size_t size() const;           // commands in memory
+        size_t getTotal() const;
+        size_t getCapacity() const;
+        void clear();
+};
+
 // CommandProccesor Class Definition
 class CommandProcessor : public Subject, public ILoggable  {
     private:
-        vector<Command*>* commands;  // commands is a pointer to a vector object that holds pointers to Command objects
+        CommandHistory* commands;    // commands is a pointer to the history of saved commands
         GameState* currentState;     // currentState is a pointer to a GameState enum
 
     public:
@@ -89,8 +129,12 @@ class CommandProcessor : public Subject, public ILoggable  {
         // get methods
         Command* getCommand();
         GameState getCurrentState() const;
+        const CommandHistory& getHistory() const;
         void printCommands() const;
 
+        // Bounds the command history (see CommandHistory::setCapacity), for long scripted runs
+        void setHistoryLimit(size_t capacity, const string& spillFile = "");
+
         // save method
         void saveCommand(Command* cmd);
 
@@ -111,11 +155,40 @@ class CommandProcessor : public Subject, public ILoggable  {
 
 };
 
+// A command file mapped into memory (read into a buffer where mmap is not available) and split into lines only
+// as they are read. Lines are views into the file without their line break ("\n" or "\r\n"), so a command is
+// copied once, when it is saved, and scripts of any length are read without growing memory.
+class CommandScript {
+    private:
+        const char* data;
+        size_t length;
+        size_t position;  // start of the next line
+        bool mapped;      // data is a mapping to unmap, else a buffer to delete (or nullptr)
+        bool open;
+
+    public:
+        // Parameterized Constructor
+        explicit CommandScript(const string& fileName);
+
+        // A mapping has one owner
+        CommandScript(const CommandScript& other) = delete;
+        CommandScript& operator=(const CommandScript& other) = delete;
+
+        // Destructor
+        ~CommandScript();
+
+        bool isOpen() const;
+        bool nextLine(string_view& line); // false once every line was read
+        void rewind();
+        size_t getPosition() const;
+        size_t getLength() const;
+};
+
 // FileCommandProcessorAdapter Class Definition
 class FileCommandProcessorAdapter : public CommandProcessor {
     private:
         string* fileName;
-        ifstream* commandFile;
+        CommandScript* commandFile;
 
     public:
         // Parameterized Constructor
@@ -132,4 +205,7 @@ class FileCommandProcessorAdapter : public CommandProcessor {
 
 		// Overriden readCommand method
         void readCommand() override;
+
+        // Whether the command file could be opened
+        bool isOpen() const;
 };
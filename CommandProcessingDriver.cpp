@@ -1,5 +1,8 @@
 #include "CommandProcessing.h"
+#include "ConsoleLog.h"
 #include <string>
+#include <chrono>
+#include <cstdio>
 using namespace std;
 
 
@@ -43,4 +46,77 @@ void testCommandProcessor(int argc, char* argv[]) {
     delete processor;
     
     cout << "=== Command Processing Testing Complete ===\n\n";
+}
+
+void testCommandScript() {
+    cout << "=== Command Script Testing ===\n\n";
+
+    // A long script with Windows line breaks, replaying the same game setup over and over
+    const string scriptFile = "command_script_test.txt";
+    const string spillFile = "command_script_spill.txt";
+    const vector<string> cycle = { "loadmap England.map", "validatemap", "addplayer Alice", "addplayer Bob", "gamestart", "replay" };
+    const size_t cycles = 20000;
+    const size_t historyLimit = 64;
+    {
+        ofstream script(scriptFile, ios::binary);
+        for (size_t i = 0; i < cycles; i++) {
+            for (const string& line : cycle) {
+                script << line << "\r\n";
+            }
+        }
+    }
+    remove(spillFile.c_str());
+
+    size_t lines = cycles * cycle.size();
+    size_t valid = 0;
+    bool stripped = true;
+    auto start = chrono::steady_clock::now();
+
+    {
+        FileCommandProcessorAdapter processor(scriptFile);
+        processor.setHistoryLimit(historyLimit, spillFile);
+
+        ConsoleLog::setQuiet(true);
+        for (size_t i = 0; i < lines; i++) {
+            processor.readCommand();
+            Command* cmd = processor.getCommand();
+            stripped = stripped && cmd->getCommand().find('\r') == string::npos;
+            if (processor.validate(cmd)) valid++;
+
+            // No game is played in between, so the game end is reached right after gamestart
+            if (processor.getCurrentState() == AssignReinforcements) {
+                processor.setCurrentState(Win);
+            }
+        }
+        ConsoleLog::setQuiet(false);
+
+        const CommandHistory& history = processor.getHistory();
+        cout << "Read " << history.getTotal() << " commands, " << history.size() << " kept in memory\n";
+        cout << "[Check] Every command valid: " << (valid == lines ? "yes" : "NO") << "\n";
+        cout << "[Check] Line breaks stripped: " << (stripped ? "yes" : "NO") << "\n";
+        cout << "[Check] History bounded: " << (history.size() == historyLimit ? "yes" : "NO") << "\n";
+        cout << "[Check] Newest command in memory: " << history.back()->getCommand() << " (expected replay)\n";
+    }
+
+    double seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+
+    // The spill file holds every command once the processor is gone, in order
+    ifstream spilled(spillFile);
+    string entry;
+    size_t spilledCount = 0;
+    bool ordered = true;
+    while (getline(spilled, entry)) {
+        const string& expected = cycle[spilledCount % cycle.size()];
+        ordered = ordered && entry.compare(0, 9 + expected.size() + 1, "Command: " + expected + ",") == 0;
+        spilledCount++;
+    }
+    spilled.close();
+    cout << "[Check] Spill file holds " << spilledCount << " commands (expected " << lines << "), in order: "
+         << (ordered ? "yes" : "NO") << "\n";
+    cout << "Throughput: " << static_cast<long long>(lines / seconds) << " commands per second\n";
+
+    remove(scriptFile.c_str());
+    remove(spillFile.c_str());
+
+    cout << "\n=== Command Script Testing Complete ===\n\n";
 }
\ No newline at end of file
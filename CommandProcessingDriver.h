@@ -1,4 +1,5 @@
 #pragma once
 #include "CommandProcessing.h"
 
-void testCommandProcessor(int argc, char* argv[]);  // function to test CommandProcessor class
\ No newline at end of file
+void testCommandProcessor(int argc, char* argv[]);  // function to test CommandProcessor class
+void testCommandScript();  // function to test long scripts read through a memory-mapped file with a bounded history
\ No newline at end of file
@@ -0,0 +1,163 @@
+#include "CompactOrders.h"
+#include "Player.h"
+#include <algorithm>
+#include <stdexcept>
+
+OrderIndex::OrderIndex(const vector<Player*>& players, const vector<Territory*>& territories)
+    : players(players), territories(territories) {}
+
+Player* OrderIndex::getPlayer(int seat) const {
+    return seat >= 0 && seat < static_cast<int>(players.size()) ? players[seat] : nullptr;
+}
+
+Territory* OrderIndex::getTerritory(int id) const {
+    return id >= 0 && id < static_cast<int>(territories.size()) ? territories[id] : nullptr;
+}
+
+int OrderIndex::getSeat(const Player* player) const {
+    auto it = find(players.begin(), players.end(), player);
+    return it != players.end() ? static_cast<int>(it - players.begin()) : -1;
+}
+
+CompactOrder CompactOrder::deploy(int issuer, int target, int armies) {
+    return CompactOrder{ OrderType::Deploy, false, issuer, -1, target, armies };
+}
+
+CompactOrder CompactOrder::advance(int issuer, int source, int target, int armies) {
+    return CompactOrder{ OrderType::Advance, false, issuer, source, target, armies };
+}
+
+CompactOrder CompactOrder::bomb(int issuer, int target) {
+    return CompactOrder{ OrderType::Bomb, false, issuer, -1, target, 0 };
+}
+
+CompactOrder CompactOrder::blockade(int issuer, int target) {
+    return CompactOrder{ OrderType::Blockade, false, issuer, -1, target, 0 };
+}
+
+CompactOrder CompactOrder::airlift(int issuer, int source, int target, int armies) {
+    return CompactOrder{ OrderType::Airlift, false, issuer, source, target, armies };
+}
+
+CompactOrder CompactOrder::negotiate(int issuer, int targetPlayer) {
+    return CompactOrder{ OrderType::Negotiate, false, issuer, -1, targetPlayer, 0 };
+}
+
+bool CompactOrder::validate(const OrderIndex& index) const {
+    Player* player = index.getPlayer(issuer);
+
+    switch (type) {
+    case OrderType::Deploy:
+        return Deploy::check(player, index.getTerritory(target), armies) == OrderValidation::Valid;
+    case OrderType::Advance:
+        return Advance::check(player, index.getTerritory(source), index.getTerritory(target), armies) == OrderValidation::Valid;
+    case OrderType::Bomb:
+        return Bomb::check(player, index.getTerritory(target)) == OrderValidation::Valid;
+    case OrderType::Blockade:
+        return Blockade::check(player, index.getTerritory(target)) == OrderValidation::Valid;
+    case OrderType::Airlift:
+        return Airlift::check(player, index.getTerritory(source), index.getTerritory(target), armies) == OrderValidation::Valid;
+    case OrderType::Negotiate:
+        return Negotiate::check(player, index.getPlayer(target)) == OrderValidation::Valid;
+    }
+    return false;
+}
+
+bool CompactOrder::execute(const OrderIndex& index) {
+    executed = validate(index);
+    if (!executed) return false;
+
+    Player* player = index.getPlayer(issuer);
+
+    switch (type) {
+    case OrderType::Deploy:
+        Deploy::apply(index.getTerritory(target), armies);
+        break;
+    case OrderType::Advance:
+        Advance::apply(player, index.getTerritory(source), index.getTerritory(target), armies);
+        break;
+    case OrderType::Bomb:
+        Bomb::apply(index.getTerritory(target));
+        break;
+    case OrderType::Blockade:
+        Blockade::apply(player, index.getTerritory(target));
+        break;
+    case OrderType::Airlift:
+        Airlift::apply(index.getTerritory(source), index.getTerritory(target), armies);
+        break;
+    case OrderType::Negotiate:
+        Negotiate::apply(player, index.getPlayer(target));
+        break;
+    }
+    return true;
+}
+
+Order* CompactOrder::toOrder(const OrderIndex& index) const {
+    Player* player = index.getPlayer(issuer);
+
+    switch (type) {
+    case OrderType::Deploy:
+        return new Deploy(player, index.getTerritory(target), armies);
+    case OrderType::Advance:
+        return new Advance(player, index.getTerritory(source), index.getTerritory(target), armies);
+    case OrderType::Bomb:
+        return new Bomb(player, index.getTerritory(target));
+    case OrderType::Blockade:
+        return new Blockade(player, index.getTerritory(target));
+    case OrderType::Airlift:
+        return new Airlift(player, index.getTerritory(source), index.getTerritory(target), armies);
+    case OrderType::Negotiate:
+        return new Negotiate(player, index.getPlayer(target));
+    }
+    return nullptr;
+}
+
+void CompactOrdersList::add(const CompactOrder& order) {
+    orders.push_back(order);
+}
+
+void CompactOrdersList::add(vector<CompactOrder>&& batch) {
+    if (orders.empty()) {
+        orders.swap(batch); // takes the whole block
+    }
+    else {
+        orders.insert(orders.end(), batch.begin(), batch.end());
+    }
+    batch.clear();
+}
+
+void CompactOrdersList::remove(int index) {
+    if (index < 0 || index >= size()) throw out_of_range("Index out of range");
+    orders.erase(orders.begin() + index);
+}
+
+void CompactOrdersList::clear() {
+    orders.clear();
+}
+
+int CompactOrdersList::size() const {
+    return static_cast<int>(orders.size());
+}
+
+const CompactOrder& CompactOrdersList::at(int index) const {
+    if (index < 0 || index >= size()) throw out_of_range("Index out of range");
+    return orders[index];
+}
+
+CompactOrder& CompactOrdersList::at(int index) {
+    if (index < 0 || index >= size()) throw out_of_range("Index out of range");
+    return orders[index];
+}
+
+const vector<CompactOrder>& CompactOrdersList::getOrders() const {
+    return orders;
+}
+
+int CompactOrdersList::executeAll(const OrderIndex& index) {
+    int valid = 0;
+    for (CompactOrder& order : orders) {
+        if (order.execute(index)) valid++;
+    }
+    orders.clear();
+    return valid;
+}
@@ -0,0 +1,72 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "Orders.h"
+using namespace std;
+
+class Player;
+class Territory;
+
+// Turns the small ids of compact orders back into the game's players and territories. Players are
+// numbered by their seat in the list given here, territories by their id (their index in the map).
+class OrderIndex {
+    private:
+        vector<Player*> players;
+        vector<Territory*> territories;
+
+    public:
+        OrderIndex(const vector<Player*>& players, const vector<Territory*>& territories);
+
+        Player* getPlayer(int seat) const;         // nullptr for an id out of range
+        Territory* getTerritory(int id) const;     // nullptr for an id out of range
+        int getSeat(const Player* player) const;   // -1 for a player not in the index
+};
+
+// An order as a plain value: a type tag and four numbers, about a fifth of a polymorphic order and free
+// of heap allocations, so a list of them is one contiguous block that is moved rather than cloned.
+// Validation and execution dispatch on the tag and apply exactly the rules of the polymorphic orders
+// (Deploy::isValid/apply and friends); nothing is printed or logged.
+struct CompactOrder {
+    OrderType type;
+    bool executed;
+    int32_t issuer;   // seat of the issuing player
+    int32_t source;   // territory id, -1 when the order has no source
+    int32_t target;   // territory id, or the seat of the target player for Negotiate
+    int32_t armies;
+
+    static CompactOrder deploy(int issuer, int target, int armies);
+    static CompactOrder advance(int issuer, int source, int target, int armies);
+    static CompactOrder bomb(int issuer, int target);
+    static CompactOrder blockade(int issuer, int target);
+    static CompactOrder airlift(int issuer, int source, int target, int armies);
+    static CompactOrder negotiate(int issuer, int targetPlayer);
+
+    bool validate(const OrderIndex& index) const;
+    bool execute(const OrderIndex& index); // returns if the order was valid (and so carried out)
+
+    Order* toOrder(const OrderIndex& index) const; // the equivalent polymorphic order, e.g. to print it
+};
+
+static_assert(sizeof(CompactOrder) <= 24, "compact orders are meant to stay within 24 bytes");
+
+// Orders of one player, stored by value in issue order
+class CompactOrdersList {
+    private:
+        vector<CompactOrder> orders;
+
+    public:
+        void add(const CompactOrder& order);
+        void add(vector<CompactOrder>&& batch); // appends a whole turn at once, leaving batch empty
+        void remove(int index);
+        void clear();
+
+        int size() const;
+        const CompactOrder& at(int index) const;
+        CompactOrder& at(int index);
+        const vector<CompactOrder>& getOrders() const;
+
+        // Executes every order in list order and empties the list, returns how many were valid
+        int executeAll(const OrderIndex& index);
+};
@@ -0,0 +1,30 @@
+#include "ConsoleLog.h"
+
+namespace {
+    thread_local ostream* target = nullptr;
+    thread_local bool quiet = false;
+}
+
+ostream& ConsoleLog::out() {
+    if (quiet) {
+        static thread_local ostream discard(nullptr); // no buffer, every write is dropped
+        return discard;
+    }
+    return target ? *target : cout;
+}
+
+void ConsoleLog::redirect(ostream* stream) {
+    target = stream;
+}
+
+ostream* ConsoleLog::getRedirect() {
+    return target;
+}
+
+void ConsoleLog::setQuiet(bool enabled) {
+    quiet = enabled;
+}
+
+bool ConsoleLog::isQuiet() {
+    return quiet;
+}
@@ -0,0 +1,21 @@
+#pragma once
+
+#include <iostream>
+using namespace std;
+
+// Destination of the messages printed while a game is played (orders, cards, tournament progress).
+// Defaults to cout. Each thread can redirect or silence its own messages, so games and planners
+// running side by side neither interleave their output nor pay for a console nobody reads.
+class ConsoleLog {
+    public:
+        // Stream for the calling thread: the redirect target, a discarding stream when quiet, or cout
+        static ostream& out();
+
+        // Sends the calling thread's messages to a stream (nullptr goes back to cout)
+        static void redirect(ostream* stream);
+        static ostream* getRedirect(); // nullptr when the calling thread writes to cout
+
+        // Discards the calling thread's messages until turned off again
+        static void setQuiet(bool quiet);
+        static bool isQuiet();
+};
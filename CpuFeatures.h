@@ -0,0 +1,37 @@
+#pragma once
+
+// Instruction sets the vector kernels can use. A kernel is compiled for AVX2 with CPU_TARGET_AVX2 whatever
+// the build flags, so one binary carries it everywhere, and only called once cpuHasAvx2() says this machine
+// can run it.
+#if defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86)
+#define CPU_FEATURES_X86
+#include <immintrin.h>
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>
+#define CPU_TARGET_AVX2
+#else
+#define CPU_TARGET_AVX2 __attribute__((target("avx2")))
+#endif
+#endif
+
+// true when the processor (and the operating system, which has to save the wide registers) supports AVX2
+inline bool cpuHasAvx2() {
+#if !defined(CPU_FEATURES_X86)
+    return false;
+#elif defined(_MSC_VER) && !defined(__clang__)
+    static const bool supported = [] {
+        int info[4];
+        __cpuid(info, 1);
+        bool osSavesYmm = (info[2] & (1 << 27)) != 0 && (_xgetbv(0) & 0x6) == 0x6;
+        __cpuidex(info, 7, 0);
+        return osSavesYmm && (info[1] & (1 << 5)) != 0;
+    }();
+    return supported;
+#else
+    static const bool supported = [] {
+        __builtin_cpu_init();
+        return __builtin_cpu_supports("avx2") != 0;
+    }();
+    return supported;
+#endif
+}
@@ -3,6 +3,16 @@
 #include "Map.h"
 #include "Player.h"
 #include "PlayerStrategies.h"
+#include "StrategyRegistry.h"
+#include "BattleOdds.h"
+#include "Cards.h"
+#include "Orders.h"
+#include "TurnPlan.h"
+#include "OrderExecutor.h"
+#include "OrderCoalescer.h"
+#include "ThreadPool.h"
+#include "ConsoleLog.h"
+#include <sstream>
 #include <algorithm>
 #include <cstdlib>
 #include <ctime>
@@ -13,11 +23,35 @@
 // default constructor
 GameEngine::GameEngine() {
     currentState = new GameState(Start);
+    seed = static_cast<unsigned int>(time(NULL));
+    rng.seed(seed);
+    dealPolicy = DealPolicy::Random;
+    parallelPlanning = false;
+    parallelExecution = false;
+    orderCoalescing = false;
+    planningThreads = 0;
+    planningPool = nullptr;
+    turnBudgetMs = 0;
+    // build the battle odds tables before any strategy queries them
+    BattleOdds::initialize();
 }
 
 // copy constructor
 GameEngine::GameEngine(const GameEngine& other) {
     currentState = new GameState(*(other.currentState));
+    seed = other.seed;
+    rng = other.rng;
+    dealPolicy = other.dealPolicy;
+    dealWeights = other.dealWeights;
+    parallelPlanning = other.parallelPlanning;
+    parallelExecution = other.parallelExecution;
+    orderCoalescing = other.orderCoalescing;
+    planningThreads = other.planningThreads;
+    planningPool = nullptr; // each engine owns its workers
+    turnBudgetMs = other.turnBudgetMs;
+    budgetRecords = other.budgetRecords;
+    rejectionRecords = other.rejectionRecords;
+    coalescingRecords = other.coalescingRecords;
 }
 
 // assignment operator
@@ -25,12 +59,28 @@ GameEngine& GameEngine::operator=(const GameEngine& other) {
     if(this != &other) {
         delete currentState; // free existing resource
         currentState = new GameState(*(other.currentState)); // deep copy
+        seed = other.seed;
+        rng = other.rng;
+        dealPolicy = other.dealPolicy;
+        dealWeights = other.dealWeights;
+        parallelPlanning = other.parallelPlanning;
+        parallelExecution = other.parallelExecution;
+        orderCoalescing = other.orderCoalescing;
+        planningThreads = other.planningThreads;
+        delete planningPool;
+        planningPool = nullptr;
+        turnBudgetMs = other.turnBudgetMs;
+        budgetRecords = other.budgetRecords;
+        rejectionRecords = other.rejectionRecords;
+        coalescingRecords = other.coalescingRecords;
+        overrunDebt.clear();
     }
     return *this;
 }
 
 GameEngine::~GameEngine() {
     delete currentState; // free allocated memory
+    delete planningPool;
 }
 
 void GameEngine::transition(const string& command) {
@@ -126,11 +176,13 @@ void GameEngine::startupPhase(CommandProcessor*& commandProcessor, Map*& map, ve
             }
 
             if (cmdName == "loadmap") {
-                //Load map
+                //Load map (replacing the one loaded before, if any)
+                delete map;
                 map = MapLoader::loadMap(cmdArg);
 
                 //Check if map was successfully loaded
                 if (map == nullptr) {
+					commandProcessor->setCurrentState(Start); //Reset commandProcessor to Start state, no map is loaded
                     command->saveEffect("Could not open file " + cmdArg); //Update the command's effect
                 }
                 else {
@@ -169,7 +221,7 @@ void GameEngine::startupPhase(CommandProcessor*& commandProcessor, Map*& map, ve
                 else {
 					startupPhaseProcess(commandProcessor, map, players, deck); //Run the startup phase process
 
-                    cout << "\n" << command->getEffect() << "\n"; //Print the command's effect
+                    ConsoleLog::out() << "\n" << command->getEffect() << "\n"; //Print the command's effect
 
 					this->transition(cmdName); //Move to the AssignReinforcements state
 
@@ -178,62 +230,328 @@ void GameEngine::startupPhase(CommandProcessor*& commandProcessor, Map*& map, ve
             }
         }
 
-		cout << "\n" << command->getEffect() << "\n\n"; //Print the command's effect
+		ConsoleLog::out() << "\n" << command->getEffect() << "\n\n"; //Print the command's effect
 
+		size_t commandsRead = commandProcessor->getHistory().getTotal();
 		commandProcessor->readCommand(); //Read in the next command
-		command = commandProcessor->getCommand(); //Get the next command
+
+		//Get the next command (none once a command file has run out)
+		command = commandProcessor->getHistory().getTotal() > commandsRead ? commandProcessor->getCommand() : nullptr;
 	}
 }
 
 //Run the startup phase process (assign territories, determine order of play, etc.)
 void GameEngine::startupPhaseProcess(CommandProcessor*& commandProcessor, Map*& map, vector<Player*>*& players, Deck*& deck)
 {
-    srand(time(NULL)); //Seed randomizer
+    deck->seed(seed); //Seed the deck's draws
 
-    int territoriesPerPlayer;
+    dealTerritories(map, players); //Assign all territories to the players
 
-    territoriesPerPlayer = map->getTerritories().size() / players->size(); //Calculate territories per player
+    shuffle(players->begin(), players->end(), rng); //Randomize the order of play
 
-    //Iterate through all territories in the map
-    for (Territory* territory : map->getTerritories()) {
-        int randomIndex;
+    //Iterate through all players
+    for (int i = 0; i < players->size(); i++) {
+        players->at(i)->setArmies(50); //Assign 50 armies
+        players->at(i)->getHand()->addCard(deck->draw()); //Draw a card from the deck
+        players->at(i)->getHand()->addCard(deck->draw()); //Draw a card from the deck
+    }
+}
 
-        int totalTerritoriesAssigned = 0;
+//Deal every territory of the map to the players (shuffle once, then deal in a single pass)
+void GameEngine::dealTerritories(Map* map, vector<Player*>* players)
+{
+    if (map == nullptr || players == nullptr || players->empty()) {
+        return;
+    }
 
-        for (int i = 0; i < players->size(); i++) {
-            totalTerritoriesAssigned += players->at(i)->getTerritories().size();
+    size_t playerCount = players->size();
+
+    //Assign a territory to a player
+    auto assign = [](Player* player, Territory* territory) {
+        player->addTerritory(territory);
+        territory->setOwner(player);
+    };
+
+    //Shuffled copy of the players so that the players receiving leftover territories are random
+    vector<Player*> dealOrder(players->begin(), players->end());
+    shuffle(dealOrder.begin(), dealOrder.end(), rng);
+
+    if (dealPolicy == DealPolicy::BalancedByContinent) {
+        size_t next = 0;
+        vector<bool> dealt(map->getTerritories().size(), false);
+
+        //Deal each continent separately, continuing the rotation so overall counts stay even
+        for (Continent* continent : map->getContinents()) {
+            vector<Territory*> deal(continent->getTerritories().begin(), continent->getTerritories().end());
+            shuffle(deal.begin(), deal.end(), rng);
+
+            for (Territory* territory : deal) {
+                if (dealt[territory->getId()]) continue; //Listed under an earlier continent too
+                dealt[territory->getId()] = true;
+                assign(dealOrder[next], territory);
+                next = (next + 1) % playerCount;
+            }
+        }
+
+        //Territories of no continent (a map that does not validate) still get an owner, in the same rotation
+        vector<Territory*> leftovers;
+        for (Territory* territory : map->getTerritories()) {
+            if (!dealt[territory->getId()]) leftovers.push_back(territory);
+        }
+        shuffle(leftovers.begin(), leftovers.end(), rng);
+
+        for (Territory* territory : leftovers) {
+            assign(dealOrder[next], territory);
+            next = (next + 1) % playerCount;
         }
+        return;
+    }
+
+    vector<Territory*> deal(map->getTerritories().begin(), map->getTerritories().end());
+    shuffle(deal.begin(), deal.end(), rng);
 
-        //Check if each player has recieved the minimum number of territories per player
-        if (totalTerritoriesAssigned == territoriesPerPlayer * players->size()) {
-            territoriesPerPlayer++; //Increase territories per player to assign remaining territories
+    if (dealPolicy == DealPolicy::Weighted && dealWeights.size() == playerCount) {
+        double totalWeight = 0.0;
+        for (double weight : dealWeights) {
+            totalWeight += max(weight, 0.0);
         }
 
-        do {
-            randomIndex = rand() % players->size(); //Randomly pick a player
-        } while (players->at(randomIndex)->getTerritories().size() >= territoriesPerPlayer); //Check if the player has already recieved the maximum number of territories
+        if (totalWeight > 0.0) {
+            //Largest remainder method: every player gets the floor of their share, leftovers go to the largest fractions
+            vector<size_t> quotas(playerCount);
+            vector<pair<double, size_t>> remainders(playerCount);
+            size_t dealt = 0;
+
+            for (size_t i = 0; i < playerCount; i++) {
+                double share = deal.size() * max(dealWeights[i], 0.0) / totalWeight;
+                quotas[i] = static_cast<size_t>(share);
+                remainders[i] = { share - quotas[i], i };
+                dealt += quotas[i];
+            }
+
+            stable_sort(remainders.begin(), remainders.end(),
+                [](const pair<double, size_t>& a, const pair<double, size_t>& b) { return a.first > b.first; });
+
+            for (size_t i = 0; dealt < deal.size(); i = (i + 1) % playerCount) {
+                quotas[remainders[i].second]++;
+                dealt++;
+            }
 
-        players->at(randomIndex)->addTerritory(territory); //Assign the territory to the player
-        territory->setOwner(players->at(randomIndex)); //Assign the player as the owner of the territory
+            //Territories are already shuffled, so hand them out in consecutive blocks
+            size_t ti = 0;
+            for (size_t i = 0; i < playerCount; i++) {
+                for (size_t k = 0; k < quotas[i]; k++) {
+                    assign(players->at(i), deal[ti++]);
+                }
+            }
+            return;
+        }
     }
 
-    vector<Player*>* shuffledPlayers = new vector<Player*>(); //Declare a vector of players to randomize order of play
+    //Default rules: every player receives territories / players territories, leftovers go to random players
+    for (size_t ti = 0; ti < deal.size(); ti++) {
+        assign(dealOrder[ti % playerCount], deal[ti]);
+    }
+}
 
-    //While there are still players to be shuffled
-    while (players->size() > 0) {
-        int randomIndex = rand() % players->size(); //Randomly pick a player
-        shuffledPlayers->push_back(players->at(randomIndex)); //Add the player to the shuffled vector
-        players->erase(players->begin() + randomIndex); //Remove the player from the original vector
+void GameEngine::setSeed(unsigned int newSeed)
+{
+    seed = newSeed;
+    rng.seed(seed);
+    Advance::seedBattles(seed); // battles become reproducible too
+}
+
+unsigned int GameEngine::getSeed() const
+{
+    return seed;
+}
+
+void GameEngine::setParallelPlanning(bool enabled, size_t threads)
+{
+    parallelPlanning = enabled;
+    if (threads != planningThreads) {
+        delete planningPool; // recreated with the new size on next use
+        planningPool = nullptr;
     }
+    planningThreads = threads;
+}
 
-    players = shuffledPlayers; //Assign the original vector to the shuffled vector
+void GameEngine::setParallelExecution(bool enabled)
+{
+    parallelExecution = enabled;
+}
 
-    //Iterate through all players
-    for (int i = 0; i < players->size(); i++) {
-        players->at(i)->setArmies(50); //Assign 50 armies
-        players->at(i)->getHand()->addCard(deck->draw()); //Draw a card from the deck
-        players->at(i)->getHand()->addCard(deck->draw()); //Draw a card from the deck
+void GameEngine::setOrderCoalescing(bool enabled)
+{
+    orderCoalescing = enabled;
+}
+
+const map<string, CoalescingRecord>& GameEngine::getCoalescingRecords() const
+{
+    return coalescingRecords;
+}
+
+void GameEngine::printCoalescing(ostream& out) const
+{
+    if (coalescingRecords.empty()) {
+        return;
+    }
+
+    streamsize precision = out.precision();
+    out << left << setw(20) << "Strategy" << setw(10) << "Orders" << setw(10) << "Merged" << setw(10) << "Dropped" << "Reduction\n";
+    for (const auto& entry : coalescingRecords) {
+        const CoalescingRecord& record = entry.second;
+        int removed = record.merged + record.dropped;
+        out << left << setw(20) << entry.first << setw(10) << record.orders << setw(10) << record.merged << setw(10) << record.dropped
+            << fixed << setprecision(1) << (record.orders > 0 ? 100.0 * removed / record.orders : 0.0) << "%\n" << defaultfloat;
+    }
+    out.precision(precision);
+}
+
+ThreadPool* GameEngine::workerPool()
+{
+    if (planningPool == nullptr) {
+        planningPool = new ThreadPool(planningThreads);
+    }
+    return planningPool;
+}
+
+void GameEngine::setTurnBudget(int milliseconds)
+{
+    turnBudgetMs = max(0, milliseconds);
+    overrunDebt.clear();
+}
+
+int GameEngine::getTurnBudget() const
+{
+    return turnBudgetMs;
+}
+
+const map<string, BudgetRecord>& GameEngine::getBudgetRecords() const
+{
+    return budgetRecords;
+}
+
+int RejectionRecord::rejected() const
+{
+    int total = 0;
+    for (int reason = 1; reason < OrderValidationCount; reason++) {
+        total += byReason[reason];
+    }
+    return total;
+}
+
+const map<string, RejectionRecord>& GameEngine::getRejectionRecords() const
+{
+    return rejectionRecords;
+}
+
+void GameEngine::printRejections(ostream& out) const
+{
+    bool anyRejected = false;
+    for (const auto& entry : rejectionRecords) {
+        anyRejected = anyRejected || entry.second.rejected() > 0;
+    }
+    if (!anyRejected) {
+        return;
+    }
+
+    out << left << setw(20) << "Strategy" << setw(10) << "Orders" << setw(12) << "Rejected" << "Reasons\n";
+    for (const auto& entry : rejectionRecords) {
+        const RejectionRecord& record = entry.second;
+        out << left << setw(20) << entry.first << setw(10) << record.orders << setw(12) << record.rejected();
+
+        const char* separator = "";
+        for (int reason = 1; reason < OrderValidationCount; reason++) {
+            if (record.byReason[reason] > 0) {
+                out << separator << Order::getValidationText(static_cast<OrderValidation>(reason)) << " x" << record.byReason[reason];
+                separator = ", ";
+            }
+        }
+        out << "\n";
+    }
+}
+
+void GameEngine::cancelTurn()
+{
+    turnCancellation.cancel();
+}
+
+TurnBudget GameEngine::startTurnBudget(Player* player) const
+{
+    // Humans answer prompts and are never timed, but cancelTurn still reaches every AI player
+    if (player->getPlayerStrategy()->getKind() == StrategyKind::Human) {
+        return TurnBudget();
+    }
+    if (turnBudgetMs <= 0) {
+        return TurnBudget(chrono::milliseconds(0), &turnCancellation);
+    }
+
+    // A player that went over last turn gets that much less this turn (but always at least a millisecond)
+    chrono::milliseconds limit(turnBudgetMs);
+    auto debt = overrunDebt.find(player);
+    if (debt != overrunDebt.end()) {
+        limit = max(chrono::milliseconds(1), limit - chrono::duration_cast<chrono::milliseconds>(debt->second));
+    }
+    return TurnBudget(limit, &turnCancellation);
+}
+
+void GameEngine::recordTurnBudget(Player* player, const TurnBudget& budget, chrono::steady_clock::duration lateness)
+{
+    if (!budget.isLimited()) {
+        return;
+    }
+
+    BudgetRecord& record = budgetRecords[player->getPlayerStrategy()->getStrategyString()];
+    record.turns++;
+
+    if (lateness > chrono::steady_clock::duration::zero()) {
+        record.overruns++;
+        record.worstOverrunMs = max(record.worstOverrunMs, chrono::duration<double, milli>(lateness).count());
+        overrunDebt[player] = lateness;
+    }
+    else {
+        overrunDebt.erase(player);
+    }
+}
+
+void GameEngine::recordCoalescing(Order* order, OrderValidation validation)
+{
+    Player* issuer = order->getOperands().issuer;
+    CoalescingRecord& record = coalescingRecords[issuer ? issuer->getPlayerStrategy()->getStrategyString() : "None"];
+
+    if (validation == OrderValidation::Valid) {
+        record.merged++;
+    }
+    else {
+        record.dropped++;
     }
+    recordValidation(order, validation); // still counted as a valid or rejected order of its strategy
+}
+
+void GameEngine::recordValidation(Order* order, OrderValidation validation)
+{
+    Player* issuer = order->getOperands().issuer;
+    RejectionRecord& record = rejectionRecords[issuer ? issuer->getPlayerStrategy()->getStrategyString() : "None"];
+    record.orders++;
+
+    if (validation != OrderValidation::Valid) {
+        record.byReason[static_cast<int>(validation)]++;
+    }
+}
+
+bool GameEngine::issueOrderWithinBudget(Player* player, Deck* deck)
+{
+    TurnBudget budget = startTurnBudget(player);
+    bool issued = player->issueOrder(deck, budget);
+    recordTurnBudget(player, budget, budget.isLimited() ? chrono::steady_clock::now() - budget.getDeadline() : chrono::steady_clock::duration::zero());
+    return issued;
+}
+
+void GameEngine::setDealPolicy(DealPolicy policy, const vector<double>& weights)
+{
+    dealPolicy = policy;
+    dealWeights = weights;
 }
 
 //Run the main game loop
@@ -303,15 +621,42 @@ void GameEngine::reinforcementPhase(Map*& map, vector<Player*>*& players) {
 void GameEngine::issueOrdersPhase(vector<Player*>*& players, Deck*& deck) {
     bool firstTurn = true;
     bool ordersIssued = true;
+    turnCancellation.reset();
     while (ordersIssued) {   // Continue until no orders are issued in a full pass
         ordersIssued = false;
+
+        // First pass in parallel mode: runs of snapshot-safe players plan together,
+        // anyone else (humans, board-changing strategies) plans alone in between
+        if (firstTurn && parallelPlanning) {
+            vector<Player*> segment;
+            for (Player* player : *players) {
+                if (player->getTerritories().empty()) {
+                    continue;
+                }
+                if (player->getPlayerStrategy()->plansOnSnapshot()) {
+                    segment.push_back(player);
+                    continue;
+                }
+                if (issueOrdersConcurrently(segment, deck))
+                    ordersIssued = true;
+                segment.clear();
+                if (issueOrderWithinBudget(player, deck))
+                    ordersIssued = true;
+            }
+            if (issueOrdersConcurrently(segment, deck))
+                ordersIssued = true;
+
+            firstTurn = false;
+            continue;
+        }
+
         for (Player* player : *players) {
 			if (player->getTerritories().empty()) { // Skip eliminated players
                 continue;
             }
-            if(!firstTurn && player->getPlayerStrategy()->getStrategyString() != "Human")
+            if(!firstTurn && player->getPlayerStrategy()->getKind() != StrategyKind::Human)
                 continue;
-            if (player->issueOrder(deck)) // Issues one order this pass
+            if (issueOrderWithinBudget(player, deck)) // Issues one order this pass
                 ordersIssued = true;  // At least one order was issued this pass
         }
 
@@ -321,7 +666,58 @@ void GameEngine::issueOrdersPhase(vector<Player*>*& players, Deck*& deck) {
     }
 }
 
+bool GameEngine::issueOrdersConcurrently(const vector<Player*>& segment, Deck* deck) {
+    if (segment.empty()) {
+        return false;
+    }
+
+    ThreadPool* pool = workerPool();
+
+    // Each player plans into its own turn plan, output buffer and notification buffer so nothing shared is
+    // written (observers such as the game log are updated at the merge below, never from a worker)
+    size_t count = segment.size();
+    vector<TurnPlan> plans(count);
+    vector<ostringstream> output(count);
+    vector<DeferredNotifications> notifications(count);
+    vector<TurnBudget> budgets(count);
+    vector<chrono::steady_clock::duration> lateness(count);
+
+    // Every budget starts when its player actually starts planning, not when the run was queued
+    pool->parallelFor(count, [&](size_t i) {
+        ConsoleLog::redirect(&output[i]);
+        Subject::deferTo(&notifications[i]);
+        budgets[i] = startTurnBudget(segment[i]);
+        plans[i] = segment[i]->planTurn(budgets[i]);
+        lateness[i] = budgets[i].isLimited() ? chrono::steady_clock::now() - budgets[i].getDeadline() : chrono::steady_clock::duration::zero();
+        Subject::deferTo(nullptr);
+        ConsoleLog::redirect(nullptr);
+    });
+
+    // Issue in player order, which is exactly what the sequential pass would have produced
+    bool ordersIssued = false;
+    for (size_t i = 0; i < count; i++) {
+        ConsoleLog::out() << output[i].str();
+        notifications[i].replay();
+        if (!plans[i].empty()) {
+            ordersIssued = true;
+        }
+        segment[i]->issueOrders(plans[i], deck);
+        recordTurnBudget(segment[i], budgets[i], lateness[i]);
+    }
+
+    return ordersIssued;
+}
+
 void GameEngine::executeOrdersPhase(vector<Player*>*& players) {
+    // Optional: merge deploys to the same territory and drop deploys that cannot be valid
+    OrderCoalescer coalescer([this](Order* order, OrderValidation validation) { recordCoalescing(order, validation); });
+    if (orderCoalescing) {
+        for (Player* player : *players) {
+            coalescingRecords[player->getPlayerStrategy()->getStrategyString()].orders += player->getOrdersList()->size();
+            coalescer.coalesceDeploys(player);
+        }
+    }
+
     bool ordersRemaining = true;
     // Step 1: Execute all deploy orders for all players
     while (ordersRemaining) {
@@ -331,9 +727,8 @@ void GameEngine::executeOrdersPhase(vector<Player*>*& players) {
             for (int i = 0; i < ordersList->size(); i++) {
                 Order* order = ordersList->getOrders() [i];  // Get the order at index i
                 // Check if it's a deploy order, execute and remove it
-                if (order->getName() == "Deploy") {
-                    if (order->validate()) order->execute();  // Execute the order if valid
-                    else order->setExecuted(false);     // Mark as not executed if invalid
+                if (order->getType() == OrderType::Deploy) {
+                    recordValidation(order, OrderExecutor::run(order));  // Validated once, executed if valid
                     ordersList->remove(i);      // Remove the order from the list
                     ordersRemaining = true;
                     --i;          // Compensate for remove
@@ -342,25 +737,40 @@ void GameEngine::executeOrdersPhase(vector<Player*>*& players) {
         }
     }
 
-    // Step 2: Execute all remaining orders in round-robin fashion
+    // Step 2: Execute all remaining orders in round-robin fashion: every player's first order, then every second order, ...
+    vector<Order*> sequence;
     ordersRemaining = true;
-    while (ordersRemaining) {    /// Continue until no orders remain
+    for (size_t round = 0; ordersRemaining; round++) {
         ordersRemaining = false;
-        for (auto player : *players) {   // Iterate through each player
+        for (Player* player : *players) {
+            const vector<Order*>& orders = player->getOrdersList()->getOrders();
+            if (round < orders.size()) {
+                sequence.push_back(orders[round]);
+                ordersRemaining = true;
+            }
+        }
+    }
+
+    // Optional: merge friendly moves along the same border and drop orders that cannot be valid (they leave nullptr behind)
+    if (orderCoalescing) {
+        coalescer.coalesceSequence(sequence);
+    }
+
+    OrderExecutor executor(parallelExecution ? workerPool() : nullptr);
+    executor.execute(sequence);
+    for (size_t i = 0; i < sequence.size(); i++) {
+        if (sequence[i] != nullptr) recordValidation(sequence[i], executor.getValidations()[i]);
+    }
+
+    // Step 3: Remove the executed orders, in the order they were executed
+    ordersRemaining = true;
+    while (ordersRemaining) {
+        ordersRemaining = false;
+        for (Player* player : *players) {
             OrdersList* ordersList = player->getOrdersList();
             if (ordersList->size() > 0) {
-                Order* order = ordersList->getOrders()[0];  // Get the first order
-                if (order->getName() != "Deploy") {
-                    if (order->validate()) {
-                        order->execute();
-                    }
-                    else {
-                        order->setExecuted(false);
-                        cout << *order << "\n";
-                    }
-                    ordersList->remove(0);
-                    ordersRemaining = true;
-                }
+                ordersList->remove(0);
+                ordersRemaining = true;
             }
         }
     }
@@ -390,25 +800,20 @@ ostream& operator << (ostream& os, const GameEngine& gEngine) {
 string GameEngine::stringToLog() const {
     return "GameEngine transitioned to state: " + getStateString();
 }
-void GameEngine::runTournament(const vector<string>& maps,
-                               const vector<string>& strategies,
-                               int gamesPerMap,
-                               int maxTurns)
+GameResult GameEngine::playGame(const string& mapFile, const vector<string>& strategies, int maxTurns)
 {
-    if (maps.empty() || strategies.size() < 2 || gamesPerMap <= 0 || maxTurns <= 0) {
-        cout << "[Tournament] Invalid parameters.\n";
-        return;
+    GameResult result;
+    result.played = false;
+    result.winner = -1;
+    result.turns = 0;
+
+    // ----- Load and validate map -----
+    Map* map = MapLoader::loadMap(mapFile);
+    if (!map || !map->validate()) {
+        if (map) delete map;
+        return result;
     }
-
-    // results[mapIndex][gameIndex] = winning strategy or "Draw"
-    vector<vector<string>> results(
-        maps.size(),
-        vector<string>(gamesPerMap, "Draw")
-    );
-
-    cout << "=============================================\n";
-    cout << "            TOURNAMENT MODE START            \n";
-    cout << "=============================================\n\n";
+    result.played = true;
 
     // Helper: winner is player who owns all map territories, or nullptr
     auto getWinner = [](Map* map) -> Player* {
@@ -425,139 +830,180 @@ void GameEngine::runTournament(const vector<string>& maps,
         return owner;
     };
 
-    random_device rd;
-    mt19937 rng(rd());
+    // ----- Create deck -----
+    Deck* deck = new Deck();
+    for (int k = 0; k < 4; ++k) {
+        deck->addCard(unique_ptr<Card>(new Card(CardType::Reinforcement)));
+        deck->addCard(unique_ptr<Card>(new Card(CardType::Bomb)));
+        deck->addCard(unique_ptr<Card>(new Card(CardType::Blockade)));
+        deck->addCard(unique_ptr<Card>(new Card(CardType::Airlift)));
+        deck->addCard(unique_ptr<Card>(new Card(CardType::Diplomacy)));
+    }
+    deck->seed(static_cast<unsigned int>(rng())); // each game of a seeded tournament draws its own cards
 
-    for (size_t mi = 0; mi < maps.size(); ++mi) {
-        const string& mapFile = maps[mi];
-        cout << "[Tournament] Map: " << mapFile << "\n";
+    // ----- Create players with strategies -----
+    vector<Player*>* players = new vector<Player*>();
+    players->reserve(strategies.size());
 
-        for (int gi = 0; gi < gamesPerMap; ++gi) {
-            cout << "  > Game " << (gi + 1) << " on " << mapFile << "\n";
+    for (size_t si = 0; si < strategies.size(); ++si) {
+        const string& sName = strategies[si];
 
-            // ----- Load and validate map -----
-            Map* map = MapLoader::loadMap(mapFile);
-            if (!map || !map->validate()) {
-                cout << "    ! Failed to load/validate map " << mapFile << ". Marking game as Draw.\n";
-                results[mi][gi] = "Draw";
-                if (map) delete map;
-                continue;
-            }
+        // Human is NOT allowed in tournament (CommandProcessor will enforce that)
+        PlayerStrategy* strat = StrategyRegistry::create(sName);
+        if (strat == nullptr) strat = new AggressivePlayerStrategy(nullptr); // fallback
 
-            // ----- Create deck -----
-            Deck* deck = new Deck();
-            for (int k = 0; k < 4; ++k) {
-                deck->addCard(unique_ptr<Card>(new Card(CardType::Reinforcement)));
-                deck->addCard(unique_ptr<Card>(new Card(CardType::Bomb)));
-                deck->addCard(unique_ptr<Card>(new Card(CardType::Blockade)));
-                deck->addCard(unique_ptr<Card>(new Card(CardType::Airlift)));
-                deck->addCard(unique_ptr<Card>(new Card(CardType::Diplomacy)));
-            }
+        string playerName = "P" + to_string(si + 1) + "-" + sName;
+        Player* p = new Player(playerName, strat);
+        players->push_back(p);
+    }
 
-            // ----- Create players with strategies -----
-            vector<Player*>* players = new vector<Player*>();
-            players->reserve(strategies.size());
+    // Seats keep their spec order even if players are reordered later
+    vector<Player*> seats = *players;
 
-            for (size_t si = 0; si < strategies.size(); ++si) {
-                const string& sName = strategies[si];
+    // ----- Randomly assign territories to players -----
+    dealTerritories(map, players);
 
-                PlayerStrategy* strat = nullptr;
-                // Human is NOT allowed in tournament (CommandProcessor will enforce that)
-                if (sName == "Aggressive")      strat = new AggressivePlayerStrategy(nullptr);
-                else if (sName == "Benevolent") strat = new BenevolentPlayerStrategy(nullptr);
-                else if (sName == "Neutral")    strat = new NeutralPlayerStrategy(nullptr);
-                else if (sName == "Cheater")    strat = new CheaterPlayerStrategy(nullptr);
-                else                            strat = new AggressivePlayerStrategy(nullptr); // fallback
+    // Strategies that plan with the whole map (e.g. search bots using continent bonuses)
+    for (Player* p : *players) {
+        p->getPlayerStrategy()->setMap(map);
+    }
 
-                string playerName = "P" + to_string(si + 1) + "-" + sName;
-                Player* p = new Player(playerName, strat);
-                players->push_back(p);
-            }
+    // ----- Initial armies + 2 cards each -----
+    for (Player* p : *players) {
+        p->setArmies(50);
+        if (!deck->isEmpty()) p->getHand()->addCard(deck->draw());
+        if (!deck->isEmpty()) p->getHand()->addCard(deck->draw());
+    }
 
-            // ----- Randomly assign territories to players -----
-            vector<Territory*> terrVec = map->getTerritories();
-            shuffle(terrVec.begin(), terrVec.end(), rng);
+    while (result.turns < maxTurns) {
+        // Clear negotiations each turn
+        for (Player* p : *players) {
+            p->clearNegotiatedPlayers();
+        }
 
-            for (size_t ti = 0; ti < terrVec.size(); ++ti) {
-                Player* owner = players->at(ti % players->size());
-                Territory* t = terrVec[ti];
-                owner->addTerritory(t);
-                t->setOwner(owner);
-            }
+        reinforcementPhase(map, players);
+        issueOrdersPhase(players, deck);
+        executeOrdersPhase(players);
 
-            // ----- Initial armies + 2 cards each -----
-            for (Player* p : *players) {
-                p->setArmies(50);
-                if (!deck->isEmpty()) p->getHand()->addCard(deck->draw());
-                if (!deck->isEmpty()) p->getHand()->addCard(deck->draw());
-            }
+        Player* winner = getWinner(map);
+        if (winner != nullptr) {
+            result.winner = static_cast<int>(find(seats.begin(), seats.end(), winner) - seats.begin());
+            break;
+        }
 
-            // ----- Fresh engine for this game -----
-            GameEngine engine;
+        ++result.turns;
+    }
 
-            int turn = 0;
-            string winnerStr = "Draw";
+    for (Player* p : seats) {
+        result.territoryCounts.push_back(static_cast<int>(p->getTerritories().size()));
+    }
 
-            while (turn < maxTurns) {
-                // Clear negotiations each turn
-                for (Player* p : *players) {
-                    p->clearNegotiatedPlayers();
-                }
+    // ----- Cleanup for this game -----
+    for (Player* p : *players) {
+        overrunDebt.erase(p);
+        delete p;
+    }
+    delete players;
+    delete deck;
+    delete map;
 
-                engine.reinforcementPhase(map, players);
-                engine.issueOrdersPhase(players, deck);
-                engine.executeOrdersPhase(players);
+    return result;
+}
 
-                Player* winner = getWinner(map);
-                if (winner != nullptr) {
-                    PlayerStrategy* ps = winner->getPlayerStrategy();
-                    winnerStr = ps ? ps->getStrategyString() : winner->getName();
-                    cout << "    -> Winner: " << winnerStr
-                         << " (" << winner->getName() << ")\n";
-                    break;
-                }
+vector<vector<string>> GameEngine::runTournament(const vector<string>& maps,
+                               const vector<string>& strategies,
+                               int gamesPerMap,
+                               int maxTurns)
+{
+    ostream& out = ConsoleLog::out();
 
-                ++turn;
-            }
+    if (maps.empty() || strategies.size() < 2 || gamesPerMap <= 0 || maxTurns <= 0) {
+        out << "[Tournament] Invalid parameters.\n";
+        return {};
+    }
 
-            if (winnerStr == "Draw") {
-                cout << "    -> Game reached max turns (" << maxTurns << "). Result: Draw.\n";
-            }
+    // results[mapIndex][gameIndex] = winning strategy or "Draw"
+    vector<vector<string>> results(
+        maps.size(),
+        vector<string>(gamesPerMap, "Draw")
+    );
+
+    out << "=============================================\n";
+    out << "            TOURNAMENT MODE START            \n";
+    out << "=============================================\n\n";
+
+    for (size_t mi = 0; mi < maps.size(); ++mi) {
+        const string& mapFile = maps[mi];
+        out << "[Tournament] Map: " << mapFile << "\n";
+
+        for (int gi = 0; gi < gamesPerMap; ++gi) {
+            out << "  > Game " << (gi + 1) << " on " << mapFile << "\n";
 
-            results[mi][gi] = winnerStr;
+            GameResult game = playGame(mapFile, strategies, maxTurns);
 
-            // ----- Cleanup for this game -----
-            for (Player* p : *players) {
-                delete p;
+            if (!game.played) {
+                out << "    ! Failed to load/validate map " << mapFile << ". Marking game as Draw.\n";
+                results[mi][gi] = "Draw";
+                continue;
+            }
+
+            if (game.winner >= 0) {
+                // Report the seat's spec so differently tuned copies of a strategy stay apart
+                results[mi][gi] = strategies[game.winner];
+                out << "    -> Winner: " << strategies[game.winner]
+                    << " (P" << (game.winner + 1) << "-" << strategies[game.winner] << ")\n";
+            }
+            else {
+                out << "    -> Game reached max turns (" << maxTurns << "). Result: Draw.\n";
             }
-            delete players;
-            delete deck;
-            delete map;
         }
     }
 
     // ----- Print final tournament results table -----
-    cout << "\n=============================================\n";
-    cout << "            TOURNAMENT RESULTS               \n";
-    cout << "=============================================\n";
+    out << "\n=============================================\n";
+    out << "            TOURNAMENT RESULTS               \n";
+    out << "=============================================\n";
 
-    cout << left << setw(20) << "Map";
+    out << left << setw(20) << "Map";
     for (int gi = 0; gi < gamesPerMap; ++gi) {
-        cout << setw(15) << ("Game " + to_string(gi + 1));
+        out << setw(15) << ("Game " + to_string(gi + 1));
     }
-    cout << "\n";
+    out << "\n";
 
     for (size_t mi = 0; mi < maps.size(); ++mi) {
-        cout << left << setw(20) << maps[mi];
+        out << left << setw(20) << maps[mi];
         for (int gi = 0; gi < gamesPerMap; ++gi) {
-            cout << setw(15) << results[mi][gi];
+            out << setw(15) << results[mi][gi];
+        }
+        out << "\n";
+    }
+
+    out << "=============================================\n\n";
+
+    if (turnBudgetMs > 0) {
+        out << "Turn budget: " << turnBudgetMs << " ms\n";
+        out << left << setw(20) << "Strategy" << setw(10) << "Turns" << setw(12) << "Overruns" << "Worst overrun (ms)\n";
+        for (const auto& entry : budgetRecords) {
+            out << left << setw(20) << entry.first << setw(10) << entry.second.turns << setw(12) << entry.second.overruns
+                << entry.second.worstOverrunMs << "\n";
         }
-        cout << "\n";
+        out << "\n";
     }
 
-    cout << "=============================================\n\n";
+    printCoalescing(out);
+    if (!coalescingRecords.empty()) {
+        out << "\n";
+    }
+
+    ostringstream rejections;
+    printRejections(rejections);
+    if (!rejections.str().empty()) {
+        out << rejections.str() << "\n";
+    }
 
     // Log end of tournament if you have a LoggingObserver attached
     Notify(this);
+
+    return results;
 }
 
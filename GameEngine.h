@@ -5,8 +5,13 @@
 #include <cstdlib>
 #include <cmath>
 #include <vector>
+#include <random>
+#include <map>
+#include <unordered_map>
 #include "CommandProcessing.h"
 #include "LoggingObserver.h" 
+#include "TurnBudget.h"
+#include "Orders.h"
 using namespace std;
 
 // Forward declarations
@@ -14,15 +19,90 @@ class CommandProcessor;
 class Player;
 class Map;
 class Deck;
+class ThreadPool;
 
 // Finite State Enum
 // enum GameState;
 
+// Policies for dealing territories during the startup phase
+enum class DealPolicy {
+    Random,              // default rules: territories are dealt evenly at random
+    BalancedByContinent, // every player receives an even share of each continent
+    Weighted             // players receive shares proportional to their deal weights
+};
+
+// Outcome of one game played by GameEngine::playGame
+struct GameResult {
+    bool played;                 // false when the map could not be loaded or validated
+    int winner;                  // seat (index into the strategy specs) owning the whole map, -1 for a draw
+    int turns;                   // full turns played
+    vector<int> territoryCounts; // territories held by each seat at the end
+};
+
+// Planning time of one strategy across the turns it planned under a turn budget
+struct BudgetRecord {
+    int turns = 0;                // turns planned under a budget
+    int overruns = 0;             // turns that finished after their deadline
+    double worstOverrunMs = 0.0;  // furthest any turn went past its deadline
+};
+
+// Orders of one strategy that failed validation when they were executed, by reason
+struct RejectionRecord {
+    int orders = 0;                          // orders of the strategy executed, valid or not
+    int byReason[OrderValidationCount] = {}; // indexed by OrderValidation (Valid is not counted)
+    int rejected() const;
+};
+
+// What the coalescing pass did to one strategy's orders
+struct CoalescingRecord {
+    int orders = 0;  // orders issued before the pass
+    int merged = 0;  // folded into an earlier deploy or move with the same effect
+    int dropped = 0; // removed as invalid whatever the board
+};
+
 // Game Engine class
 class GameEngine : public Subject, public ILoggable{
     private:
         // pointer data member for Game States
         GameState* currentState;
+        // seed and random engine used for dealing territories and order of play
+        unsigned int seed;
+        mt19937 rng;
+        // territory dealing policy and per-player weights (Weighted policy only)
+        DealPolicy dealPolicy;
+        vector<double> dealWeights;
+        // plan AI turns concurrently during the issue orders phase and run independent orders side by side
+        // during the execute orders phase (both share the workers, created on first use)
+        bool parallelPlanning;
+        bool parallelExecution;
+        // merge and drop orders between the issue and execute phases (OrderCoalescer), and what that saved per strategy
+        bool orderCoalescing;
+        map<string, CoalescingRecord> coalescingRecords;
+        size_t planningThreads;
+        ThreadPool* planningPool;
+        // per-turn planning budget of AI players (0 = none), what each strategy did with it,
+        // and how far each player went over last time (taken off its next budget)
+        int turnBudgetMs;
+        CancellationToken turnCancellation;
+        map<string, BudgetRecord> budgetRecords;
+        unordered_map<Player*, chrono::steady_clock::duration> overrunDebt;
+        // orders executed and rejected per strategy, to find strategies that waste orders
+        map<string, RejectionRecord> rejectionRecords;
+
+        // the shared workers, created with planningThreads threads on first use
+        ThreadPool* workerPool();
+        // plans a run of consecutive snapshot-safe players concurrently and merges their results in order
+        bool issueOrdersConcurrently(const vector<Player*>& segment, Deck* deck);
+        // starts the planning budget of a player's turn (unlimited for humans or without a turn budget)
+        TurnBudget startTurnBudget(Player* player) const;
+        // books how late a player finished planning (negative = early) against its strategy
+        void recordTurnBudget(Player* player, const TurnBudget& budget, chrono::steady_clock::duration lateness);
+        // lets a player plan its turn under its budget
+        bool issueOrderWithinBudget(Player* player, Deck* deck);
+        // books the result of validating an order against its issuer's strategy
+        void recordValidation(Order* order, OrderValidation validation);
+        // books an order the coalescing pass merged (Valid) or dropped
+        void recordCoalescing(Order* order, OrderValidation validation);
     public:
         // default constructor
         GameEngine();
@@ -39,6 +119,8 @@ class GameEngine : public Subject, public ILoggable{
         void startupPhase(CommandProcessor*& commandProcessor, Map*& map, vector<Player*>*& players, Deck*& deck);
 		// function to process the startup phase (assign territories, determine order of play, etc.)
         void startupPhaseProcess(CommandProcessor*& commandProcessor, Map*& map, vector<Player*>*& players, Deck*& deck);
+		// function to deal every territory of the map to the players in O(T+P)
+        void dealTerritories(Map* map, vector<Player*>* players);
 		// function to handle the main game loop
         void mainGameLoop(CommandProcessor*& commandProcessor, Map*& map, vector<Player*>*& players, Deck*& deck);
 		// function to distribute reinforcements to players
@@ -53,8 +135,37 @@ class GameEngine : public Subject, public ILoggable{
         // stream inssertion operator overload 
         friend ostream& operator << (ostream& os, const GameEngine& gEngine);
 
-		// Tournament mode function
-        void runTournament(const vector<string>& maps, const vector<string>& strategies, int gamesPerMap, int maxTurns);
+		// Plays one game between strategy specs on a map file without any input (output goes to ConsoleLog)
+        GameResult playGame(const string& mapFile, const vector<string>& strategies, int maxTurns);
+		// Tournament mode function, returns the winning strategy (or "Draw") of every game per map
+        vector<vector<string>> runTournament(const vector<string>& maps, const vector<string>& strategies, int gamesPerMap, int maxTurns);
+
+        // set the seed so that the startup phase is reproducible
+        void setSeed(unsigned int newSeed);
+        unsigned int getSeed() const;
+        // set the territory dealing policy (weights are only used by DealPolicy::Weighted)
+        void setDealPolicy(DealPolicy policy, const vector<double>& weights = {});
+        // let AI players plan their turn concurrently (0 threads uses every core); orders match the sequential mode
+        void setParallelPlanning(bool enabled, size_t threads = 0);
+        // execute orders that touch nothing in common side by side on the same workers (only waves wide enough
+        // to pay for it, never on a single hardware thread); the board, the output and every battle match the sequential mode
+        void setParallelExecution(bool enabled);
+        // merge each player's deploys to the same territory and friendly moves along the same border, and drop
+        // orders that cannot be valid, before executing them; the board and every battle stay the same
+        void setOrderCoalescing(bool enabled);
+        const map<string, CoalescingRecord>& getCoalescingRecords() const;
+        // prints how many orders the coalescing pass saved per strategy (nothing when it did not run)
+        void printCoalescing(ostream& out) const;
+        // give AI players a planning budget per turn (0 = none); anytime strategies stop at the deadline, and a
+        // player that overruns it has the overrun taken off its next budget and recorded against its strategy
+        void setTurnBudget(int milliseconds);
+        int getTurnBudget() const;
+        const map<string, BudgetRecord>& getBudgetRecords() const;
+        const map<string, RejectionRecord>& getRejectionRecords() const;
+        // prints the rejections per strategy and reason (nothing when no order was rejected)
+        void printRejections(ostream& out) const;
+        // makes the players planning right now stop and keep their best orders so far (safe from any thread)
+        void cancelTurn();
 
         // For testing/debugging
         string getStateString() const;
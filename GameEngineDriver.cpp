@@ -2,9 +2,28 @@
 #include "CommandProcessing.h"
 #include "Player.h"
 #include "Map.h"
+#include "PlayerStrategies.h"
+#include "ConsoleLog.h"
+#include "ScriptRunner.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <filesystem>
+#include <fstream>
 #include <memory>
+#include <thread>
+#include <iomanip>
+#include <sstream>
 using namespace std;
 
+// Territories of a map file as it loads (0 when it cannot be loaded), so a test can tell a real board from an empty one
+static int countMapTerritories(const string& mapFile) {
+    Map* map = MapLoader::loadMap(mapFile);
+    int count = map ? static_cast<int>(map->getTerritories().size()) : 0;
+    delete map;
+    return count;
+}
+
 void testGameStates() {
     cout << "=== Game States Testing ===\n\n";
 
@@ -217,7 +236,7 @@ void testMainGameLoop() {
     cout << "Execute Orders Phase\n\n";
 	gEngine.executeOrdersPhase(players); 
 
-	players->at(0)->setTerritories(list<Territory*>()); //Manually eliminate Player 1 for testing purposes
+	players->at(0)->setTerritories(vector<Territory*>()); //Manually eliminate Player 1 for testing purposes
     
 	delete players->at(2); //Delete Player 3 to avoid memory leak
 	players->erase(players->begin() + 2); //Remove Player 3 from the players vector
@@ -244,4 +263,398 @@ void testMainGameLoop() {
     delete map;
     delete players;
     delete deck;
-}
\ No newline at end of file
+}
+void testTurnBudget() {
+    cout << "=== Turn Budget Testing ===\n\n";
+
+    // A budget expires at its deadline or as soon as its token is cancelled
+    CancellationToken token;
+    TurnBudget budget(chrono::milliseconds(1000), &token);
+    cout << "1000 ms budget expired at start: " << (budget.expired() ? "yes" : "no") << "\n";
+    token.cancel();
+    cout << "After cancel: " << (budget.expired() ? "yes" : "no") << "\n\n";
+
+    // MCTS asks for 500 ms per decision, the engine only gives 20 ms per turn
+    GameEngine gEngine;
+    gEngine.setSeed(345);
+    gEngine.setTurnBudget(20);
+    MCTSPlayerStrategy::resetStatistics();
+
+    ConsoleLog::setQuiet(true);
+    GameResult result = gEngine.playGame("England.map", { "MCTS:budget=500:threads=1", "Greedy:seed=1", "Aggressive" }, 10);
+    ConsoleLog::setQuiet(false);
+
+    MCTSStatistics stats = MCTSPlayerStrategy::getStatistics();
+    cout << "Played " << result.turns << " turns under a " << gEngine.getTurnBudget() << " ms budget\n";
+    if (stats.decisions > 0) {
+        cout << "MCTS took " << (1000.0 * stats.seconds / stats.decisions) << " ms per decision on average\n";
+    }
+
+    cout << left << setw(14) << "Strategy" << setw(8) << "Turns" << setw(10) << "Overruns" << "Worst overrun (ms)\n";
+    int budgetedTurns = 0;
+    for (const auto& entry : gEngine.getBudgetRecords()) {
+        cout << left << setw(14) << entry.first << setw(8) << entry.second.turns << setw(10) << entry.second.overruns
+             << entry.second.worstOverrunMs << "\n";
+        budgetedTurns += entry.second.turns;
+    }
+
+    // Every territory was dealt, and every AI seat planned its turns under the budget
+    int territories = countMapTerritories("England.map");
+    int held = 0;
+    for (int count : result.territoryCounts) {
+        held += count;
+    }
+    cout << "[Check] England.map has " << territories << " territories, " << held << " dealt: "
+         << (territories > 0 && held == territories ? "yes" : "NO") << "\n";
+    cout << "[Check] Budget records for every strategy: "
+         << (gEngine.getBudgetRecords().size() == 3 && budgetedTurns > 0 && gEngine.getBudgetRecords().count("MCTS") ? "yes" : "NO") << "\n";
+
+    // Without a turn budget, a 10 s search is cut short from another thread
+    GameEngine unbounded;
+    unbounded.setSeed(345);
+    thread canceller([&unbounded]() {
+        this_thread::sleep_for(chrono::milliseconds(50));
+        unbounded.cancelTurn();
+    });
+
+    auto start = chrono::steady_clock::now();
+    ConsoleLog::setQuiet(true);
+    GameResult cancelled = unbounded.playGame("England.map", { "MCTS:budget=10000:threads=1", "Aggressive" }, 1);
+    ConsoleLog::setQuiet(false);
+    canceller.join();
+
+    long long elapsed = chrono::duration_cast<chrono::milliseconds>(chrono::steady_clock::now() - start).count();
+    cout << "\nOne turn of a 10000 ms MCTS cancelled after 50 ms finished in " << elapsed << " ms\n";
+    cout << "[Check] Cancelled turn played on the loaded board and stopped early: "
+         << (cancelled.played && cancelled.turns == 1 && elapsed < 5000 ? "yes" : "NO") << "\n";
+
+    cout << "\n=== Turn Budget Testing Complete ===\n";
+}
+
+void testOrderRejections() {
+    cout << "=== Order Rejection Testing ===\n\n";
+
+    // Orders are validated once when executed; the engine books every rejection against the issuing strategy
+    GameEngine gEngine;
+    gEngine.setSeed(345);
+
+    ConsoleLog::setQuiet(true);
+    GameResult result = gEngine.playGame("England.map", { "Aggressive", "Benevolent", "Greedy:seed=1", "Neutral" }, 30);
+    ConsoleLog::setQuiet(false);
+
+    cout << "Played " << result.turns << " turns\n\n";
+    ostringstream table;
+    gEngine.printRejections(table);
+    cout << (table.str().empty() ? "No order was rejected\n" : table.str());
+
+    cout << "\n=== Order Rejection Testing Complete ===\n";
+}
+
+// Runs one execute orders phase on a line of four territories, A B held by P1 and C D by P2, and returns the board
+static string executeCoalescingScenario(bool coalesce) {
+    Map map;
+    for (const char* name : { "A", "B", "C", "D" }) {
+        map.addTerritory(new Territory(name, 0, 0, "Line"));
+    }
+    const vector<Territory*>& line = map.getTerritories();
+    for (int i = 0; i + 1 < 4; i++) {
+        line[i]->addAdjacentTerritory(line[i + 1]);
+        line[i + 1]->addAdjacentTerritory(line[i]);
+    }
+
+    vector<Player*>* players = new vector<Player*>{ new Player("P1", new AggressivePlayerStrategy(nullptr)), new Player("P2", new AggressivePlayerStrategy(nullptr)) };
+    for (int i = 0; i < 4; i++) {
+        Player* owner = players->at(i / 2);
+        line[i]->setOwner(owner);
+        owner->addTerritory(line[i]);
+        line[i]->setArmies(10);
+    }
+
+    Player* p1 = players->at(0);
+    Player* p2 = players->at(1);
+    p1->issueOrder(new Deploy(p1, line[0], 3));
+    p1->issueOrder(new Deploy(p1, line[0], 2));       // merged into the first deploy
+    p1->issueOrder(new Deploy(p1, line[2], 4));       // dropped: P1 does not own C
+    p1->issueOrder(new Advance(p1, line[0], line[1], 6));
+    p1->issueOrder(new Advance(p1, line[0], line[1], 5)); // merged: nothing else names A or B before it
+    p1->issueOrder(new Advance(p1, line[1], line[2], 0)); // dropped: no armies
+    p1->issueOrder(new Advance(p1, line[1], line[2], 12));
+    p2->issueOrder(new Advance(p2, line[3], line[2], 4));
+    p2->issueOrder(new Advance(p2, line[2], line[1], 9)); // names B, so moves along A-B after it would stay apart
+    p2->issueOrder(new Advance(p2, line[3], line[0], 2)); // dropped: D does not border A
+
+    GameEngine gEngine;
+    gEngine.setSeed(7);
+    gEngine.setOrderCoalescing(coalesce);
+    ConsoleLog::setQuiet(true);
+    gEngine.executeOrdersPhase(players);
+    ConsoleLog::setQuiet(false);
+
+    ostringstream board;
+    for (Territory* territory : line) {
+        board << territory->getName() << ": " << (territory->getOwner() ? territory->getOwner()->getName() : "None") << " " << territory->getArmies() << "  ";
+    }
+    if (coalesce) {
+        const CoalescingRecord& record = gEngine.getCoalescingRecords().at("Aggressive");
+        board << "(" << record.orders << " orders, " << record.merged << " merged, " << record.dropped << " dropped)";
+    }
+
+    for (Player* player : *players) delete player;
+    delete players;
+    return board.str();
+}
+
+void testOrderCoalescing() {
+    cout << "=== Order Coalescing Testing ===\n\n";
+
+    string separate = executeCoalescingScenario(false);
+    string coalesced = executeCoalescingScenario(true);
+    cout << "Without coalescing: " << separate << "\n";
+    cout << "With coalescing:    " << coalesced << "\n";
+    cout << "[Check] Boards " << (coalesced.compare(0, separate.size(), separate) == 0 ? "MATCH" : "DIFFER") << "\n\n";
+
+    // The same seeded game with and without the coalescing pass must end the same way
+    const vector<string> strategies = { "Aggressive", "Benevolent", "Greedy:seed=1", "Neutral" };
+    GameResult results[2];
+    GameEngine engines[2];
+
+    for (int coalesce = 0; coalesce < 2; coalesce++) {
+        engines[coalesce].setSeed(345);
+        engines[coalesce].setOrderCoalescing(coalesce == 1);
+
+        ConsoleLog::setQuiet(true);
+        results[coalesce] = engines[coalesce].playGame("England.map", strategies, 40);
+        ConsoleLog::setQuiet(false);
+    }
+
+    cout << "Played " << results[1].turns << " turns, territories held:";
+    int held = 0;
+    for (int count : results[1].territoryCounts) {
+        cout << " " << count;
+        held += count;
+    }
+
+    // Only a game on a real board with orders issued says anything about the pass
+    int territories = countMapTerritories("England.map");
+    int orders = 0;
+    for (const auto& entry : engines[1].getCoalescingRecords()) {
+        orders += entry.second.orders;
+    }
+    bool realGame = results[1].played && territories > 0 && held == territories && orders > 0;
+    cout << "\n[Check] England.map has " << territories << " territories, " << held << " held at the end, "
+         << orders << " orders issued: " << (realGame ? "yes" : "NO") << "\n";
+
+    bool same = realGame && results[0].winner == results[1].winner && results[0].turns == results[1].turns
+        && results[0].territoryCounts == results[1].territoryCounts;
+    cout << "[Check] Game with coalescing " << (same ? "MATCHES" : "DIFFERS FROM") << " the game without\n\n";
+
+    engines[1].printCoalescing(cout);
+
+    cout << "\n=== Order Coalescing Testing Complete ===\n";
+}
+
+void testScriptRunner() {
+    cout << "=== Script Runner Testing ===\n\n";
+
+    // A corpus of recorded sessions: complete games, a mistyped map, a session cut short and one with Windows line breaks
+    const string directory = "script_runner_test";
+    const string logDirectory = directory + "/logs";
+    filesystem::remove_all(directory);
+    filesystem::create_directories(directory);
+
+    const vector<string> maps = { "England.map", "Florida.map" };
+    const int sessions = 24;
+    for (int i = 0; i < sessions; i++) {
+        ostringstream name;
+        name << directory << "/session" << setw(2) << setfill('0') << i << ".txt";
+        ofstream script(name.str(), ios::binary);
+        const char* lineBreak = i % 4 == 3 ? "\r\n" : "\n";
+
+        if (i % 6 == 1) script << "loadmap Missing.map" << lineBreak;
+        script << "loadmap " << maps[i % maps.size()] << lineBreak << "validatemap" << lineBreak;
+        if (i % 6 == 5) continue; // cut short before any player joined
+
+        for (int p = 0; p < 2 + i % 4; p++) {
+            script << "addplayer Player" << p << lineBreak;
+        }
+        script << "gamestart" << lineBreak << "quit" << lineBreak;
+    }
+
+    ScriptBatchSettings settings;
+    settings.scripts = ScriptRunner::listScripts(directory);
+    settings.scripts.push_back(directory + "/missing.txt");
+    settings.seed = 345;
+    settings.logDirectory = logDirectory;
+
+    // One thread, then every core: each script plays the same game either way
+    vector<ScriptResult> results[2];
+    double seconds[2];
+    for (int parallel = 0; parallel < 2; parallel++) {
+        settings.threads = parallel ? 0 : 1;
+        ScriptRunner runner(settings);
+
+        auto start = chrono::steady_clock::now();
+        results[parallel] = runner.run();
+        seconds[parallel] = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+
+        if (parallel) runner.printSummary(cout);
+    }
+
+    bool same = results[0].size() == results[1].size();
+    for (size_t i = 0; same && i < results[0].size(); i++) {
+        same = results[0][i].finalState == results[1][i].finalState && results[0][i].commands == results[1][i].commands
+            && results[0][i].territoryCounts == results[1][i].territoryCounts;
+    }
+
+    // Each started game dealt every territory of its map, and no map loaded empty
+    int mapTerritories[2] = { countMapTerritories(maps[0]), countMapTerritories(maps[1]) };
+    int started = 0;
+    bool dealt = mapTerritories[0] > 0 && mapTerritories[1] > 0;
+    for (int i = 0; i < sessions; i++) {
+        const ScriptResult& result = results[1][i];
+        if (!result.started) continue;
+        started++;
+
+        int total = 0;
+        for (int count : result.territoryCounts) {
+            total += count;
+        }
+        dealt = dealt && total == mapTerritories[i % maps.size()];
+    }
+
+    // Every run wrote its own log
+    bool logged = true;
+    for (const ScriptResult& result : results[1]) {
+        if (!result.opened) continue;
+        ifstream log(result.logFile);
+        string first;
+        logged = logged && getline(log, first) && first.rfind("File command: loadmap", 0) == 0;
+    }
+
+    cout << "\n[Check] Games started: " << started << " (expected " << sessions - sessions / 6 << ")\n";
+    cout << "[Check] Every game dealt all " << mapTerritories[0] << " territories of " << maps[0] << " or "
+         << mapTerritories[1] << " of " << maps[1] << ": " << (dealt ? "yes" : "NO") << "\n";
+    cout << "[Check] Missing script reported: " << (!results[1].back().opened && !results[1].back().error.empty() ? "yes" : "NO") << "\n";
+    cout << "[Check] Each script has its own log: " << (logged ? "yes" : "NO") << "\n";
+    cout << "[Check] Results on one thread and on every core " << (same && dealt ? "MATCH" : "DIFFER") << "\n";
+    cout << fixed << setprecision(3) << "One thread: " << seconds[0] << " s, every core: " << seconds[1] << " s\n" << defaultfloat;
+
+    filesystem::remove_all(directory);
+
+    cout << "\n=== Script Runner Testing Complete ===\n";
+}
+
+// Deals a map to a number of seats with a fresh engine and returns the seat owning each territory (-1 for none)
+static vector<int> dealSeats(Map* map, int seats, unsigned int seed, DealPolicy policy, const vector<double>& weights = {}) {
+    vector<Player*>* players = new vector<Player*>;
+    for (int i = 0; i < seats; i++) {
+        players->push_back(new Player("Seat " + to_string(i), new NeutralPlayerStrategy(nullptr)));
+    }
+
+    GameEngine engine;
+    engine.setSeed(seed);
+    engine.setDealPolicy(policy, weights);
+    engine.dealTerritories(map, players);
+
+    vector<int> owners;
+    for (Territory* territory : map->getTerritories()) {
+        auto seat = find(players->begin(), players->end(), territory->getOwner());
+        owners.push_back(seat == players->end() ? -1 : static_cast<int>(seat - players->begin()));
+        territory->setOwner(nullptr); // ready for the next deal
+    }
+
+    for (Player* player : *players) {
+        delete player;
+    }
+    delete players;
+    return owners;
+}
+
+// Territories each seat received, with -1 (unowned) counted in the last slot
+static vector<int> countSeats(const vector<int>& owners, int seats) {
+    vector<int> counts(seats + 1, 0);
+    for (int owner : owners) {
+        counts[owner < 0 ? seats : owner]++;
+    }
+    return counts;
+}
+
+void testDealPolicies() {
+    cout << "=== Deal Policies Testing ===\n\n";
+
+    Map* map = MapLoader::loadMap("England.map");
+    int territories = map ? static_cast<int>(map->getTerritories().size()) : 0;
+    cout << "[Check] England.map has " << territories << " territories: " << (territories > 0 ? "yes" : "NO") << "\n";
+    if (territories == 0) {
+        delete map;
+        cout << "\n=== Deal Policies Testing Complete ===\n";
+        return;
+    }
+
+    const int seats = 3;
+    const vector<double> weights = { 1.0, 2.0, 3.5 };
+    const char* names[] = { "Random", "BalancedByContinent", "Weighted" };
+
+    for (DealPolicy policy : { DealPolicy::Random, DealPolicy::BalancedByContinent, DealPolicy::Weighted }) {
+        vector<int> first = dealSeats(map, seats, 345, policy, weights);
+        vector<int> again = dealSeats(map, seats, 345, policy, weights);
+        vector<int> other = dealSeats(map, seats, 346, policy, weights);
+        vector<int> counts = countSeats(first, seats);
+
+        cout << names[static_cast<int>(policy)] << ":";
+        for (int seat = 0; seat < seats; seat++) {
+            cout << " " << counts[seat];
+        }
+        cout << "\n";
+
+        // Every territory dealt, shares as the policy promises
+        bool shares = counts[seats] == 0;
+        if (policy == DealPolicy::Weighted) {
+            // Largest remainder: each seat gets the floor or the ceiling of its exact share
+            double totalWeight = weights[0] + weights[1] + weights[2];
+            for (int seat = 0; seat < seats; seat++) {
+                double share = territories * weights[seat] / totalWeight;
+                shares = shares && (counts[seat] == static_cast<int>(floor(share)) || counts[seat] == static_cast<int>(ceil(share)));
+            }
+        }
+        else {
+            shares = shares && *max_element(counts.begin(), counts.end() - 1) - *min_element(counts.begin(), counts.end() - 1) <= 1;
+        }
+        if (policy == DealPolicy::BalancedByContinent) {
+            // Even within every continent too
+            for (Continent* continent : map->getContinents()) {
+                vector<int> continentOwners;
+                for (Territory* territory : continent->getTerritories()) {
+                    continentOwners.push_back(first[territory->getId()]);
+                }
+                vector<int> continentCounts = countSeats(continentOwners, seats);
+                shares = shares && *max_element(continentCounts.begin(), continentCounts.end() - 1)
+                    - *min_element(continentCounts.begin(), continentCounts.end() - 1) <= 1;
+            }
+        }
+
+        cout << "[Check] All " << territories << " territories dealt in the promised shares: " << (shares ? "yes" : "NO") << "\n";
+        cout << "[Check] Same seed deals the same board: " << (first == again ? "yes" : "NO")
+             << ", another seed deals another: " << (first != other ? "yes" : "NO") << "\n";
+    }
+    delete map;
+
+    // A map that does not validate can list territories under no continent; BalancedByContinent still deals them
+    Map loose;
+    Continent* north = new Continent("North", 2);
+    Continent* south = new Continent("South", 2);
+    loose.addContinent(north);
+    loose.addContinent(south);
+    for (int i = 0; i < 9; i++) {
+        Territory* territory = new Territory("T" + to_string(i), 0, 0, i < 3 ? "North" : i < 6 ? "South" : "");
+        loose.addTerritory(territory);
+        if (i < 3) north->addTerritory(territory);
+        else if (i < 6) south->addTerritory(territory);
+    }
+    vector<int> looseCounts = countSeats(dealSeats(&loose, 2, 345, DealPolicy::BalancedByContinent), 2);
+    cout << "\nMap with 3 of 9 territories in no continent: " << looseCounts[0] << " " << looseCounts[1] << "\n";
+    cout << "[Check] Every territory dealt, shares differ by at most one: "
+         << (looseCounts[2] == 0 && abs(looseCounts[0] - looseCounts[1]) <= 1 ? "yes" : "NO") << "\n";
+
+    cout << "\n=== Deal Policies Testing Complete ===\n";
+}
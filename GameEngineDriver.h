@@ -3,4 +3,9 @@
 // Function prototypes
 void testGameStates(); // Function to test Game States functionality
 void testStartupPhase(); //Function to test Startup Phase functionality
-void testMainGameLoop(); // Function to test Main Game Loop functionality
\ No newline at end of file
+void testMainGameLoop(); // Function to test Main Game Loop functionality
+void testTurnBudget(); // Function to test per-turn planning budgets and cancellation
+void testOrderRejections(); // Function to count the orders each strategy had rejected and why
+void testOrderCoalescing(); // Function to check that merging and dropping orders leaves a game unchanged
+void testScriptRunner(); // Function to replay a directory of command scripts side by side
+void testDealPolicies(); // Function to check every territory deal policy is complete, fair and reproducible
@@ -0,0 +1,127 @@
+#pragma once
+
+#include <utility>
+#include <vector>
+using namespace std;
+
+// Binary heap of slot numbers (0..n-1) that remembers where every slot sits, so a slot can be
+// re-sorted or removed in O(log n) after its key changes. Before(a, b) is true when slot a belongs
+// nearer the top; it reads the keys from wherever the owner stores them.
+template <typename Before>
+class IndexedHeap {
+    private:
+        vector<int> heap;
+        vector<int> positions; // positions[slot] = index in heap, -1 when the slot is not in the heap
+        Before before;
+
+        void place(int index, int slot) {
+            heap[index] = slot;
+            positions[slot] = index;
+        }
+
+        void siftUp(int index) {
+            int slot = heap[index];
+            while (index > 0) {
+                int parent = (index - 1) / 2;
+                if (!before(slot, heap[parent])) break;
+                place(index, heap[parent]);
+                index = parent;
+            }
+            place(index, slot);
+        }
+
+        void siftDown(int index) {
+            int slot = heap[index];
+            int count = static_cast<int>(heap.size());
+            while (true) {
+                int child = 2 * index + 1;
+                if (child >= count) break;
+                if (child + 1 < count && before(heap[child + 1], heap[child])) child++;
+                if (!before(heap[child], slot)) break;
+                place(index, heap[child]);
+                index = child;
+            }
+            place(index, slot);
+        }
+
+    public:
+        explicit IndexedHeap(Before before = Before()) : before(before) {}
+
+        bool empty() const { return heap.empty(); }
+        size_t size() const { return heap.size(); }
+        int top() const { return heap.front(); } // heap must not be empty
+
+        bool contains(int slot) const {
+            return slot >= 0 && slot < static_cast<int>(positions.size()) && positions[slot] >= 0;
+        }
+
+        void clear() {
+            heap.clear();
+            positions.clear();
+        }
+
+        // Replaces the contents with slots 0..count-1, heapified in O(count)
+        void assign(int count) {
+            heap.resize(count);
+            positions.assign(count, -1);
+            for (int slot = 0; slot < count; slot++) place(slot, slot);
+            for (int index = count / 2 - 1; index >= 0; index--) siftDown(index);
+        }
+
+        void push(int slot) {
+            if (slot >= static_cast<int>(positions.size())) positions.resize(slot + 1, -1);
+            heap.push_back(slot);
+            siftUp(static_cast<int>(heap.size()) - 1);
+        }
+
+        void erase(int slot) {
+            if (!contains(slot)) return;
+
+            int index = positions[slot];
+            int last = heap.back();
+            heap.pop_back();
+            positions[slot] = -1;
+
+            if (index < static_cast<int>(heap.size())) {
+                place(index, last);
+                update(last);
+            }
+        }
+
+        // Restores the heap order after the key of a slot changed
+        void update(int slot) {
+            if (!contains(slot)) return;
+
+            int index = positions[slot];
+            siftUp(index);
+            siftDown(positions[slot]);
+        }
+
+        // Renames a slot (e.g. when its item moves to another slot of the owner's list); call update() once the key is readable
+        void relabel(int from, int to) {
+            if (!contains(from)) return;
+            if (to >= static_cast<int>(positions.size())) positions.resize(to + 1, -1);
+
+            place(positions[from], to);
+            positions[from] = -1;
+        }
+
+        // Collects every slot for which keep() holds, visiting only the part of the heap above the first failures.
+        // keep() must hold for a slot's parent whenever it holds for the slot (e.g. "key equals the top key").
+        template <typename Keep>
+        void collect(Keep keep, vector<int>& out) const {
+            if (heap.empty()) return;
+
+            vector<int> pending = { 0 };
+            while (!pending.empty()) {
+                int index = pending.back();
+                pending.pop_back();
+                if (!keep(heap[index])) continue;
+
+                out.push_back(heap[index]);
+                for (int child = 2 * index + 1; child <= 2 * index + 2 && child < static_cast<int>(heap.size()); child++) {
+                    pending.push_back(child);
+                }
+            }
+        }
+};
@@ -3,46 +3,99 @@
 
 // ---------------- Subject ----------------
 
-Subject::Subject() { observers = new std::list<Observer*>; }
+// The observer list is only allocated on the first Attach: most subjects (every order of a game) never get one
+Subject::Subject() : observers(nullptr) {}
 
 Subject::Subject(const Subject& other) {
-    observers = new std::list<Observer*>(*other.observers);
+    observers = other.observers ? new std::list<Observer*>(*other.observers) : nullptr;
 }
 
 Subject& Subject::operator=(const Subject& other) {
     if (this != &other) {
         delete observers;
-        observers = new std::list<Observer*>(*other.observers);
+        observers = other.observers ? new std::list<Observer*>(*other.observers) : nullptr;
     }
     return *this;
 }
 
 Subject::~Subject() { delete observers; }
 
-void Subject::Attach(Observer* o) { observers->push_back(o); }
-void Subject::Detach(Observer* o) { observers->remove(o); }
+void Subject::Attach(Observer* o) {
+    if (!observers) observers = new std::list<Observer*>;
+    observers->push_back(o);
+}
+
+void Subject::Detach(Observer* o) {
+    if (observers) observers->remove(o);
+}
+
+bool Subject::hasObservers() const {
+    return observers && !observers->empty();
+}
+
+namespace {
+    thread_local DeferredNotifications* deferred = nullptr;
+
+    // A notification replayed from its recorded text
+    class RecordedEntry : public ILoggable {
+    private:
+        const std::string& text;
+    public:
+        explicit RecordedEntry(const std::string& text) : text(text) {}
+        std::string stringToLog() const override { return text; }
+    };
+}
 
 void Subject::Notify(ILoggable* loggable) const {
+    if (!observers || observers->empty()) return;
+    if (deferred) {
+        deferred->entries.push_back({ *observers, loggable->stringToLog() });
+        return;
+    }
     for (Observer* obs : *observers)
         obs->Update(loggable);
 }
 
+void Subject::deferTo(DeferredNotifications* buffer) {
+    deferred = buffer;
+}
+
+// ---------------- DeferredNotifications ----------------
+
+void DeferredNotifications::replay() {
+    for (const Entry& entry : entries) {
+        RecordedEntry loggable(entry.text);
+        for (Observer* obs : entry.observers)
+            obs->Update(&loggable);
+    }
+    entries.clear();
+}
+
+bool DeferredNotifications::empty() const {
+    return entries.empty();
+}
+
 // ---------------- LogObserver ----------------
 
-LogObserver::LogObserver() {
-    logfile.open("gamelog.txt", std::ios::app);
-    if (!logfile.is_open())
-        std::cerr << "Error: could not open gamelog.txt\n";
+LogObserver::LogObserver(const std::string& fileName, AsyncLogWriter::Overflow overflow) : writer(fileName, overflow) {
+    if (!writer.isOpen())
+        std::cerr << "Error: could not open " << fileName << "\n";
 }
 
 LogObserver::~LogObserver() {
-    if (logfile.is_open())
-        logfile << "--------------------------------------------------------------------------------------------------\n";
-        logfile.close();
+    writer.push("--------------------------------------------------------------------------------------------------");
 }
 
 void LogObserver::Update(ILoggable* loggable) {
-    if (logfile.is_open() && loggable)
-        logfile << loggable->stringToLog() << std::endl;
+    if (writer.isOpen() && loggable)
+        writer.push(loggable->stringToLog());
+}
+
+void LogObserver::flush() {
+    writer.flush();
+}
+
+AsyncLogWriter::Statistics LogObserver::getStatistics() const {
+    return writer.getStatistics();
 }
 
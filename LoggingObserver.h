@@ -5,6 +5,8 @@
 #include <fstream>
 #include <list>
 #include <string>
+#include <vector>
+#include "AsyncLogWriter.h"
 
 /**
  * @brief Interface for classes that can produce log messages.
@@ -24,12 +26,32 @@ public:
     virtual void Update(ILoggable* loggable) = 0;
 };
 
+/**
+ * @brief Notifications held back while work runs side by side.
+ *
+ * A thread deferring into a buffer records the text of each notification and
+ * the observers it was meant for. replay() delivers them later, in the order
+ * they were made, so observers are only ever updated from the calling thread.
+ */
+class DeferredNotifications {
+private:
+    struct Entry {
+        std::list<Observer*> observers;
+        std::string text;
+    };
+    std::vector<Entry> entries;
+    friend class Subject;
+public:
+    void replay(); ///< Updates every recorded observer in order, then empties the buffer
+    bool empty() const;
+};
+
 /**
  * @brief Subject (observable) base class.
  */
 class Subject {
 private:
-    std::list<Observer*>* observers;
+    std::list<Observer*>* observers; // nullptr until the first Attach
 public:
     Subject();
     Subject(const Subject& other);
@@ -39,18 +61,29 @@ public:
     void Attach(Observer* o);
     void Detach(Observer* o);
     void Notify(ILoggable* loggable) const;
+    bool hasObservers() const;
+
+    /// Records the calling thread's notifications in buffer instead of delivering them (nullptr delivers them again)
+    static void deferTo(DeferredNotifications* buffer);
 };
 
 /**
  * @brief Concrete observer that writes log entries to gamelog.txt.
+ *
+ * Entries are queued to an AsyncLogWriter and written in batches by its thread,
+ * so Update neither flushes nor waits for the disk, and one observer can be
+ * attached to games running side by side.
  */
 class LogObserver : public Observer {
 private:
-    std::ofstream logfile;
+    AsyncLogWriter writer;
 public:
-    LogObserver();
-    ~LogObserver();
+    explicit LogObserver(const std::string& fileName = "gamelog.txt",
+                         AsyncLogWriter::Overflow overflow = AsyncLogWriter::Overflow::Block);
+    ~LogObserver(); ///< Writes the separator and every queued entry before closing the file
     void Update(ILoggable* loggable) override;
+    void flush(); ///< Waits until every entry logged so far is in the file
+    AsyncLogWriter::Statistics getStatistics() const;
 };
 
 #endif
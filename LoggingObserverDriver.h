@@ -1,4 +1,5 @@
 #pragma once
 
 //Function prototype
-void testLoggingObserver(); //Function to test Logging Observer functionality
\ No newline at end of file
+void testLoggingObserver(); //Function to test Logging Observer functionality
+void testAsyncLogging(); //Function to test the asynchronous log writer under several logging threads
\ No newline at end of file
@@ -16,11 +16,13 @@ bool caseInsenstiveEquals(const std::string& a, const std::string& b) {
 // Territory Implementation
 Territory::Territory(const std::string& name, int x, int y, const std::string& continent)
     : name(new std::string(name)), x(x), y(y), continent(new std::string(continent)), 
-      owner(nullptr), armies(0) {}
+      owner(nullptr), armies(0), id(-1), ownerIndex(-1), enemyNeighbours(0), frontierIndex(-1) {}
 
 Territory::Territory(const Territory& other)
     : name(new std::string(*other.name)), x(other.x), y(other.y),
-      continent(new std::string(*other.continent)), owner(other.owner), armies(other.armies) {
+      continent(new std::string(*other.continent)), owner(other.owner), armies(other.armies), id(other.id), ownerIndex(-1),
+      enemyNeighbours(0), frontierIndex(-1) {
+    // Copies keep the adjacency list but stay out of the players' frontier and attackable sets
     for (Territory* adj : other.adjacentTerritories) {
         adjacentTerritories.push_back(adj);
     }
@@ -37,6 +39,7 @@ Territory& Territory::operator=(const Territory& other) {
         y = other.y;
         owner = other.owner;
         armies = other.armies;
+        id = other.id;
         
         adjacentTerritories.clear();
         for (Territory* adj : other.adjacentTerritories) {
@@ -87,18 +90,169 @@ std::string Territory::getName() const { return *name; }
 std::string Territory::getContinent() const { return *continent; }
 Player* Territory::getOwner() const { return owner; }
 int Territory::getArmies() const { return armies; }
+int Territory::getId() const { return id; }
+void Territory::setId(int id) { this->id = id; }
 
-void Territory::setOwner(Player* owner) { this->owner = owner; }
-void Territory::setArmies(int armies) { this->armies = armies; }
+void Territory::setOwner(Player* owner) {
+    if (owner == this->owner) return;
+
+    Player* previous = this->owner;
+
+    // Cached strategy queries of everyone bordering this territory may change (every owner here is alive:
+    // ~Player gives its land up through this function before it is freed)
+    if (previous != nullptr) previous->markDirty();
+    if (owner != nullptr) owner->markDirty();
+    for (Territory* incoming : incomingTerritories) {
+        if (incoming->owner != nullptr) incoming->owner->markDirty();
+    }
+
+    // Leave the previous owner's frontier before the owner changes
+    if (previous != nullptr && frontierIndex >= 0) {
+        previous->removeFrontierTerritory(this);
+    }
+
+    this->owner = owner;
+
+    // This territory may now be attackable by the previous owner and no longer by the new one
+    syncAttackable(previous);
+    syncAttackable(owner);
+
+    enemyNeighbours = 0;
+    for (Territory* adj : adjacentTerritories) {
+        if (adj->owner != owner) enemyNeighbours++;
+    }
+    syncFrontier();
+
+    // Territories this one borders gain or lose an adjacent territory of each owner
+    for (Territory* adj : adjacentTerritories) {
+        adj->changeAdjacentOwnerCount(previous, -1);
+        adj->changeAdjacentOwnerCount(owner, 1);
+    }
+
+    // Territories bordering this one gain or lose an enemy neighbour
+    for (Territory* incoming : incomingTerritories) {
+        if (incoming == this) continue; // already recounted above
+        incoming->enemyNeighbours += (owner != incoming->owner) - (previous != incoming->owner);
+        incoming->syncFrontier();
+    }
+}
+
+void Territory::setArmies(int armies) {
+    if (armies == this->armies) return;
+
+    this->armies = armies;
+    if (owner != nullptr) {
+        owner->markDirty();
+        owner->reorderTerritory(this); // keep the owner's army heaps sorted
+    }
+}
+
+int Territory::getOwnerIndex() const { return ownerIndex; }
+void Territory::setOwnerIndex(int index) { ownerIndex = index; }
+
+int Territory::getEnemyNeighbourCount() const { return enemyNeighbours; }
+
+bool Territory::isAttackableBy(const Player* player) const {
+    return getAttackableIndex(player) >= 0;
+}
+
+int Territory::getFrontierIndex() const { return frontierIndex; }
+void Territory::setFrontierIndex(int index) { frontierIndex = index; }
+
+int Territory::getAttackableIndex(const Player* player) const {
+    const AdjacentOwner* entry = findAdjacentOwner(player);
+    return entry ? entry->attackableIndex : -1;
+}
+
+void Territory::setAttackableIndex(const Player* player, int index) {
+    AdjacentOwner* entry = findAdjacentOwner(player);
+    if (entry) entry->attackableIndex = index;
+}
+
+Territory::AdjacentOwner* Territory::findAdjacentOwner(const Player* player) {
+    for (AdjacentOwner& entry : adjacentOwners) {
+        if (entry.player == player) return &entry;
+    }
+    return nullptr;
+}
+
+const Territory::AdjacentOwner* Territory::findAdjacentOwner(const Player* player) const {
+    for (const AdjacentOwner& entry : adjacentOwners) {
+        if (entry.player == player) return &entry;
+    }
+    return nullptr;
+}
+
+void Territory::changeAdjacentOwnerCount(Player* player, int delta) {
+    if (player == nullptr) return; // unowned territories attack nothing
+
+    AdjacentOwner* entry = findAdjacentOwner(player);
+    if (entry == nullptr) {
+        adjacentOwners.push_back({ player, 0, -1 });
+        entry = &adjacentOwners.back();
+    }
+
+    entry->count += delta;
+    if (entry->count > 0) {
+        syncAttackable(player);
+        return;
+    }
+
+    // No territory of this player borders us any more
+    if (entry->attackableIndex >= 0) {
+        player->removeAttackableTerritory(this);
+    }
+    *entry = adjacentOwners.back();
+    adjacentOwners.pop_back();
+}
+
+void Territory::syncAttackable(Player* player) {
+    if (player == nullptr) return;
+
+    AdjacentOwner* entry = findAdjacentOwner(player);
+    if (entry == nullptr) return;
+
+    bool attackable = entry->count > 0 && owner != player;
+    if (attackable && entry->attackableIndex < 0) {
+        player->addAttackableTerritory(this);
+    }
+    else if (!attackable && entry->attackableIndex >= 0) {
+        player->removeAttackableTerritory(this);
+    }
+}
+
+void Territory::syncFrontier() {
+    if (owner == nullptr) return;
+
+    if (enemyNeighbours > 0 && frontierIndex < 0) {
+        owner->addFrontierTerritory(this);
+    }
+    else if (enemyNeighbours == 0 && frontierIndex >= 0) {
+        owner->removeFrontierTerritory(this);
+    }
+}
 
 void Territory::addAdjacentTerritory(Territory* territory) {
     adjacentTerritories.push_back(territory);
+    territory->incomingTerritories.push_back(this);
+    if (owner != nullptr) owner->markDirty();
+
+    // Keep the border bookkeeping valid when adjacency is wired after owners are set
+    if (territory->owner != owner) {
+        enemyNeighbours++;
+        syncFrontier();
+    }
+    territory->changeAdjacentOwnerCount(owner, 1);
 }
 
 const std::vector<Territory*>& Territory::getAdjacentTerritories() const {
     return adjacentTerritories;
 }
 
+const std::vector<Territory*>& Territory::getIncomingTerritories() const {
+    return incomingTerritories;
+}
+
 bool Territory::isAdjacentTo(const Territory* other) const {
     for (Territory* adj : adjacentTerritories) {
         if (adj == other) return true;
@@ -203,6 +357,7 @@ Map::~Map() {
 }
 
 void Map::addTerritory(Territory* territory) {
+    territory->setId(static_cast<int>(territories.size()));
     territories.push_back(territory);
 }
 
@@ -357,6 +512,9 @@ Map* MapLoader::loadMap(const std::string& filename) {
     bool inTerritoriesSection = false;
     
     while (std::getline(file, line)) {
+        // Maps saved on Windows end their lines with "\r\n"
+        if (!line.empty() && line.back() == '\r') line.pop_back();
+
         // Skip empty lines and comments
         if (line.empty() || line[0] == ';') continue;
         
@@ -421,6 +579,7 @@ Map* MapLoader::loadMap(const std::string& filename) {
     inTerritoriesSection = false;
     
     while (std::getline(file, line)) {
+        if (!line.empty() && line.back() == '\r') line.pop_back();
         if (line.empty() || line[0] == ';') continue;
         
         if (caseInsenstiveEquals(line, "[Territories]")) {
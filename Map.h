@@ -27,14 +27,29 @@ public:
     std::string getContinent() const;
     Player* getOwner() const;
     int getArmies() const;
+    int getId() const; // dense index in the map's territory list, -1 until added to a map
     
     // Setters
     void setOwner(Player* owner);
     void setArmies(int armies);
+    void setId(int id);
+
+    // Position in the owning player's territory list (kept by Player for O(1) removal)
+    int getOwnerIndex() const;
+    void setOwnerIndex(int index);
+
+    // Border bookkeeping, updated in O(degree) by setOwner and addAdjacentTerritory
+    int getEnemyNeighbourCount() const; // adjacent territories not owned by this territory's owner
+    bool isAttackableBy(const Player* player) const; // not owned by player, but adjacent to a territory it owns
+    int getFrontierIndex() const; // position in the owner's frontier set, -1 if not on the frontier
+    void setFrontierIndex(int index);
+    int getAttackableIndex(const Player* player) const; // position in player's attackable set, -1 if absent
+    void setAttackableIndex(const Player* player, int index);
     
     // Adjacency management
     void addAdjacentTerritory(Territory* territory);
     const std::vector<Territory*>& getAdjacentTerritories() const;
+    const std::vector<Territory*>& getIncomingTerritories() const; // territories that list this one as adjacent
     
     // Stream insertion
     friend std::ostream& operator<<(std::ostream& os, const Territory& territory);
@@ -43,13 +58,33 @@ public:
     bool isAdjacentTo(const Territory* other) const;
 
 private:
+    // Number of incoming neighbours owned by a player, and this territory's slot in that player's attackable set
+    struct AdjacentOwner {
+        Player* player;
+        int count;
+        int attackableIndex;
+    };
+
     std::string* name;
     int x;
     int y;
     std::string* continent;
     Player* owner;
     int armies;
+    int id;
+    int ownerIndex;
+    int enemyNeighbours;
+    int frontierIndex;
     std::vector<Territory*> adjacentTerritories;
+    std::vector<Territory*> incomingTerritories;
+    std::vector<AdjacentOwner> adjacentOwners;
+
+    // Helpers for the border bookkeeping
+    AdjacentOwner* findAdjacentOwner(const Player* player);
+    const AdjacentOwner* findAdjacentOwner(const Player* player) const;
+    void changeAdjacentOwnerCount(Player* player, int delta);
+    void syncAttackable(Player* player);
+    void syncFrontier();
 };
 
 // Continent class
@@ -90,7 +125,7 @@ public:
     ~Map();
     
     // Territory and Continent management
-    void addTerritory(Territory* territory);
+    void addTerritory(Territory* territory); // also gives the territory the next id
     void addContinent(Continent* continent);
     
     // Getters
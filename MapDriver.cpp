@@ -1,5 +1,9 @@
 #include "Map.h"
+#include "Player.h"
+#include "PlayerStrategies.h"
+#include <algorithm>
 #include <iostream>
+#include <random>
 
 void testLoadMaps() {
     std::cout << "=== Testing Map Loading and Validation ===\n";
@@ -48,3 +52,226 @@ void testLoadMaps() {
     
     std::cout << "\n=== Map Testing Complete ===\n\n";
 }
+
+// Recounts the border state of every territory from the adjacency lists alone and compares it with what
+// setOwner, setArmies and addAdjacentTerritory kept up to date; returns the number of mismatches
+static int countBorderMismatches(const Map& map, const std::vector<Player*>& players) {
+    const std::vector<Territory*>& territories = map.getTerritories();
+    int mismatches = 0;
+
+    // attackers[t][p]: a territory player p owns lists territory t as adjacent
+    std::vector<std::vector<bool>> attackers(territories.size(), std::vector<bool>(players.size(), false));
+    for (Territory* territory : territories) {
+        for (size_t p = 0; p < players.size(); p++) {
+            if (territory->getOwner() != players[p]) continue;
+            for (Territory* adj : territory->getAdjacentTerritories()) {
+                attackers[adj->getId()][p] = true;
+            }
+        }
+    }
+
+    std::vector<size_t> frontierSizes(players.size(), 0);
+    std::vector<size_t> attackableSizes(players.size(), 0);
+    for (Territory* territory : territories) {
+        Player* owner = territory->getOwner();
+
+        int enemies = 0;
+        for (Territory* adj : territory->getAdjacentTerritories()) {
+            if (adj->getOwner() != owner) enemies++;
+        }
+        if (territory->getEnemyNeighbourCount() != enemies) mismatches++;
+
+        // On its owner's frontier exactly when it is owned and has an enemy neighbour, at the slot it remembers
+        bool frontier = owner != nullptr && enemies > 0;
+        int frontierIndex = territory->getFrontierIndex();
+        if (frontier != (frontierIndex >= 0)) mismatches++;
+        if (frontier && (frontierIndex >= static_cast<int>(owner->getFrontier().size()) || owner->getFrontier()[frontierIndex] != territory)) {
+            mismatches++;
+        }
+
+        for (size_t p = 0; p < players.size(); p++) {
+            bool attackable = owner != players[p] && attackers[territory->getId()][p];
+            int attackableIndex = territory->getAttackableIndex(players[p]);
+            if (attackable != territory->isAttackableBy(players[p])) mismatches++;
+            if (attackable && (attackableIndex < 0 || attackableIndex >= static_cast<int>(players[p]->getAttackable().size()) ||
+                               players[p]->getAttackable()[attackableIndex] != territory)) {
+                mismatches++;
+            }
+            if (owner == players[p] && frontier) frontierSizes[p]++;
+            if (attackable) attackableSizes[p]++;
+        }
+    }
+
+    // The players' sets hold nothing else, and their army queries agree with a scan
+    for (size_t p = 0; p < players.size(); p++) {
+        Player* player = players[p];
+        if (player->getFrontier().size() != frontierSizes[p]) mismatches++;
+        if (player->getAttackable().size() != attackableSizes[p]) mismatches++;
+
+        const std::vector<Territory*>& owned = player->getTerritories();
+        auto byArmies = [](const Territory* a, const Territory* b) { return a->getArmies() < b->getArmies(); };
+        if (owned.empty()) {
+            if (player->getStrongestTerritory() != nullptr || player->getWeakestTerritory() != nullptr) mismatches++;
+        }
+        else {
+            if (player->getStrongestTerritory()->getArmies() != (*std::max_element(owned.begin(), owned.end(), byArmies))->getArmies()) mismatches++;
+            if (player->getWeakestTerritory()->getArmies() != (*std::min_element(owned.begin(), owned.end(), byArmies))->getArmies()) mismatches++;
+        }
+
+        const std::vector<Territory*>& frontier = player->getFrontier();
+        Territory* strongestFrontier = player->getStrongestFrontierTerritory();
+        if (frontier.empty() != (strongestFrontier == nullptr)) mismatches++;
+        if (!frontier.empty() && strongestFrontier->getArmies() != (*std::max_element(frontier.begin(), frontier.end(), byArmies))->getArmies()) {
+            mismatches++;
+        }
+    }
+
+    return mismatches;
+}
+
+void testBorderBookkeeping() {
+    std::cout << "=== Testing Border Bookkeeping ===\n\n";
+
+    Map* map = MapLoader::loadMap("England.map");
+    const int territoryCount = map ? static_cast<int>(map->getTerritories().size()) : 0;
+    std::cout << "[Check] England.map has " << territoryCount << " territories: " << (territoryCount > 0 ? "yes" : "NO") << "\n";
+    if (territoryCount == 0) {
+        delete map;
+        std::cout << "\n=== Border Bookkeeping Testing Complete ===\n\n";
+        return;
+    }
+
+    std::vector<Player*> players;
+    for (int i = 0; i < 4; i++) {
+        players.push_back(new Player("Player " + std::to_string(i + 1), new NeutralPlayerStrategy(nullptr)));
+    }
+
+    // Random owners (nullptr is the neutral owner a blockade leaves), armies and extra one-way borders,
+    // recounting everything after each change
+    std::mt19937 gen(345);
+    const int steps = 5000;
+    int mismatches = 0;
+    int stale = 0;
+    int ownerChanges = 0, armyChanges = 0, bordersAdded = 0;
+    const std::vector<Territory*>& territories = map->getTerritories();
+
+    for (int step = 0; step < steps; step++) {
+        Territory* territory = territories[gen() % territories.size()];
+        int change = static_cast<int>(gen() % 20);
+
+        std::vector<unsigned long> versions;
+        for (Player* player : players) {
+            versions.push_back(player->getStateVersion());
+        }
+        // Players whose cached queries this change must invalidate
+        std::vector<Player*> touched;
+
+        if (change < 10) {
+            Player* previous = territory->getOwner();
+            Player* owner = gen() % 5 == 0 ? nullptr : players[gen() % players.size()];
+            if (owner == previous) continue;
+
+            touched = { previous, owner };
+            for (Territory* incoming : territory->getIncomingTerritories()) {
+                touched.push_back(incoming->getOwner());
+            }
+
+            if (previous != nullptr) previous->removeTerritory(territory);
+            territory->setOwner(owner);
+            if (owner != nullptr) owner->addTerritory(territory);
+            ownerChanges++;
+        }
+        else if (change < 19) {
+            int armies = static_cast<int>(gen() % 50);
+            if (armies == territory->getArmies()) continue;
+
+            touched = { territory->getOwner() };
+            territory->setArmies(armies);
+            armyChanges++;
+        }
+        else {
+            Territory* other = territories[gen() % territories.size()];
+            if (other == territory || territory->isAdjacentTo(other)) continue;
+
+            touched = { territory->getOwner() };
+            territory->addAdjacentTerritory(other);
+            bordersAdded++;
+        }
+
+        for (size_t p = 0; p < players.size(); p++) {
+            bool mustChange = std::find(touched.begin(), touched.end(), players[p]) != touched.end();
+            if (mustChange && players[p]->getStateVersion() == versions[p]) stale++;
+        }
+        mismatches += countBorderMismatches(*map, players);
+    }
+
+    std::cout << steps << " random steps: " << ownerChanges << " owner changes, " << armyChanges << " army changes, "
+              << bordersAdded << " borders added\n";
+    std::cout << "[Check] Frontier, attackable and enemy-neighbour state matches a recount after every step: "
+              << (mismatches == 0 ? "yes" : "NO (" + std::to_string(mismatches) + " mismatches)") << "\n";
+    std::cout << "[Check] Every change marked the players bordering it dirty: "
+              << (stale == 0 ? "yes" : "NO (" + std::to_string(stale) + " missed)") << "\n";
+
+    // A copy recounts its borders from its own list and owns nothing, so deleting it leaves the board alone
+    Player* original = players[0];
+    while (original->getTerritories().empty()) {
+        Territory* territory = territories[gen() % territories.size()];
+        if (territory->getOwner() != nullptr) territory->getOwner()->removeTerritory(territory);
+        territory->setOwner(original);
+        original->addTerritory(territory);
+    }
+    Player* copy = new Player(*original);
+    bool copySets = copy->getFrontier().size() == original->getFrontier().size()
+        && copy->getAttackable().size() == original->getAttackable().size();
+    delete copy;
+    int copyMismatches = countBorderMismatches(*map, players);
+    std::cout << "[Check] A copied player has its own border sets and deleting it leaves the board alone: "
+              << (copySets && copyMismatches == 0 ? "yes" : "NO") << "\n";
+
+    // Deleting a player who still owns land (as the main game loop driver does) leaves that land unowned,
+    // and handing it to someone else afterwards must not touch the deleted player
+    std::vector<Territory*> orphaned = original->getTerritories();
+    std::vector<Player*> bordering; // players whose cached queries the deletion must invalidate
+    for (Territory* territory : orphaned) {
+        for (Territory* incoming : territory->getIncomingTerritories()) {
+            Player* owner = incoming->getOwner();
+            if (owner != nullptr && owner != original && std::find(bordering.begin(), bordering.end(), owner) == bordering.end()) {
+                bordering.push_back(owner);
+            }
+        }
+    }
+    std::vector<unsigned long> borderingVersions;
+    for (Player* player : bordering) {
+        borderingVersions.push_back(player->getStateVersion());
+    }
+
+    delete original;
+    players.erase(players.begin());
+
+    bool invalidated = true;
+    for (size_t i = 0; i < bordering.size(); i++) {
+        invalidated = invalidated && bordering[i]->getStateVersion() != borderingVersions[i];
+    }
+
+    int unowned = 0;
+    for (Territory* territory : orphaned) {
+        unowned += territory->getOwner() == nullptr ? 1 : 0;
+    }
+    int deleteMismatches = countBorderMismatches(*map, players);
+    for (Territory* territory : orphaned) {
+        territory->setOwner(players[0]);
+        players[0]->addTerritory(territory);
+    }
+    deleteMismatches += countBorderMismatches(*map, players);
+    std::cout << "[Check] Deleting a player with " << orphaned.size() << " territories leaves them unowned and they can be dealt again: "
+              << (unowned == static_cast<int>(orphaned.size()) && deleteMismatches == 0 ? "yes" : "NO") << "\n";
+    std::cout << "[Check] Deleting it marked the " << bordering.size() << " players bordering its land dirty: "
+              << (invalidated ? "yes" : "NO") << "\n";
+
+    for (Player* player : players) {
+        delete player;
+    }
+    delete map;
+
+    std::cout << "\n=== Border Bookkeeping Testing Complete ===\n\n";
+}
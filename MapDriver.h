@@ -1,4 +1,5 @@
 #pragma once
 
 // Function prototypes
-void testLoadMaps(); // Function to test load maps functionality
\ No newline at end of file
+void testLoadMaps(); // Function to test load maps functionality
+void testBorderBookkeeping(); // Random owner, army and border changes checked against a recount of the adjacency lists
\ No newline at end of file
@@ -0,0 +1,108 @@
+#include "OrderCoalescer.h"
+#include "Player.h"
+#include "Map.h"
+
+OrderCoalescer::OrderCoalescer(RemovedCallback onRemoved) : onRemoved(move(onRemoved)) {}
+
+bool OrderCoalescer::isProvablyInvalid(const Order& order, OrderValidation validation) {
+    switch (validation) {
+    case OrderValidation::MissingOperand:
+    case OrderValidation::BadArmies:
+    case OrderValidation::SelfTarget:
+        return true;
+    case OrderValidation::NotAdjacent:
+        return order.getType() == OrderType::Advance; // borders never change (a bomb's depend on who owns them)
+    default:
+        return false;
+    }
+}
+
+void OrderCoalescer::remove(Order* order, OrderValidation validation) {
+    if (onRemoved) onRemoved(order, validation);
+}
+
+void OrderCoalescer::coalesceDeploys(Player* player) {
+    OrdersList* ordersList = player->getOrdersList();
+    const vector<Order*>& orders = ordersList->getOrders();
+    unordered_map<const Territory*, Deploy*> firstDeploy;
+
+    for (int i = 0; i < static_cast<int>(orders.size()); i++) {
+        if (orders[i]->getType() != OrderType::Deploy) continue;
+
+        Deploy* deploy = static_cast<Deploy*>(orders[i]);
+        OrderValidation validation = deploy->validate().getResult();
+        OrderOperands operands = deploy->getOperands();
+
+        if (validation == OrderValidation::Valid) {
+            auto found = firstDeploy.find(operands.target);
+            if (found == firstDeploy.end()) {
+                firstDeploy.emplace(operands.target, deploy);
+                continue;
+            }
+            found->second->setArmies(found->second->getOperands().armies + operands.armies);
+        }
+
+        remove(deploy, validation);
+        ordersList->remove(i);
+        i--; // compensate for remove
+    }
+}
+
+void OrderCoalescer::name(const Territory* territory) {
+    if (territory) claims[territory] = Named;
+}
+
+bool OrderCoalescer::tryMerge(Advance* move, const OrderOperands& operands) {
+    auto source = claims.find(operands.source);
+    auto target = claims.find(operands.target);
+
+    // Nothing so far names either territory: the move leads a new group
+    if (source == claims.end() && target == claims.end()) {
+        int group = static_cast<int>(groups.size());
+        groups.push_back(MoveGroup{ move, operands.issuer, operands.source, operands.target, operands.armies });
+        claims[operands.source] = group;
+        claims[operands.target] = group;
+        return false;
+    }
+
+    // Only the moves of one group named them: the source still holds the armies it holds now
+    if (source != claims.end() && target != claims.end() && source->second == target->second && source->second != Named) {
+        MoveGroup& group = groups[source->second];
+        if (group.issuer == operands.issuer && group.source == operands.source && group.target == operands.target
+            && group.armies + operands.armies <= operands.source->getArmies()) {
+            group.armies += operands.armies;
+            group.head->setArmies(group.armies);
+            remove(move, OrderValidation::Valid);
+            return true;
+        }
+    }
+
+    name(operands.source);
+    name(operands.target);
+    return false;
+}
+
+void OrderCoalescer::coalesceSequence(vector<Order*>& sequence) {
+    groups.clear();
+    claims.clear();
+
+    for (Order*& order : sequence) {
+        if (order == nullptr) continue;
+
+        OrderValidation validation = order->validate().getResult();
+        if (isProvablyInvalid(*order, validation)) {
+            remove(order, validation);
+            order = nullptr;
+            continue;
+        }
+
+        OrderOperands operands = order->getOperands();
+        if (order->getType() == OrderType::Advance && validation == OrderValidation::Valid && operands.target->getOwner() == operands.issuer) {
+            if (tryMerge(static_cast<Advance*>(order), operands)) order = nullptr;
+            continue;
+        }
+
+        name(operands.source);
+        name(operands.target);
+    }
+}
@@ -0,0 +1,54 @@
+#pragma once
+
+#include <functional>
+#include <unordered_map>
+#include <vector>
+#include "Orders.h"
+using namespace std;
+
+class Player;
+class Territory;
+
+// Shrinks a turn's orders between the issue and execute phases without changing what the turn does.
+//
+// Deploys: a player's deploys to the same territory become one deploy of their total, and deploys that are
+// invalid are dropped. Only deploys run during the deploy step, so ownership cannot change before they execute.
+//
+// Other orders, in the round-robin sequence the execute phase runs them in (after the deploy step): orders whose
+// validation cannot depend on the board (nothing named, no armies, a territory or player targeting itself, an
+// advance between territories that do not border) are dropped, and a friendly move is merged into an earlier one
+// along the same border while no other order before it names either territory. Until then both territories keep
+// their owner and armies, so the merged move is valid exactly when the moves it replaces were. Orders taken out
+// of the sequence leave nullptr behind, so every remaining order (and its battle) keeps its position.
+class OrderCoalescer {
+    public:
+        // Called before an order is taken out: with Valid when it was merged into another, else why it was dropped
+        using RemovedCallback = function<void(Order* order, OrderValidation validation)>;
+
+        explicit OrderCoalescer(RemovedCallback onRemoved = nullptr);
+
+        void coalesceDeploys(Player* player); // on the player's orders list, before the deploy step
+        void coalesceSequence(vector<Order*>& sequence); // after the deploy step
+
+        static bool isProvablyInvalid(const Order& order, OrderValidation validation);
+
+    private:
+        // Friendly moves merged so far along one border, led by the first of them
+        struct MoveGroup {
+            Advance* head;
+            Player* issuer;
+            Territory* source;
+            Territory* target;
+            int armies;
+        };
+
+        RemovedCallback onRemoved;
+        vector<MoveGroup> groups;
+        // Group of moves that alone named a territory so far, or Named once any other order did
+        unordered_map<const Territory*, int> claims;
+        static const int Named = -1;
+
+        void remove(Order* order, OrderValidation validation);
+        void name(const Territory* territory);
+        bool tryMerge(Advance* move, const OrderOperands& operands);
+};
@@ -0,0 +1,227 @@
+#include "OrderExecutor.h"
+#include "Orders.h"
+#include "Map.h"
+#include "ThreadPool.h"
+#include "ConsoleLog.h"
+#include <algorithm>
+#include <limits>
+#include <sstream>
+#include <thread>
+
+namespace {
+    // Stands for the observers of orders that have some: they are notified in sequence, never side by side
+    const char ObserverKey = 0;
+
+    void touch(vector<const void*>& keys, const void* key) {
+        if (key != nullptr) keys.push_back(key);
+    }
+}
+
+OrderExecutor::OrderExecutor(ThreadPool* pool, size_t minParallelWave)
+    : pool(pool), minParallelWave(max<size_t>(minParallelWave, 1)), waveCount(0), widestWave(0) {}
+
+size_t OrderExecutor::defaultMinParallelWave() {
+    return thread::hardware_concurrency() > 1 ? DefaultMinParallelWave : numeric_limits<size_t>::max();
+}
+
+size_t OrderExecutor::getMinParallelWave() const {
+    return minParallelWave;
+}
+
+size_t OrderExecutor::getWaveCount() const {
+    return waveCount;
+}
+
+size_t OrderExecutor::getWidestWave() const {
+    return widestWave;
+}
+
+const vector<OrderValidation>& OrderExecutor::getValidations() const {
+    return validations;
+}
+
+const vector<Player*>& OrderExecutor::ownersOf(const Territory* territory) {
+    auto found = possibleOwners.find(territory);
+    if (found == possibleOwners.end()) {
+        found = possibleOwners.emplace(territory, vector<Player*>{ territory->getOwner() }).first;
+    }
+    return found->second;
+}
+
+void OrderExecutor::addOwner(const Territory* territory, Player* owner) {
+    ownersOf(territory);
+    vector<Player*>& owners = possibleOwners[territory];
+    if (find(owners.begin(), owners.end(), owner) == owners.end()) owners.push_back(owner);
+}
+
+void OrderExecutor::addOwners(const Territory* territory, Footprint& footprint) {
+    for (Player* owner : ownersOf(territory)) {
+        touch(footprint.writes, owner);
+    }
+}
+
+void OrderExecutor::addOwnerChange(const Territory* territory, Footprint& footprint) {
+    touch(footprint.writes, territory);
+    addOwners(territory, footprint);
+
+    for (const vector<Territory*>* ring : { &territory->getAdjacentTerritories(), &territory->getIncomingTerritories() }) {
+        for (Territory* neighbour : *ring) {
+            touch(footprint.writes, neighbour);
+            addOwners(neighbour, footprint);
+            for (Territory* second : neighbour->getAdjacentTerritories()) addOwners(second, footprint);
+            for (Territory* second : neighbour->getIncomingTerritories()) addOwners(second, footprint);
+        }
+    }
+}
+
+OrderExecutor::Footprint OrderExecutor::footprintOf(const Order* order) {
+    Footprint footprint;
+    OrderOperands operands = order->getOperands();
+    touch(footprint.writes, operands.issuer); // army heaps of its territories, its territory list
+    touch(footprint.writes, operands.source);
+    touch(footprint.writes, operands.target);
+
+    switch (order->getType()) {
+    case OrderType::Advance:
+        // A move to a territory only the issuer can own is friendly; anything else may be a battle
+        if (operands.target && ownersOf(operands.target) != vector<Player*>{ operands.issuer }) {
+            addOwnerChange(operands.target, footprint); // defenders, truces and a conquest
+            addOwner(operands.target, operands.issuer);
+        }
+        break;
+    case OrderType::Bomb:
+        if (operands.target) {
+            addOwners(operands.target, footprint); // truces, army heap, a Neutral owner turning Aggressive
+            for (Territory* neighbour : operands.target->getAdjacentTerritories()) touch(footprint.reads, neighbour);
+        }
+        break;
+    case OrderType::Blockade:
+        if (operands.target) {
+            addOwnerChange(operands.target, footprint);
+            addOwner(operands.target, nullptr);
+        }
+        break;
+    case OrderType::Negotiate:
+        touch(footprint.writes, operands.targetPlayer);
+        break;
+    case OrderType::Deploy:
+    case OrderType::Airlift:
+        break; // only valid between the issuer's own territories
+    }
+
+    if (order->hasObservers()) touch(footprint.writes, &ObserverKey);
+    return footprint;
+}
+
+vector<vector<int>> OrderExecutor::buildWaves(const vector<Order*>& sequence) {
+    possibleOwners.clear();
+    unordered_map<const void*, Access> accesses;
+    vector<int> waveOf(sequence.size());
+    vector<vector<int>> waves;
+
+    for (int i = 0; i < static_cast<int>(sequence.size()); i++) {
+        if (sequence[i] == nullptr) continue;
+        Footprint footprint = footprintOf(sequence[i]);
+
+        // One wave after the latest conflicting order
+        int wave = 0;
+        for (const void* key : footprint.reads) {
+            const Access& access = accesses[key];
+            if (access.lastWriter >= 0) wave = max(wave, waveOf[access.lastWriter] + 1);
+        }
+        for (const void* key : footprint.writes) {
+            const Access& access = accesses[key];
+            if (access.lastWriter >= 0) wave = max(wave, waveOf[access.lastWriter] + 1);
+            for (int reader : access.readers) wave = max(wave, waveOf[reader] + 1);
+        }
+
+        for (const void* key : footprint.reads) {
+            accesses[key].readers.push_back(i);
+        }
+        for (const void* key : footprint.writes) {
+            Access& access = accesses[key];
+            access.lastWriter = i;
+            access.readers.clear();
+        }
+
+        waveOf[i] = wave;
+        if (wave >= static_cast<int>(waves.size())) waves.resize(wave + 1);
+        waves[wave].push_back(i);
+    }
+
+    return waves;
+}
+
+OrderValidation OrderExecutor::run(Order* order) {
+    OrderCheck check = order->validate();
+    order->execute(check);
+    return check.getResult();
+}
+
+void OrderExecutor::execute(const vector<Order*>& sequence) {
+    // The n-th order of the sequence resolves its battle at position first + n of the caller's battle stream
+    BattleStream& battles = Advance::getBattleStream();
+    const uint64_t seed = battles.getSeed();
+    const uint64_t first = battles.getPosition();
+    validations.assign(sequence.size(), OrderValidation::Valid);
+
+    vector<vector<int>> waves;
+    bool sideBySide = pool != nullptr && pool->size() > 1 && sequence.size() >= minParallelWave;
+    if (sideBySide) {
+        waves = buildWaves(sequence);
+        sideBySide = any_of(waves.begin(), waves.end(), [this](const vector<int>& wave) { return wave.size() >= minParallelWave; });
+    }
+
+    if (!sideBySide) {
+        for (size_t i = 0; i < sequence.size(); i++) {
+            if (sequence[i] == nullptr) continue;
+            battles.seek(first + i);
+            validations[i] = run(sequence[i]);
+        }
+        battles.seek(first + sequence.size());
+        waveCount = sequence.size();
+        widestWave = sequence.empty() ? 0 : 1;
+        return;
+    }
+
+    waveCount = waves.size();
+    widestWave = 0;
+
+    const bool quiet = ConsoleLog::isQuiet();
+    vector<ostringstream> output(quiet ? 0 : sequence.size());
+
+    // Runs the i-th order on the calling thread with its own output buffer and battle position
+    auto runBuffered = [&](int i) {
+        bool wasQuiet = ConsoleLog::isQuiet();
+        ostream* wasRedirected = ConsoleLog::getRedirect();
+        ConsoleLog::setQuiet(quiet);
+        if (!quiet) ConsoleLog::redirect(&output[i]);
+
+        BattleStream& stream = Advance::getBattleStream();
+        stream.seed(seed);
+        stream.seek(first + i);
+        validations[i] = run(sequence[i]);
+
+        ConsoleLog::redirect(wasRedirected);
+        ConsoleLog::setQuiet(wasQuiet);
+    };
+
+    for (const vector<int>& wave : waves) {
+        widestWave = max(widestWave, wave.size());
+        if (wave.size() < minParallelWave) {
+            for (int i : wave) runBuffered(i);
+            continue;
+        }
+
+        // One contiguous slice per worker, so a wave costs a handoff per worker rather than per order
+        const size_t slices = min(pool->size(), wave.size());
+        pool->parallelFor(slices, [&](size_t s) {
+            for (size_t k = wave.size() * s / slices; k < wave.size() * (s + 1) / slices; k++) runBuffered(wave[k]);
+        });
+    }
+
+    for (ostringstream& printed : output) {
+        ConsoleLog::out() << printed.str();
+    }
+    battles.seek(first + sequence.size());
+}
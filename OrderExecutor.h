@@ -0,0 +1,77 @@
+#pragma once
+
+#include <cstddef>
+#include <unordered_map>
+#include <vector>
+#include "Orders.h"
+using namespace std;
+
+class Player;
+class Territory;
+class ThreadPool;
+
+// Executes the orders of an execute orders phase, given in the sequence the rules execute them in.
+//
+// Before anything runs, each order's footprint (the territories and players it may read or write) is worked out
+// from its operands and from who could own each territory by the time the order runs. An order depends on every
+// earlier order that writes something it touches or touches something it writes, which splits the sequence into
+// waves of orders with nothing in common. The waves run one after another, the orders of a wave side by side on
+// the pool. Whatever an order prints is buffered and replayed in sequence, and an order's battle is keyed by its
+// position in the sequence, so the board, the output and every battle are those of running the orders one by one.
+// A nullptr in the sequence (an order taken out by OrderCoalescer) is skipped but keeps its position.
+//
+// An order takes about a microsecond, about as long as handing it to a worker, so a wave only goes to the pool
+// when it has at least minParallelWave orders, split into one slice per worker. Smaller waves run on the calling
+// thread, and when no wave is wide enough (or the machine has a single hardware thread) the orders run one by one.
+class OrderExecutor {
+    public:
+        static const size_t DefaultMinParallelWave = 32;
+
+        // Without a pool the orders simply run one by one
+        explicit OrderExecutor(ThreadPool* pool = nullptr, size_t minParallelWave = defaultMinParallelWave());
+
+        // DefaultMinParallelWave, or a cutoff no wave reaches when there is a single hardware thread
+        static size_t defaultMinParallelWave();
+        size_t getMinParallelWave() const;
+
+        void execute(const vector<Order*>& sequence);
+
+        // Shape of the last dependency graph: how many waves it took and the most orders run side by side
+        // (one order per wave when they ran one by one)
+        size_t getWaveCount() const;
+        size_t getWidestWave() const;
+        // What validate() said about each order of the last sequence
+        const vector<OrderValidation>& getValidations() const;
+
+        // Validates the order once, then executes it (an invalid order records why it was rejected)
+        static OrderValidation run(Order* order);
+
+    private:
+        struct Footprint {
+            vector<const void*> reads;  // territories and players
+            vector<const void*> writes;
+        };
+
+        struct Access {
+            int lastWriter = -1;
+            vector<int> readers; // since the last writer
+        };
+
+        ThreadPool* pool;
+        size_t minParallelWave;
+        size_t waveCount;
+        size_t widestWave;
+        vector<OrderValidation> validations;
+        // Everyone who may own a territory once the orders so far have run (its owner to begin with, then any
+        // attacker; nullptr for a blockade or an unowned territory)
+        unordered_map<const Territory*, vector<Player*>> possibleOwners;
+
+        const vector<Player*>& ownersOf(const Territory* territory);
+        void addOwner(const Territory* territory, Player* owner);
+        void addOwners(const Territory* territory, Footprint& footprint);
+        // A change of owner rewrites the territory, its neighbours' border counts and the caches of every player
+        // owning something within two steps (frontier and attackable sets, army heaps)
+        void addOwnerChange(const Territory* territory, Footprint& footprint);
+        Footprint footprintOf(const Order* order);
+        vector<vector<int>> buildWaves(const vector<Order*>& sequence);
+};
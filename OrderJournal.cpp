@@ -0,0 +1,150 @@
+#include "OrderJournal.h"
+#include "Player.h"
+#include "Map.h"
+#include "PlayerStrategies.h"
+
+bool OrderJournal::isValid(OrderType type, const OrderOperands& operands) {
+    switch (type) {
+    case OrderType::Deploy:
+        return Deploy::check(operands.issuer, operands.target, operands.armies) == OrderValidation::Valid;
+    case OrderType::Advance:
+        return Advance::check(operands.issuer, operands.source, operands.target, operands.armies) == OrderValidation::Valid;
+    case OrderType::Bomb:
+        return Bomb::check(operands.issuer, operands.target) == OrderValidation::Valid;
+    case OrderType::Blockade:
+        return Blockade::check(operands.issuer, operands.target) == OrderValidation::Valid;
+    case OrderType::Airlift:
+        return Airlift::check(operands.issuer, operands.source, operands.target, operands.armies) == OrderValidation::Valid;
+    case OrderType::Negotiate:
+        return Negotiate::check(operands.issuer, operands.targetPlayer) == OrderValidation::Valid;
+    }
+    return false;
+}
+
+bool OrderJournal::apply(const Order& order) {
+    return apply(order.getType(), order.getOperands());
+}
+
+bool OrderJournal::apply(OrderType type, const OrderOperands& operands) {
+    if (!isValid(type, operands)) return false;
+
+    undone.clear(); // a new branch
+    applyStep(type, operands);
+    return true;
+}
+
+void OrderJournal::record(Territory* territory) {
+    Player* owner = territory->getOwner();
+    territoryLog.push_back(TerritoryRecord{ territory, owner, territory->getArmies(), owner ? territory->getOwnerIndex() : -1 });
+}
+
+void OrderJournal::recordTruce(Player* first, Player* second) {
+    if (!first->hasNegotiatedWith(second)) truceLog.push_back(TruceRecord{ first, second });
+}
+
+void OrderJournal::applyStep(OrderType type, const OrderOperands& operands) {
+    Step step{ type, operands, Advance::getBattleStream().getPosition(),
+               static_cast<uint32_t>(territoryLog.size()), static_cast<uint32_t>(truceLog.size()), nullptr };
+
+    // Attacking or bombing a Neutral player turns it Aggressive
+    Player* neutral = nullptr;
+    if (type == OrderType::Advance || type == OrderType::Bomb) {
+        Player* defender = operands.target->getOwner();
+        if (defender && defender != operands.issuer && defender->getPlayerStrategy()->getKind() == StrategyKind::Neutral) {
+            neutral = defender;
+        }
+    }
+
+    if (operands.source) record(operands.source);
+    if (operands.target) record(operands.target);
+
+    switch (type) {
+    case OrderType::Deploy:
+        Deploy::apply(operands.target, operands.armies);
+        break;
+    case OrderType::Advance:
+        Advance::apply(operands.issuer, operands.source, operands.target, operands.armies);
+        break;
+    case OrderType::Bomb:
+        Bomb::apply(operands.target);
+        break;
+    case OrderType::Blockade:
+        Blockade::apply(operands.issuer, operands.target);
+        break;
+    case OrderType::Airlift:
+        Airlift::apply(operands.source, operands.target, operands.armies);
+        break;
+    case OrderType::Negotiate:
+        recordTruce(operands.issuer, operands.targetPlayer);
+        recordTruce(operands.targetPlayer, operands.issuer);
+        Negotiate::apply(operands.issuer, operands.targetPlayer);
+        break;
+    }
+
+    if (neutral && neutral->getPlayerStrategy()->getKind() != StrategyKind::Neutral) step.calmed = neutral;
+    steps.push_back(step);
+}
+
+bool OrderJournal::undo() {
+    if (steps.empty()) return false;
+
+    Step step = steps.back();
+    steps.pop_back();
+
+    if (step.calmed) step.calmed->setPlayerStrategy(new NeutralPlayerStrategy(step.calmed));
+
+    for (size_t i = truceLog.size(); i > step.firstTruce; i--) {
+        const TruceRecord& truce = truceLog[i - 1];
+        truce.first->removeNegotiatedPlayer(truce.second);
+    }
+    truceLog.resize(step.firstTruce);
+
+    // Newest first, so a territory touched twice by one step ends up as it was before the step
+    for (size_t i = territoryLog.size(); i > step.firstTerritory; i--) {
+        const TerritoryRecord& before = territoryLog[i - 1];
+        Territory* territory = before.territory;
+        territory->setArmies(before.armies);
+
+        Player* current = territory->getOwner();
+        if (current != before.owner) {
+            if (current) current->removeTerritory(territory); // its last territory, so nothing else moves
+            territory->setOwner(before.owner);
+            if (before.owner) before.owner->restoreTerritory(territory, before.slot);
+        }
+    }
+    territoryLog.resize(step.firstTerritory);
+
+    Advance::getBattleStream().seek(step.battlePosition);
+    undone.push_back(step);
+    return true;
+}
+
+bool OrderJournal::redo() {
+    if (undone.empty()) return false;
+
+    Step step = undone.back();
+    undone.pop_back();
+
+    Advance::getBattleStream().seek(step.battlePosition);
+    applyStep(step.type, step.operands);
+    return true;
+}
+
+void OrderJournal::rollback(size_t depth) {
+    while (steps.size() > depth) undo();
+}
+
+size_t OrderJournal::depth() const {
+    return steps.size();
+}
+
+bool OrderJournal::canRedo() const {
+    return !undone.empty();
+}
+
+void OrderJournal::clear() {
+    steps.clear();
+    territoryLog.clear();
+    truceLog.clear();
+    undone.clear();
+}
@@ -0,0 +1,74 @@
+#pragma once
+
+#include "Orders.h"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+using namespace std;
+
+class Player;
+class Territory;
+
+// Applies orders to the live board so they can be taken back, for strategies that try an order, look at the
+// board and roll back instead of cloning the game.
+//
+// Each applied order leaves a step in an undo log: the owner, armies and slot in the owner's territory list of
+// every territory it touches (at most two), the truces it added and the Neutral player it turned Aggressive.
+// Undoing a step writes those back, so rolling back costs O(touched territories) plus their border bookkeeping.
+// Steps are undone last in first out: a conquered territory is always the last one its new owner gained, and a
+// territory that left its owner goes back to its old slot with removeTerritory's swap reversed, so territory lists
+// and army heaps are exactly as before. Frontier and attackable sets get the same members back, possibly in
+// another order.
+//
+// Orders are applied silently (validated, then the board changes; nothing printed, no observers notified). The
+// battle stream is rewound by undo and replayed by redo, so a battle tried during lookahead is the one the game
+// would fight, and a rolled back search leaves the game exactly where it was.
+class OrderJournal {
+    public:
+        // Validates and applies the order; invalid orders change nothing and are not journaled. Clears the redo list.
+        bool apply(const Order& order);
+        bool apply(OrderType type, const OrderOperands& operands);
+
+        bool undo(); // false when there is nothing to undo
+        bool redo(); // re-applies the last undone order with the same battle; false when there is nothing to redo
+        void rollback(size_t depth); // undoes steps until depth() == depth
+
+        size_t depth() const; // orders applied and not undone
+        bool canRedo() const;
+        void clear(); // forgets the history, keeping the board as it is
+
+        static bool isValid(OrderType type, const OrderOperands& operands);
+
+    private:
+        // A territory as it was before the step
+        struct TerritoryRecord {
+            Territory* territory;
+            Player* owner;
+            int armies;
+            int slot; // in the owner's territory list
+        };
+
+        // A truce the step added (first, second)
+        struct TruceRecord {
+            Player* first;
+            Player* second;
+        };
+
+        struct Step {
+            OrderType type;
+            OrderOperands operands;
+            uint64_t battlePosition; // of the battle stream before the order ran
+            uint32_t firstTerritory; // offsets into the logs below
+            uint32_t firstTruce;
+            Player* calmed; // a Neutral player the order turned Aggressive, nullptr when none
+        };
+
+        vector<Step> steps;
+        vector<TerritoryRecord> territoryLog;
+        vector<TruceRecord> truceLog;
+        vector<Step> undone; // redo list, last undone on top
+
+        void record(Territory* territory);
+        void recordTruce(Player* first, Player* second);
+        void applyStep(OrderType type, const OrderOperands& operands);
+};
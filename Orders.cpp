@@ -2,6 +2,7 @@
 
 #include "Orders.h"
 #include "LoggingObserver.h"   
+#include "ConsoleLog.h"
 #include <stdexcept>
 #include <iostream>
 #include <algorithm>
@@ -13,27 +14,72 @@ using namespace std;
 
 // Orders Base Class Implementation ----------------------------------------------------------------
 
-Order::Order() : name("Order"), executed(false), effect("None") {} // Default constructor
-Order::Order(const std::string& name) : name(name), executed(false), effect("None") {} // Parameterized constructor
+Order::Order() : executed(false), outcome() {} // Default constructor
 
-Order::Order(const Order& other) : name(other.name), executed(other.executed), effect(other.effect) {} // Copy constructor
+Order::Order(const Order& other) : executed(other.executed), outcome(other.outcome) {} // Copy constructor
 
 Order& Order::operator=(const Order& other) // Assignment operator
 {
     if (this != &other)
     {
-        name = other.name;
         executed = other.executed;
-        effect = other.effect;
+        outcome = other.outcome;
     }
     return *this;
 }
 
 Order::~Order() {} // Destructor
 
+const char* Order::getTypeName(OrderType type)
+{
+    switch (type)
+    {
+    case OrderType::Deploy: return "Deploy";
+    case OrderType::Advance: return "Advance";
+    case OrderType::Bomb: return "Bomb";
+    case OrderType::Blockade: return "Blockade";
+    case OrderType::Airlift: return "Airlift";
+    case OrderType::Negotiate: return "Negotiate";
+    }
+    return "Order";
+}
+
+void Order::print(std::ostream& os) const // Writes what toString() returns, without building the string
+{
+    os << "Order: " << getTypeName(getType()) << (executed ? " (executed)" : "") << ", Executed: " << (executed ? "Yes" : "No") << ", Effect: ";
+    printEffectOrNone(os);
+    printDetails(os);
+}
+
+const char* Order::getValidationText(OrderValidation validation)
+{
+    switch (validation)
+    {
+    case OrderValidation::Valid: return "valid";
+    case OrderValidation::MissingOperand: return "missing issuer, territory or player";
+    case OrderValidation::BadArmies: return "army count must be positive";
+    case OrderValidation::NotOwner: return "issuer does not own the territory";
+    case OrderValidation::TooFewArmies: return "too few armies in the source";
+    case OrderValidation::NotAdjacent: return "target is not adjacent";
+    case OrderValidation::Truce: return "truce with the target's owner";
+    case OrderValidation::SelfTarget: return "order targets its own source or issuer";
+    case OrderValidation::NotEnemy: return "target is not an enemy territory";
+    }
+    return "unknown";
+}
+
+void Order::printEffectOrNone(std::ostream& os) const
+{
+    if (outcome.code == OrderOutcomeCode::None) os << "None";
+    else if (outcome.code == OrderOutcomeCode::Invalid) os << getTypeName(getType()) << " invalid: " << getValidationText(outcome.rejection) << ".";
+    else printEffect(os);
+}
+
 std::string Order::toString() const // Converts order details to string
 {
-    return "Order: " + name + ", Executed: " + (executed ? "Yes" : "No") + ", Effect: " + effect;
+    std::ostringstream os;
+    print(os);
+    return os.str();
 }
 
 bool Order::isExecuted() const // Checks if order has been executed
@@ -41,14 +87,60 @@ bool Order::isExecuted() const // Checks if order has been executed
     return executed;
 }
 
-void Order::setEffect(const std::string& eff) // Sets the effect description
+OrderCheck::OrderCheck(const Order* order, OrderValidation result) : order(order), result(result) {}
+
+OrderValidation OrderCheck::getResult() const
+{
+    return result;
+}
+
+bool OrderCheck::isValid() const
+{
+    return result == OrderValidation::Valid;
+}
+
+const Order* OrderCheck::getOrder() const
+{
+    return order;
+}
+
+OrderCheck Order::validate() const
 {
-    this->effect = eff;
+    return OrderCheck(this, checkRules());
 }
 
-void Order::setName(const std::string& name) // Sets the name of the order
+void Order::execute()
 {
-    this->name = name;
+    execute(validate());
+}
+
+void Order::execute(const OrderCheck& check)
+{
+    if (check.getOrder() != this)
+    {
+        throw invalid_argument("Order executed with the check of another order");
+    }
+
+    if (!check.isValid())
+    {
+        record({ OrderOutcomeCode::Invalid, check.getResult(), 0 });
+        return;
+    }
+
+    perform();
+}
+
+void Order::record(const OrderOutcome& result) // Records the outcome of execute()
+{
+    outcome = result;
+    executed = result.code != OrderOutcomeCode::Invalid;
+
+    // Nothing is formatted unless it is going to be read
+    if (!ConsoleLog::isQuiet())
+    {
+        ConsoleLog::out() << *this << std::endl;
+    }
+    Notify(this);
 }
 
 void Order::setExecuted(bool executed) // Sets the executed status
@@ -56,31 +148,46 @@ void Order::setExecuted(bool executed) // Sets the executed status
     this->executed = executed;
 }
 
+const OrderOutcome& Order::getOutcome() const
+{
+    return outcome;
+}
+
 std::ostream& operator<<(std::ostream& os, const Order& order) // Stream insertion operator
 {
-    os << order.toString();
+    order.print(os);
     if (order.executed)
     {
-        os << " Effect: " << order.effect;
+        os << " Effect: ";
+        order.printEffectOrNone(os);
     }
 
     return os;
 };
 
 std::string Order::stringToLog() const {
-    return "Order: " + name + " | Executed: " + (executed ? "Yes" : "No") + " | Effect: " + effect;
+    std::ostringstream os;
+    os << "Order: " << getName() << " | Executed: " << (executed ? "Yes" : "No") << " | Effect: ";
+    printEffectOrNone(os);
+    return os.str();
 }
 
 string Order::getName() const {
-    return name;
+    return string(getTypeName(getType())) + (executed ? " (executed)" : "");
+}
+
+string Order::getEffect() const {
+    std::ostringstream os;
+    printEffectOrNone(os);
+    return os.str();
 }
 
 // Deploy Class Implementation ---------------------------------------------------------------------
 
-Deploy::Deploy() : Order("Deploy"), issuer(nullptr), target(nullptr), armies(0) {} // Default constructor
+Deploy::Deploy() : Order(), issuer(nullptr), target(nullptr), armies(0) {} // Default constructor
 
 Deploy::Deploy(Player* issuer, Territory* target, int armies)
-    : Order("Deploy"), issuer(issuer), target(target), armies(armies) {
+    : Order(), issuer(issuer), target(target), armies(armies) {
 }; // Parameterized constructor
 
 Deploy::Deploy(const Deploy& other)
@@ -101,31 +208,39 @@ Deploy& Deploy::operator=(const Deploy& other) // Assignment operator
 
 Deploy::~Deploy() {} // Destructor
 
-bool Deploy::validate() const // Validates the Deploy order
+OrderValidation Deploy::checkRules() const // Validates the Deploy order
 {
-    if (!(issuer && target) || armies <= 0)
-        return false;
+    return check(issuer, target, armies);
+}
+
+OrderValidation Deploy::check(Player* issuer, Territory* target, int armies)
+{
+    if (!(issuer && target))
+        return OrderValidation::MissingOperand;
+    if (armies <= 0)
+        return OrderValidation::BadArmies;
 
     // must deploy on your own territory
-    return (target->getOwner() == issuer);
+    if (target->getOwner() != issuer)
+        return OrderValidation::NotOwner;
+
+    return OrderValidation::Valid;
 }
 
-void Deploy::execute() // Executes the Deploy order
+void Deploy::apply(Territory* target, int armies)
 {
-    if (!validate()) {
-        setEffect("Deploy invalid (must own target / bad armies).");
-        setExecuted(false);
-        std::cout << *this << std::endl;
-        Notify(this); 
-        return;
-    }
-
     target->setArmies(target->getArmies() + armies);
-    setEffect("deployed " + std::to_string(armies) + " to " + target->getName());
-    setName("Deploy (executed)");
-    setExecuted(true);
-    std::cout << *this << std::endl;
-    Notify(this); 
+}
+
+void Deploy::setArmies(int armies)
+{
+    this->armies = armies;
+}
+
+void Deploy::perform() // Executes the Deploy order
+{
+    apply(target, armies);
+    record({ OrderOutcomeCode::Deployed, OrderValidation::Valid, armies });
 }
 
 Order* Deploy::clone() const // Virtual constructor
@@ -133,10 +248,24 @@ Order* Deploy::clone() const // Virtual constructor
     return new Deploy(*this);
 }
 
-std::string Deploy::toString() const //Converts Deploy order details to string
+OrderType Deploy::getType() const
 {
-    return Order::toString() + ", Issuer: " + (issuer ? issuer->getName() : "None") +
-", Target: " + (target ? target->getName() : "None") + ", Armies: " + to_string(armies);
+    return OrderType::Deploy;
+}
+
+OrderOperands Deploy::getOperands() const
+{
+    return OrderOperands{ issuer, nullptr, target, nullptr, armies };
+}
+
+void Deploy::printDetails(std::ostream& os) const // Issuer, target and armies
+{
+    os << ", Issuer: " << (issuer ? issuer->getName() : "None") << ", Target: " << (target ? target->getName() : "None") << ", Armies: " << armies;
+}
+
+void Deploy::printEffect(std::ostream& os) const
+{
+    os << "deployed " << getOutcome().armies << " to " << target->getName();
 }
 
 std::ostream& operator<<(std::ostream& os, const Deploy& order)    
@@ -146,10 +275,10 @@ std::ostream& operator<<(std::ostream& os, const Deploy& order)
 
 // Advance Class Implementation --------------------------------------------------------------------
 
-Advance::Advance() : Order("Advance"), issuer(nullptr), source(nullptr), target(nullptr), armies(0) {} // Default constructor
+Advance::Advance() : Order(), issuer(nullptr), source(nullptr), target(nullptr), armies(0) {} // Default constructor
 
 Advance::Advance(Player* issuer, Territory* source, Territory* target, int armies)
-    : Order("Advance"), issuer(issuer), source(source), target(target), armies(armies) {
+    : Order(), issuer(issuer), source(source), target(target), armies(armies) {
 } // Parameterized constructor
 
 Advance::Advance(const Advance& other)
@@ -171,87 +300,109 @@ Advance& Advance::operator=(const Advance& other) // Assignment operator
 
 Advance::~Advance() {} // Destructor
 
-bool Advance::validate() const // Validates the Advance order
+OrderValidation Advance::checkRules() const // Validates the Advance order
 {
-    if (!(issuer && source && target) || source == target || armies <= 0)
-        return false;
+    return check(issuer, source, target, armies);
+}
+
+OrderValidation Advance::check(Player* issuer, Territory* source, Territory* target, int armies)
+{
+    if (!(issuer && source && target))
+        return OrderValidation::MissingOperand;
+    if (source == target)
+        return OrderValidation::SelfTarget;
+    if (armies <= 0)
+        return OrderValidation::BadArmies;
 
     // must own the source territory
     if (source->getOwner() != issuer)
-        return false;
+        return OrderValidation::NotOwner;
 
     // must have enough armies in source
     if (source->getArmies() < armies)
-        return false;
+        return OrderValidation::TooFewArmies;
 
     // must be adjacent
     if (!source->isAdjacentTo(target))
-        return false;
+        return OrderValidation::NotAdjacent;
     
     // If target is enemy and there is a truce, this attack is invalid
     Player* defender = target->getOwner();
     if (defender && defender != issuer) {
         // Either direction counts, but we store symmetric truces anyway
         if (issuer->hasNegotiatedWith(defender) || defender->hasNegotiatedWith(issuer)) {
-            return false; // attack invalid due to Negotiate
+            return OrderValidation::Truce; // attack invalid due to Negotiate
         }
     }
 
-    return true;
+    return OrderValidation::Valid;
 }
 
-void Advance::execute() // Executes the Advance order
+// Battle randomness, seeded through Advance::seedBattles (per thread, so games played side by side stay independent)
+static thread_local BattleStream battleStream;
+static thread_local bool battleStreamSeeded = false;
+
+void Advance::seedBattles(unsigned int seed)
 {
-    if (!validate()) {
-        setEffect("Advance invalid (ownership/armies/adjacency).");
-        setExecuted(false);
-        std::cout << *this << std::endl;
-        Notify(this);
+    battleStream.seed(seed);
+    battleStreamSeeded = true;
+}
+
+BattleStream& Advance::getBattleStream()
+{
+    if (!battleStreamSeeded) {
+        std::random_device rd;
+        battleStream.seed((static_cast<uint64_t>(rd()) << 32) | rd());
+        battleStreamSeeded = true;
+    }
+    return battleStream;
+}
+
+void Advance::perform() // Executes the Advance order
+{
+    // Friendly move (same owner)
+    if (target->getOwner() == issuer) {
+        apply(issuer, source, target, armies);
+        record({ OrderOutcomeCode::Moved, OrderValidation::Valid, armies });
         return;
     }
 
+    // Hostile move — battle simulation
+    BattleResult battle = apply(issuer, source, target, armies);
+
+    if (battle.conquered) {
+        record({ OrderOutcomeCode::Conquered, OrderValidation::Valid, battle.attackersLeft });
+    }
+    else {
+        record({ OrderOutcomeCode::Repelled, OrderValidation::Valid, battle.defendersLeft });
+    }
+}
+
+BattleResult Advance::apply(Player* issuer, Territory* source, Territory* target, int armies)
+{
     Player* defender = target->getOwner();
 
     // Friendly move (same owner)
     if (defender == issuer) {
         source->setArmies(source->getArmies() - armies);
         target->setArmies(target->getArmies() + armies);
-        setEffect("moved " + std::to_string(armies) + " from " + source->getName() + " to " + target->getName());
-        setName("Advance (executed)");
-        setExecuted(true);
-        std::cout << *this << std::endl;
-        Notify(this);
-        return;
+        return BattleResult{ armies, 0, false };
     }
 
-    // Hostile move — battle simulation
-    int atkSent = armies;
-    source->setArmies(source->getArmies() - atkSent);
-
-    int atk = atkSent;
-    int def = target->getArmies();
-
-    std::random_device rd; // Generate random numbers
-    std::mt19937 gen(rd()); // Mersenne Twister RNG
-    std::binomial_distribution<int> atkKillsDist(atk, 0.60); // Attacker kills 60% of defending armies
-    std::binomial_distribution<int> defKillsDist(def, 0.70); // Defender kills 70% of attacking armies
-
-    int atkKills = atkKillsDist(gen);
-    int defKills = defKillsDist(gen);
+    source->setArmies(source->getArmies() - armies);
 
-    int defAfter = std::max(0, def - atkKills);
-    int atkAfter = std::max(0, atk - defKills);
+    BattleResult battle = getBattleStream().resolve(armies, target->getArmies());
 
     if (defender != NULL)
     {
-        if (defender->getPlayerStrategy()->getStrategyString() == "Neutral") {
+        if (defender->getPlayerStrategy()->getKind() == StrategyKind::Neutral) {
             defender->setPlayerStrategy(new AggressivePlayerStrategy(defender));
         }
     }
 
-    if (defAfter == 0 && atkAfter > 0) {
+    if (battle.conquered) {
         // conquer: survivors occupy, transfer ownership
-        target->setArmies(atkAfter);
+        target->setArmies(battle.attackersLeft);
 
         if (defender != NULL)
         {
@@ -260,18 +411,13 @@ void Advance::execute() // Executes the Advance order
 
         target->setOwner(issuer);
         issuer->addTerritory(target);
-        setEffect("attacked " + target->getName() + ": conquered with " + std::to_string(atkAfter) + " surviving.");
     }
     else {
         // defender holds
-        target->setArmies(defAfter);
-        setEffect("attacked " + target->getName() + ": failed (def " + std::to_string(defAfter) + " left).");
+        target->setArmies(battle.defendersLeft);
     }
 
-    setName("Advance (executed)");
-    setExecuted(true);
-    std::cout << *this << std::endl;
-    Notify(this);
+    return battle;
 }
 
 Order* Advance::clone() const // Virtual constructor
@@ -279,12 +425,40 @@ Order* Advance::clone() const // Virtual constructor
     return new Advance(*this);
 }
 
-std::string Advance::toString() const // Converts Advance order details to string
+OrderType Advance::getType() const
 {
-    return Order::toString() + ", Issuer: " + (issuer ? issuer->getName() : "None") +
-        ", Source: " + (source ? source->getName() : "None") +
-        ", Target: " + (target ? target->getName() : "None") +
-        ", Armies: " + to_string(armies);
+    return OrderType::Advance;
+}
+
+OrderOperands Advance::getOperands() const
+{
+    return OrderOperands{ issuer, source, target, nullptr, armies };
+}
+
+void Advance::printDetails(std::ostream& os) const // Issuer, source, target and armies
+{
+    os << ", Issuer: " << (issuer ? issuer->getName() : "None")
+        << ", Source: " << (source ? source->getName() : "None")
+        << ", Target: " << (target ? target->getName() : "None")
+        << ", Armies: " << armies;
+}
+
+void Advance::printEffect(std::ostream& os) const
+{
+    const OrderOutcome& outcome = getOutcome();
+    switch (outcome.code) {
+    case OrderOutcomeCode::Moved:
+        os << "moved " << outcome.armies << " from " << source->getName() << " to " << target->getName();
+        break;
+    case OrderOutcomeCode::Conquered:
+        os << "attacked " << target->getName() << ": conquered with " << outcome.armies << " surviving.";
+        break;
+    case OrderOutcomeCode::Repelled:
+        os << "attacked " << target->getName() << ": failed (def " << outcome.armies << " left).";
+        break;
+    default:
+        break;
+    }
 }
 
 std::ostream& operator<<(std::ostream& os, const Advance& order) 
@@ -292,6 +466,13 @@ std::ostream& operator<<(std::ostream& os, const Advance& order)
     return os << static_cast<const Order&>(order); 
 }
 
+BattleResult Advance::resolveBattle(int attackers, int defenders, std::mt19937& gen)
+{
+    uint64_t key = static_cast<uint64_t>(gen()) << 32;
+    key |= gen(); // mt19937 output itself is the same everywhere
+    return BattleKernel::resolve(attackers, defenders, key, 0);
+}
+
 Territory* Advance::getSource() const
 {
     return source;
@@ -302,12 +483,17 @@ Territory* Advance::getTarget() const
 	return target;
 }
 
+void Advance::setArmies(int armies)
+{
+    this->armies = armies;
+}
+
 // Bomb Class Implementation -----------------------------------------------------------------------
 
-Bomb::Bomb() : Order("Bomb"), issuer(nullptr), target(nullptr) {} // Default constructor
+Bomb::Bomb() : Order(), issuer(nullptr), target(nullptr) {} // Default constructor
 
 Bomb::Bomb(Player* issuer, Territory* target)
-    : Order("Bomb"), issuer(issuer), target(target) {
+    : Order(), issuer(issuer), target(target) {
 } // Parameterized constructor
 
 Bomb::Bomb(const Bomb& other)
@@ -327,18 +513,23 @@ Bomb& Bomb::operator=(const Bomb& other) // Assignment operator
 
 Bomb::~Bomb() {} // Destructor
 
-bool Bomb::validate() const // Validates the Bomb order
+OrderValidation Bomb::checkRules() const // Validates the Bomb order
+{
+    return check(issuer, target);
+}
+
+OrderValidation Bomb::check(Player* issuer, Territory* target)
 {
     if (!(issuer && target))
-        return false;
+        return OrderValidation::MissingOperand;
 
     Player* tgtOwner = target->getOwner();
     if (!tgtOwner || tgtOwner == issuer)
-        return false; // must target an enemy
+        return OrderValidation::NotEnemy; // must target an enemy
 
     // If there is a truce, bombing that player is not allowed
     if (issuer->hasNegotiatedWith(tgtOwner) || tgtOwner->hasNegotiatedWith(issuer)) {
-        return false; // invalid due to Negotiate
+        return OrderValidation::Truce; // invalid due to Negotiate
     }
 
     // must be adjacent to at least one issuer-owned territory
@@ -350,34 +541,27 @@ bool Bomb::validate() const // Validates the Bomb order
         }
     }
     if (!adjacentToIssuer)
-        return false;
+        return OrderValidation::NotAdjacent;
 
-    return true;
+    return OrderValidation::Valid;
 }
 
-void Bomb::execute() // Executes the Bomb order
+void Bomb::perform() // Executes the Bomb order
 {
-    if (!validate()) {
-        setEffect("Bomb invalid (must target adjacent enemy).");
-        setExecuted(false);
-        std::cout << *this << std::endl;
-        Notify(this);
-        return;
-    }
+    record({ OrderOutcomeCode::Bombed, OrderValidation::Valid, apply(target) });
+}
 
+int Bomb::apply(Territory* target)
+{
     int cur = target->getArmies();
     int removed = cur / 2; // remove half (floor)
     target->setArmies(cur - removed);
 
-    if (target->getOwner()->getPlayerStrategy()->getStrategyString() == "Neutral") {
+    if (target->getOwner()->getPlayerStrategy()->getKind() == StrategyKind::Neutral) {
         target->getOwner()->setPlayerStrategy(new AggressivePlayerStrategy(target->getOwner()));
     }
 
-    setEffect("bombed " + target->getName() + " removing " + std::to_string(removed));
-    setName("Bomb (executed)");
-    setExecuted(true);
-    std::cout << *this << std::endl;
-    Notify(this);
+    return removed;
 }
 
 Order* Bomb::clone() const // Virtual constructor
@@ -385,10 +569,24 @@ Order* Bomb::clone() const // Virtual constructor
     return new Bomb(*this);
 }
 
-std::string Bomb::toString() const // Converts Bomb order details to string
+OrderType Bomb::getType() const
+{
+    return OrderType::Bomb;
+}
+
+OrderOperands Bomb::getOperands() const
+{
+    return OrderOperands{ issuer, nullptr, target, nullptr, 0 };
+}
+
+void Bomb::printDetails(std::ostream& os) const // Issuer and target
+{
+    os << ", Issuer: " << (issuer ? issuer->getName() : "None") << ", Target: " << (target ? target->getName() : "None");
+}
+
+void Bomb::printEffect(std::ostream& os) const
 {
-    return Order::toString() + ", Issuer: " + (issuer ? issuer->getName() : "None") +
-        ", Target: " + (target ? target->getName() : "None");
+    os << "bombed " << target->getName() << " removing " << getOutcome().armies;
 }
 
 std::ostream& operator<<(std::ostream& os, const Bomb& order) 
@@ -398,10 +596,10 @@ std::ostream& operator<<(std::ostream& os, const Bomb& order)
 
 // Blockade Class Implementation -------------------------------------------------------------------
 
-Blockade::Blockade() : Order("Blockade"), issuer(nullptr), target(nullptr) {} // Default constructor
+Blockade::Blockade() : Order(), issuer(nullptr), target(nullptr) {} // Default constructor
 
 Blockade::Blockade(Player* issuer, Territory* target)
-    : Order("Blockade"), issuer(issuer), target(target) {
+    : Order(), issuer(issuer), target(target) {
 } // Parameterized constructor
 
 Blockade::Blockade(const Blockade& other)
@@ -421,32 +619,31 @@ Blockade& Blockade::operator=(const Blockade& other) // Assignment operator
 
 Blockade::~Blockade() {} // Destructor
 
-bool Blockade::validate() const // Validates the Blockade order
+OrderValidation Blockade::checkRules() const // Validates the Blockade order
 {
-    if (!(issuer && target))
-        return false;
-    return (target->getOwner() == issuer);
+    return check(issuer, target);
 }
 
-void Blockade::execute() // Executes the Blockade order
+OrderValidation Blockade::check(Player* issuer, Territory* target)
 {
-    if (!validate()) {
-        setEffect("Blockade invalid (must target own territory).");
-        setExecuted(false);
-        std::cout << *this << std::endl;
-        Notify(this);
-        return;
-    }
+    if (!(issuer && target))
+        return OrderValidation::MissingOperand;
+    if (target->getOwner() != issuer)
+        return OrderValidation::NotOwner;
+    return OrderValidation::Valid;
+}
 
+void Blockade::apply(Player* issuer, Territory* target)
+{
     target->setArmies(target->getArmies() * 2);
     target->setOwner(nullptr); // neutral player placeholder
     issuer->removeTerritory(target);
+}
 
-    setEffect("blockaded " + target->getName() + " (doubled, transferred to Neutral)");
-    setName("Blockade (executed)");
-    setExecuted(true);
-    std::cout << *this << std::endl;
-    Notify(this);
+void Blockade::perform() // Executes the Blockade order
+{
+    apply(issuer, target);
+    record({ OrderOutcomeCode::Blockaded, OrderValidation::Valid, target->getArmies() });
 }
 
 Order* Blockade::clone() const // Virtual constructor
@@ -454,10 +651,24 @@ Order* Blockade::clone() const // Virtual constructor
     return new Blockade(*this);
 }
 
-std::string Blockade::toString() const // Converts Blockade order details to string
+OrderType Blockade::getType() const
+{
+    return OrderType::Blockade;
+}
+
+OrderOperands Blockade::getOperands() const
 {
-    return Order::toString() + ", Issuer: " + (issuer ? issuer->getName() : "None") +
-        ", Target: " + (target ? target->getName() : "None");
+    return OrderOperands{ issuer, nullptr, target, nullptr, 0 };
+}
+
+void Blockade::printDetails(std::ostream& os) const // Issuer and target
+{
+    os << ", Issuer: " << (issuer ? issuer->getName() : "None") << ", Target: " << (target ? target->getName() : "None");
+}
+
+void Blockade::printEffect(std::ostream& os) const
+{
+    os << "blockaded " << target->getName() << " (doubled, transferred to Neutral)";
 }
 
 std::ostream& operator<<(std::ostream& os, const Blockade& order) 
@@ -467,10 +678,10 @@ std::ostream& operator<<(std::ostream& os, const Blockade& order)
 
 // Airlift Class Implementation --------------------------------------------------------------------
 
-Airlift::Airlift() : Order("Airlift"), issuer(nullptr), source(nullptr), target(nullptr), armies(0) {} // Default constructor
+Airlift::Airlift() : Order(), issuer(nullptr), source(nullptr), target(nullptr), armies(0) {} // Default constructor
 
 Airlift::Airlift(Player* issuer, Territory* source, Territory* target, int armies)
-    : Order("Airlift"), issuer(issuer), source(source), target(target), armies(armies) {
+    : Order(), issuer(issuer), source(source), target(target), armies(armies) {
 } // Parameterized constructor
 
 Airlift::Airlift(const Airlift& other)
@@ -492,39 +703,40 @@ Airlift& Airlift::operator=(const Airlift& other) // Assignment operator
 
 Airlift::~Airlift() {} // Destructor
 
-bool Airlift::validate() const // Validates the Airlift order
+OrderValidation Airlift::checkRules() const // Validates the Airlift order
 {
-    if (!(issuer && source && target) || source == target || armies <= 0)
-        return false;
+    return check(issuer, source, target, armies);
+}
+
+OrderValidation Airlift::check(Player* issuer, Territory* source, Territory* target, int armies)
+{
+    if (!(issuer && source && target))
+        return OrderValidation::MissingOperand;
+    if (source == target)
+        return OrderValidation::SelfTarget;
+    if (armies <= 0)
+        return OrderValidation::BadArmies;
 
     // must own both territories
     if (source->getOwner() != issuer || target->getOwner() != issuer)
-        return false;
+        return OrderValidation::NotOwner;
 
     if (source->getArmies() < armies)
-        return false;
+        return OrderValidation::TooFewArmies;
 
-    return true;
+    return OrderValidation::Valid;
 }
 
-void Airlift::execute()
+void Airlift::perform()
 {
-    if (!validate()) {
-        setEffect("Airlift invalid (ownership/armies).");
-        setExecuted(false);
-        std::cout << *this << std::endl;
-        Notify(this);
-        return;
-    }
+    apply(source, target, armies);
+    record({ OrderOutcomeCode::Airlifted, OrderValidation::Valid, armies });
+}
 
+void Airlift::apply(Territory* source, Territory* target, int armies)
+{
     source->setArmies(source->getArmies() - armies);
     target->setArmies(target->getArmies() + armies);
-
-    setEffect("airlifted " + std::to_string(armies) + " from " + source->getName() + " to " + target->getName());
-    setName("Airlift (executed)");
-    setExecuted(true);
-    std::cout << *this << std::endl;
-    Notify(this);
 }
 
 Order* Airlift::clone() const // Virtual constructor
@@ -532,12 +744,27 @@ Order* Airlift::clone() const // Virtual constructor
     return new Airlift(*this);
 }
 
-std::string Airlift::toString() const // Converts Airlift order details to string
+OrderType Airlift::getType() const
 {
-    return Order::toString() + ", Issuer: " + (issuer ? issuer->getName() : "None") +
-        ", Source: " + (source ? source->getName() : "None") +
-        ", Target: " + (target ? target->getName() : "None") +
-        ", Armies: " + to_string(armies);
+    return OrderType::Airlift;
+}
+
+OrderOperands Airlift::getOperands() const
+{
+    return OrderOperands{ issuer, source, target, nullptr, armies };
+}
+
+void Airlift::printDetails(std::ostream& os) const // Issuer, source, target and armies
+{
+    os << ", Issuer: " << (issuer ? issuer->getName() : "None")
+        << ", Source: " << (source ? source->getName() : "None")
+        << ", Target: " << (target ? target->getName() : "None")
+        << ", Armies: " << armies;
+}
+
+void Airlift::printEffect(std::ostream& os) const
+{
+    os << "airlifted " << getOutcome().armies << " from " << source->getName() << " to " << target->getName();
 }
 
 std::ostream& operator<<(std::ostream& os, const Airlift& order) 
@@ -547,10 +774,10 @@ std::ostream& operator<<(std::ostream& os, const Airlift& order)
 
 // Negotiate Class Implementation --------------------------------------------------------------------
 
-Negotiate::Negotiate() : Order("Negotiate"), issuer(nullptr), targetPlayer(nullptr) {} // Default constructor
+Negotiate::Negotiate() : Order(), issuer(nullptr), targetPlayer(nullptr) {} // Default constructor
 
 Negotiate::Negotiate(Player* issuer, Player* targetPlayer)
-    : Order("Negotiate"), issuer(issuer), targetPlayer(targetPlayer) {
+    : Order(), issuer(issuer), targetPlayer(targetPlayer) {
 } // Parameterized constructor
 
 Negotiate::Negotiate(const Negotiate& other)
@@ -570,31 +797,31 @@ Negotiate& Negotiate::operator=(const Negotiate& other) // Assignment operator
 
 Negotiate::~Negotiate() {} // Destructor
 
-bool Negotiate::validate() const // Validates the Negotiate order
+OrderValidation Negotiate::checkRules() const // Validates the Negotiate order
 {
-    return issuer && targetPlayer && (issuer != targetPlayer);
+    return check(issuer, targetPlayer);
 }
 
-void Negotiate::execute() // Executes the Negotiate order
+OrderValidation Negotiate::check(Player* issuer, Player* targetPlayer)
 {
-    if (!validate())
-    {
-        setEffect("Negotiate order execution failed: Invalid order.");
-        setExecuted(false);
-        cout << *this << endl;
-        Notify(this);
-        return;
-    }
+    if (!(issuer && targetPlayer))
+        return OrderValidation::MissingOperand;
+    if (issuer == targetPlayer)
+        return OrderValidation::SelfTarget;
+    return OrderValidation::Valid;
+}
 
+void Negotiate::apply(Player* issuer, Player* targetPlayer)
+{
     // Register a mutual truce for this turn
     issuer->addNegotiatedPlayer(targetPlayer);
     targetPlayer->addNegotiatedPlayer(issuer);
+}
 
-    setEffect("negotiated temporary peace with " + targetPlayer->getName());
-    setName("Negotiate (executed)");
-    setExecuted(true);
-    cout << *this << endl;
-    Notify(this);
+void Negotiate::perform() // Executes the Negotiate order
+{
+    apply(issuer, targetPlayer);
+    record({ OrderOutcomeCode::Negotiated, OrderValidation::Valid, 0 });
 }
 
 Order* Negotiate::clone() const // Virtual constructor
@@ -602,10 +829,24 @@ Order* Negotiate::clone() const // Virtual constructor
     return new Negotiate(*this);
 }
 
-std::string Negotiate::toString() const // Converts Negotiate order details to string
+OrderType Negotiate::getType() const
+{
+    return OrderType::Negotiate;
+}
+
+OrderOperands Negotiate::getOperands() const
 {
-    return Order::toString() + ", Issuer: " + (issuer ? issuer->getName() : "None") +
-        ", Target Player: " + (targetPlayer ? targetPlayer->getName() : "None");
+    return OrderOperands{ issuer, nullptr, nullptr, targetPlayer, 0 };
+}
+
+void Negotiate::printDetails(std::ostream& os) const // Issuer and target player
+{
+    os << ", Issuer: " << (issuer ? issuer->getName() : "None") << ", Target Player: " << (targetPlayer ? targetPlayer->getName() : "None");
+}
+
+void Negotiate::printEffect(std::ostream& os) const
+{
+    os << "negotiated temporary peace with " << targetPlayer->getName();
 }
 
 std::ostream& operator<<(std::ostream& os, const Negotiate& order) 
@@ -643,13 +884,25 @@ void OrdersList::add(const Order& order) // Adds an order to the list (by refere
     Notify(this); 
 }
 
-void OrdersList::add(Order* order) // Adds an order to the list (by pointer)
+void OrdersList::add(Order* order) // Adds an order to the list (by pointer), taking ownership
 {
     if (!order) throw std::invalid_argument("Cannot add null order");
-    orders.push_back(order->clone());
+    orders.push_back(order);
     Notify(this); 
 }
 
+void OrdersList::add(std::vector<std::unique_ptr<Order>>&& batch) // Adds a batch of orders, taking ownership
+{
+    if (batch.empty()) return;
+    orders.reserve(orders.size() + batch.size());
+    for (std::unique_ptr<Order>& order : batch)
+    {
+        if (order) orders.push_back(order.release());
+    }
+    batch.clear();
+    Notify(this);
+}
+
 void OrdersList::remove(int index) // Removes an order from the list by index
 {
     if(index < 0 || index >= orders.size())
@@ -3,8 +3,12 @@
 #include <string>
 #include <vector>
 #include <iostream>
+#include <random>
+#include <memory>
+#include <cstdint>
 #include "Player.h"
 #include "Map.h"
+#include "BattleKernel.h"
 #include "LoggingObserver.h"   
 
 using namespace std;
@@ -15,28 +19,110 @@ class Card;
 class Player;
 class Territory;
 
+// Kind of an order, so code can dispatch on it without comparing names or casting
+enum class OrderType : uint8_t
+{
+    Deploy,
+    Advance,
+    Bomb,
+    Blockade,
+    Airlift,
+    Negotiate
+};
+
+// What executing an order did, kept as a code and a number; the text is only formatted when something reads it
+enum class OrderOutcomeCode : uint8_t
+{
+    None,       // not executed yet
+    Invalid,    // failed validation when executed
+    Deployed,
+    Moved,
+    Conquered,
+    Repelled,
+    Bombed,
+    Blockaded,
+    Airlifted,
+    Negotiated
+};
+
+// Why validate() rejected an order, or Valid
+enum class OrderValidation : uint8_t
+{
+    Valid,
+    MissingOperand, // no issuer, territory or target player
+    BadArmies,      // zero or negative armies ordered
+    NotOwner,       // the issuer does not own a territory it must own
+    TooFewArmies,   // the source holds fewer armies than ordered
+    NotAdjacent,    // the target borders neither the source nor (for a bomb) any territory of the issuer
+    Truce,          // the target's owner negotiated with the issuer this turn
+    SelfTarget,     // source and target are the same territory, or the issuer negotiates with itself
+    NotEnemy        // a bomb on an unowned territory or on one of the issuer's own
+};
+
+const int OrderValidationCount = 9;
+
+struct OrderOutcome
+{
+    OrderOutcomeCode code = OrderOutcomeCode::None;
+    OrderValidation rejection = OrderValidation::Valid; // why an Invalid order was rejected
+    int armies = 0; // armies deployed, moved, airlifted or bombed away; attackers left after a conquest; defenders left after a failed attack
+};
+
+class Order;
+
+// What validate() said about one order. Only validate() can make one, so execute() cannot be handed a
+// verdict the rules never gave, nor the verdict on another order.
+class OrderCheck
+{
+public:
+    OrderValidation getResult() const;
+    bool isValid() const;
+    const Order* getOrder() const;
+
+private:
+    friend class Order;
+    OrderCheck(const Order* order, OrderValidation result);
+
+    const Order* order;
+    OrderValidation result;
+};
+
 // Orders Class ---------------------------------------------------------------------------------------------
 
 /*
 Base Order class representing a generic order in the game.
-- validate() and execute() are virtual functions to be implemented by derived classes.
+- validate() checks the rules of the derived class (checkRules()) and returns an OrderCheck; execute(check) takes
+  it so the rules are checked once, and perform() applies an order known to be valid.
 - clone() is a virtual function to create a copy of the order.
+- execute() records an OrderOutcome; names, effects and descriptions are formatted only when printed or logged.
 */
 
+// The players, territories and armies an order names (nullptr or 0 where it names none)
+struct OrderOperands
+{
+    Player* issuer;
+    Territory* source;
+    Territory* target;
+    Player* targetPlayer; // Negotiate only
+    int armies;
+};
+
 class Order : public Subject, public ILoggable   
 {
 public:
     Order(); // Default constructor
-    Order(const std::string& name); // Parameterized constructor
     Order(const Order& other); // Copy constructor
     Order& operator=(const Order& other); // Assignment operator
     virtual ~Order(); // Destructor
 
-    virtual bool validate() const = 0;    // Verify if order is valid
-    virtual void execute() = 0;   // Execute the order
+    OrderCheck validate() const; // Valid, or the reason the order cannot execute now
+    void execute(); // Validates, then executes the order
+    void execute(const OrderCheck& check); // Executes with what validate() said just before, without checking again
 
     virtual Order* clone() const = 0; // Virtual constructor
-    virtual std::string toString() const;
+    std::string toString() const;
+    virtual OrderType getType() const = 0;
+    virtual OrderOperands getOperands() const = 0;
 
     bool isExecuted() const; // Verify if order has been executed
 
@@ -46,17 +132,29 @@ public:
    
     std::string stringToLog() const override;
 
-    string getName() const;
+    string getName() const; // Type name, followed by " (executed)" once executed
+    string getEffect() const; // Effect description of the recorded outcome
+    const OrderOutcome& getOutcome() const;
+
+    static const char* getTypeName(OrderType type);
+    static const char* getValidationText(OrderValidation validation);
 
 protected:
-    void setEffect(const std::string& effect); // Set the effect description of the order
-    void setName(const std::string& name); // Set the name of the order
-    
+    virtual OrderValidation checkRules() const = 0; // The rules of the order type, run by validate()
+    virtual void perform() = 0; // Applies a valid order and records its outcome
+
+    // Records what execute() did, then prints and notifies only when someone is listening
+    void record(const OrderOutcome& outcome);
+
+    virtual void printDetails(std::ostream& os) const = 0; // Issuer, territories and armies, as appended to toString()
+    virtual void printEffect(std::ostream& os) const = 0; // Effect text of the recorded outcome
 
 private:
-    std::string name;
+    void print(std::ostream& os) const;
+    void printEffectOrNone(std::ostream& os) const;
+
     bool executed;
-    std::string effect;
+    OrderOutcome outcome;
 };
 
 // DERIVED ORDER CLASSES ----------------------------------------------------------------------------------------
@@ -72,14 +170,24 @@ public:
     Deploy& operator=(const Deploy& other); // Assignment operator
     ~Deploy(); // Destructor
 
-    bool validate() const override; 
-    void execute() override;
-
     Order* clone() const override;
-    std::string toString() const override;
+    OrderType getType() const override;
+    OrderOperands getOperands() const override;
 
     friend std::ostream& operator<<(std::ostream& os, const Deploy& order); // Stream insertion operator
 
+    // Rules shared with compact orders (CompactOrders.h)
+    static OrderValidation check(Player* issuer, Territory* target, int armies);
+    static void apply(Territory* target, int armies);
+
+    void setArmies(int armies); // e.g. when later deploys to the same territory are merged into this one
+
+protected:
+    OrderValidation checkRules() const override;
+    void perform() override;
+    void printDetails(std::ostream& os) const override;
+    void printEffect(std::ostream& os) const override;
+
 private:
     Player* issuer; // Player issuing the order
     Territory* target; // Target territory
@@ -97,16 +205,35 @@ public:
     Advance& operator=(const Advance& other); // Assignment operator
     ~Advance(); // Destructor
 
-    bool validate() const override;
-    void execute() override;
-
     Order* clone() const override;
-    std::string toString() const override;
+    OrderType getType() const override;
+    OrderOperands getOperands() const override;
 
     friend std::ostream& operator<<(std::ostream& os, const Advance& order); // Stream insertion operator
 
+    // Rules shared with compact orders (CompactOrders.h); apply() returns the survivors of the battle, if there was one
+    static OrderValidation check(Player* issuer, Territory* source, Territory* target, int armies);
+    static BattleResult apply(Player* issuer, Territory* source, Territory* target, int armies);
+
     Territory* getSource() const;
 	Territory* getTarget() const;
+    void setArmies(int armies); // e.g. when later moves along the same border are merged into this one
+
+    // Battle rules shared with simulations: attacker kills 60% of defenders, defender kills 70% of attackers.
+    // The battle kernel (BattleKernel.h) does the sampling, keyed by 64 bits drawn from gen.
+    static BattleResult resolveBattle(int attackers, int defenders, std::mt19937& gen);
+
+    // Makes battles executed on the calling thread reproducible: they become the consecutive battles of a
+    // BattleStream with this seed (until then the thread's stream is seeded from std::random_device)
+    static void seedBattles(unsigned int seed);
+    // The calling thread's battle stream, e.g. to key a battle by its position in a sequence of orders
+    static BattleStream& getBattleStream();
+
+protected:
+    OrderValidation checkRules() const override;
+    void perform() override;
+    void printDetails(std::ostream& os) const override;
+    void printEffect(std::ostream& os) const override;
 
 private:
     Player* issuer; // Player issuing the order
@@ -126,14 +253,22 @@ public:
     Bomb& operator=(const Bomb& other); // Assignment operator
     ~Bomb(); // Destructor
 
-    bool validate() const override;
-    void execute() override;
-
     Order* clone() const override;
-    std::string toString() const override;
+    OrderType getType() const override;
+    OrderOperands getOperands() const override;
 
     friend std::ostream& operator<<(std::ostream& os, const Bomb& order); // Stream insertion operator
 
+    // Rules shared with compact orders (CompactOrders.h); apply() returns how many armies were destroyed
+    static OrderValidation check(Player* issuer, Territory* target);
+    static int apply(Territory* target);
+
+protected:
+    OrderValidation checkRules() const override;
+    void perform() override;
+    void printDetails(std::ostream& os) const override;
+    void printEffect(std::ostream& os) const override;
+
 private:
     Player* issuer; // Player issuing the order
     Territory* target; // Target territory
@@ -150,14 +285,22 @@ public:
     Blockade& operator=(const Blockade& other); // Assignment operator
     ~Blockade(); // Destructor
 
-    bool validate() const override;
-    void execute() override;
-
     Order* clone() const override;
-    std::string toString() const override;
+    OrderType getType() const override;
+    OrderOperands getOperands() const override;
 
     friend std::ostream& operator<<(std::ostream& os, const Blockade& order); // Stream insertion operator
 
+    // Rules shared with compact orders (CompactOrders.h)
+    static OrderValidation check(Player* issuer, Territory* target);
+    static void apply(Player* issuer, Territory* target);
+
+protected:
+    OrderValidation checkRules() const override;
+    void perform() override;
+    void printDetails(std::ostream& os) const override;
+    void printEffect(std::ostream& os) const override;
+
 private:
     Player* issuer; // Player issuing the order
     Territory* target; // Target territory
@@ -174,14 +317,22 @@ public:
     Airlift& operator=(const Airlift& other); // Assignment operator
     ~Airlift(); // Destructor
 
-    bool validate() const override;
-    void execute() override;
-
     Order* clone() const override;
-    std::string toString() const override;
+    OrderType getType() const override;
+    OrderOperands getOperands() const override;
 
     friend std::ostream& operator<<(std::ostream& os, const Airlift& order); // Stream insertion operator
 
+    // Rules shared with compact orders (CompactOrders.h)
+    static OrderValidation check(Player* issuer, Territory* source, Territory* target, int armies);
+    static void apply(Territory* source, Territory* target, int armies);
+
+protected:
+    OrderValidation checkRules() const override;
+    void perform() override;
+    void printDetails(std::ostream& os) const override;
+    void printEffect(std::ostream& os) const override;
+
 private:
     Player* issuer; // Player issuing the order
     Territory* source; // Source territory
@@ -200,14 +351,22 @@ public:
     Negotiate& operator=(const Negotiate& other); // Assignment operator
     ~Negotiate(); // Destructor
 
-    bool validate() const override;
-    void execute() override;
-
     Order* clone() const override;
-    std::string toString() const override;
+    OrderType getType() const override;
+    OrderOperands getOperands() const override;
 
     friend std::ostream& operator<<(std::ostream& os, const Negotiate& order); // Stream insertion operator
 
+    // Rules shared with compact orders (CompactOrders.h)
+    static OrderValidation check(Player* issuer, Player* targetPlayer);
+    static void apply(Player* issuer, Player* targetPlayer);
+
+protected:
+    OrderValidation checkRules() const override;
+    void perform() override;
+    void printDetails(std::ostream& os) const override;
+    void printEffect(std::ostream& os) const override;
+
 private:
     Player* issuer; // Player issuing the order
     Player* targetPlayer; // Target player to negotiate with
@@ -225,7 +384,8 @@ public:
     ~OrdersList(); // Destructor
 
     void add(const Order& order); // Add order to the list
-    void add(Order* order); // Add order pointer to the list
+    void add(Order* order); // Add order pointer to the list (the list takes ownership)
+    void add(std::vector<std::unique_ptr<Order>>&& batch); // Move a batch of orders to the end of the list (no copies, one notification)
     void remove(Order* order); // Remove order from the list (by pointer)
     void remove(int index);// Deletes order from the list (by index)
     void move(int fromIndex, int toIndex); // Move order within the list
@@ -3,6 +3,14 @@
 #include "Orders.h"
 #include "Player.h"
 #include "Map.h"
+#include "BattleOdds.h"
+#include "CompactOrders.h"
+#include "OrderJournal.h"
+#include "ConsoleLog.h"
+#include <chrono>
+#include <random>
+#include <sstream>
+#include <stdexcept>
 
 using namespace std;
 
@@ -144,10 +152,10 @@ void testOrderExecution() {
     cout << "\nExecuting and validating orders:\n";
     for (int i = 0; i < orders.size(); i++) {
         Order& o = orders.at(i);
-        bool valid = o.validate();
+        OrderCheck check = o.validate();
         cout << "Order " << (i + 1) << " (" << typeid(o).name() << ") is "
-            << (valid ? "valid" : "invalid") << endl;
-        o.execute();
+            << (check.isValid() ? "valid" : string("invalid: ") + Order::getValidationText(check.getResult())) << endl;
+        o.execute(check); // checked once
     }
 
     // --- Final results ---
@@ -177,6 +185,16 @@ void testOrderExecution() {
     else
         cout << "[Check] Blockade: verify A2 transferred to Neutral player in your implementation.\n";
 
+    // A check only vouches for the order that made it
+    bool refused = false;
+    try {
+        orders.at(1).execute(orders.at(0).validate());
+    }
+    catch (const invalid_argument&) {
+        refused = true;
+    }
+    cout << "[Check] Executing an order with the check of another order is refused: " << (refused ? "yes" : "NO") << "\n";
+
     cout << "[Check] All order types issued and executed successfully.\n";
 
     // --- Clean up ---
@@ -187,4 +205,346 @@ void testOrderExecution() {
     delete B1;
 
     cout << "\n=== Testing Order Execution Complete ===\n\n";
-}
\ No newline at end of file
+}
+void testBattleOdds() {
+	cout << "=== Battle Odds Testing ===\n\n";
+
+	BattleOdds::initialize();
+
+	// Each table entry should match the frequency observed with the real battle rules
+	const int battles = 20000;
+	const int cases[][2] = { { 1, 0 }, { 3, 2 }, { 5, 3 }, { 10, 6 }, { 20, 12 }, { 40, 30 }, { 200, 120 } };
+	mt19937 gen(345);
+
+	for (const auto& c : cases) {
+		int conquered = 0;
+		double occupying = 0.0;
+
+		for (int i = 0; i < battles; i++) {
+			BattleResult result = Advance::resolveBattle(c[0], c[1], gen);
+			if (result.conquered) {
+				conquered++;
+				occupying += result.attackersLeft;
+			}
+		}
+
+		cout << c[0] << " vs " << c[1] << ": conquest "
+			<< BattleOdds::conquestProbability(c[0], c[1]) << " (simulated " << (static_cast<double>(conquered) / battles) << ")"
+			<< ", occupying " << BattleOdds::expectedOccupyingArmies(c[0], c[1]) << " (simulated " << (occupying / battles) << ")\n";
+	}
+
+	cout << "\nAttackers needed for 75% against 10 defenders: " << BattleOdds::attackersNeeded(10, 0.75, 100) << "\n";
+	cout << "\n=== Battle Odds Testing Complete ===\n\n";
+}
+
+void benchmarkOrderRepresentations() {
+	cout << "=== Order Representation Benchmark ===\n\n";
+
+	// A ring of territories held by one player: every order below is valid and none starts a battle,
+	// so both representations do exactly the same work on the board
+	const int territoryCount = 64;
+	const int ordersPerTurn = 10000;
+	const int turns = 20;
+
+	Map map;
+	Player* player = new Player();
+	player->setName("Player1");
+
+	for (int i = 0; i < territoryCount; i++) {
+		Territory* territory = new Territory("R" + to_string(i), i, 0, "Ring");
+		territory->setOwner(player);
+		territory->setArmies(10);
+		map.addTerritory(territory);
+	}
+	const vector<Territory*>& ring = map.getTerritories();
+	for (int i = 0; i < territoryCount; i++) {
+		ring[i]->addAdjacentTerritory(ring[(i + 1) % territoryCount]);
+		ring[(i + 1) % territoryCount]->addAdjacentTerritory(ring[i]);
+	}
+
+	OrderIndex index({ player }, ring);
+
+	// Half deploys, half one-army moves to the next territory
+	bool wasQuiet = ConsoleLog::isQuiet();
+	ConsoleLog::setQuiet(true);
+
+	auto start = chrono::steady_clock::now();
+	for (int turn = 0; turn < turns; turn++) {
+		OrdersList orders;
+		for (int i = 0; i < ordersPerTurn; i++) {
+			Territory* territory = ring[i % territoryCount];
+			if (i % 2 == 0) orders.add(new Deploy(player, territory, 1));
+			else orders.add(new Advance(player, territory, ring[(i + 1) % territoryCount], 1));
+		}
+		for (Order* order : orders.getOrders()) {
+			order->execute();
+		}
+	}
+	auto middle = chrono::steady_clock::now();
+	for (int turn = 0; turn < turns; turn++) {
+		CompactOrdersList orders;
+		vector<CompactOrder> plan;
+		plan.reserve(ordersPerTurn);
+		for (int i = 0; i < ordersPerTurn; i++) {
+			int territory = i % territoryCount;
+			if (i % 2 == 0) plan.push_back(CompactOrder::deploy(0, territory, 1));
+			else plan.push_back(CompactOrder::advance(0, territory, (i + 1) % territoryCount, 1));
+		}
+		orders.add(move(plan));
+		orders.executeAll(index);
+	}
+	auto end = chrono::steady_clock::now();
+
+	ConsoleLog::setQuiet(wasQuiet);
+
+	double total = static_cast<double>(ordersPerTurn) * turns;
+	double polymorphic = chrono::duration<double, nano>(middle - start).count() / total;
+	double compact = chrono::duration<double, nano>(end - middle).count() / total;
+
+	cout << "Memory per order (inline bytes, before any heap blocks):\n";
+	cout << "  polymorphic: " << sizeof(Advance) << " bytes for an Advance + " << sizeof(Order*)
+		<< " for its pointer in the list, plus the heap block holding the object\n";
+	cout << "  compact: " << sizeof(CompactOrder) << " bytes, stored in one contiguous block\n";
+	cout << "\nIssue and execute " << ordersPerTurn << " orders, " << turns << " turns:\n";
+	cout << "  polymorphic: " << polymorphic << " ns per order\n";
+	cout << "  compact: " << compact << " ns per order (" << (compact > 0 ? polymorphic / compact : 0.0) << "x)\n";
+
+	delete player;
+
+	cout << "\n=== Order Representation Benchmark Complete ===\n\n";
+}
+
+void testBattleKernel() {
+	cout << "=== Battle Kernel Testing ===\n\n";
+
+	// Philox4x32-10 known-answer vectors from the Random123 distribution
+	PhiloxBlock zero = BattleKernel::philox(0, 0);
+	PhiloxBlock pi = BattleKernel::philox(PhiloxBlock{ { 0x243f6a88, 0x85a308d3, 0x13198a2e, 0x03707344 } }, 0x299f31d0a4093822ULL);
+	bool zeroMatches = zero.words[0] == 0x6627e8d5 && zero.words[1] == 0xe169c58d && zero.words[2] == 0xbc57ac4c && zero.words[3] == 0x9b00dbd8;
+	bool piMatches = pi.words[0] == 0xd16cfe09 && pi.words[1] == 0x94fdcceb && pi.words[2] == 0x5001e420 && pi.words[3] == 0x24126ea1;
+	cout << "[Check] Philox known answers: " << (zeroMatches && piMatches ? "match" : "MISMATCH") << "\n\n";
+
+	// Mean and variance of the sampler against n p and n p (1 - p), on both sides of the inversion limit
+	const int samples = 200000;
+	const int sizes[] = { 3, 40, 150, 1000 };
+	const double rates[] = { BattleKernel::AttackerKillRate, BattleKernel::DefenderKillRate };
+	for (double p : rates) {
+		for (int n : sizes) {
+			double sum = 0.0, squares = 0.0;
+			for (int i = 0; i < samples; i++) {
+				PhiloxBlock block = BattleKernel::philox(7, i);
+				int x = BattleKernel::sampleBinomial(n, p, BattleKernel::toUniform(block.words[0], block.words[1]));
+				sum += x;
+				squares += static_cast<double>(x) * x;
+			}
+			double mean = sum / samples;
+			cout << "Bin(" << n << ", " << p << "): mean " << mean << " (expected " << n * p << ")"
+				<< ", variance " << (squares / samples - mean * mean) << " (expected " << n * p * (1.0 - p) << ")\n";
+		}
+	}
+
+	// The batch must give exactly the battles resolved one by one, vectorized or not
+	const int battles = 10007; // not a multiple of the batch width
+	mt19937 gen(345);
+	uniform_int_distribution<int> small(0, 12), large(0, 2000);
+	vector<int32_t> attackers(battles), defenders(battles);
+	for (int i = 0; i < battles; i++) {
+		attackers[i] = i % 5 == 0 ? large(gen) : small(gen);
+		defenders[i] = i % 7 == 0 ? large(gen) : small(gen);
+	}
+
+	BattleStream single(345), vectorized(345), scalar(345);
+	scalar.setVectorized(false);
+	vector<BattleResult> batch(battles), scalarBatch(battles);
+	vectorized.resolve(attackers.data(), defenders.data(), battles, batch.data());
+	scalar.resolve(attackers.data(), defenders.data(), battles, scalarBatch.data());
+
+	int mismatches = 0;
+	for (int i = 0; i < battles; i++) {
+		BattleResult expected = single.resolve(attackers[i], defenders[i]);
+		for (const BattleResult& result : { batch[i], scalarBatch[i] }) {
+			if (result.attackersLeft != expected.attackersLeft || result.defendersLeft != expected.defendersLeft
+				|| result.conquered != expected.conquered) mismatches++;
+		}
+	}
+	cout << "\n[Check] " << battles << " battles, batch (" << (vectorized.isVectorized() ? "AVX2" : "scalar")
+		<< ") and scalar batch against one by one: " << mismatches << " mismatches\n";
+
+	// Every platform must reproduce these battles: a fingerprint of the ones above, fixed when the kernel was written
+	uint64_t fingerprint = 14695981039346656037ULL;
+	for (const BattleResult& result : batch) {
+		fingerprint = (fingerprint ^ static_cast<uint64_t>(result.attackersLeft)) * 1099511628211ULL;
+		fingerprint = (fingerprint ^ static_cast<uint64_t>(result.defendersLeft)) * 1099511628211ULL;
+	}
+	cout << "[Check] Fingerprint of seed 345: " << hex << fingerprint << dec
+		<< (fingerprint == 0xbcbe3da06a0bbe2dULL ? " (matches)" : " (DIFFERS from the reference platform)") << "\n";
+
+	cout << "\n=== Battle Kernel Testing Complete ===\n\n";
+}
+
+void benchmarkBattleKernel() {
+	cout << "=== Battle Kernel Benchmark ===\n\n";
+
+	const int battles = 200000;
+	const int sizes[][2] = { { 3, 2 }, { 40, 30 }, { 1000, 800 } };
+
+	for (const auto& size : sizes) {
+		vector<int32_t> attackers(battles, size[0]), defenders(battles, size[1]);
+		vector<BattleResult> results(battles);
+		long long conquered = 0; // keeps the loops from being optimised away
+
+		// What Advance::execute did before: two std::binomial_distribution draws from a Mersenne Twister
+		mt19937 gen(345);
+		auto start = chrono::steady_clock::now();
+		for (int i = 0; i < battles; i++) {
+			int attackerKills = binomial_distribution<int>(size[0], BattleKernel::AttackerKillRate)(gen);
+			int defenderKills = binomial_distribution<int>(size[1], BattleKernel::DefenderKillRate)(gen);
+			conquered += attackerKills >= size[1] && defenderKills < size[0];
+		}
+		auto standard = chrono::steady_clock::now();
+
+		BattleStream stream(345);
+		for (int i = 0; i < battles; i++) {
+			conquered += stream.resolve(size[0], size[1]).conquered;
+		}
+		auto single = chrono::steady_clock::now();
+
+		stream.setVectorized(false);
+		stream.resolve(attackers.data(), defenders.data(), battles, results.data());
+		auto scalarBatch = chrono::steady_clock::now();
+
+		stream.setVectorized(true);
+		if (stream.isVectorized())
+			stream.resolve(attackers.data(), defenders.data(), battles, results.data());
+		auto end = chrono::steady_clock::now();
+		conquered += results[0].conquered;
+
+		auto perBattle = [battles](chrono::steady_clock::time_point from, chrono::steady_clock::time_point to) {
+			return chrono::duration<double, nano>(to - from).count() / battles;
+		};
+		cout << size[0] << " vs " << size[1] << ": std::binomial_distribution " << perBattle(start, standard) << " ns"
+			<< ", kernel " << perBattle(standard, single) << " ns"
+			<< ", batch " << perBattle(single, scalarBatch) << " ns";
+		if (stream.isVectorized())
+			cout << ", batch AVX2 " << perBattle(scalarBatch, end) << " ns";
+		else
+			cout << ", no AVX2 kernel on this processor";
+		cout << " per battle (" << conquered << " conquests)\n";
+	}
+
+	cout << "\n=== Battle Kernel Benchmark Complete ===\n\n";
+}
+
+// Everything an undo must put back, as text: owners, armies and slots, each player's territories, army heaps,
+// border sets (by size, their order may differ), truces and strategies
+static string describeBoard(const vector<Territory*>& territories, const vector<Player*>& players) {
+	ostringstream board;
+	for (Territory* territory : territories) {
+		board << territory->getName() << ":" << (territory->getOwner() ? territory->getOwner()->getName() : "-")
+			<< ":" << territory->getArmies() << ":" << territory->getOwnerIndex() << " ";
+	}
+	for (Player* player : players) {
+		board << "\n" << player->getName() << " " << static_cast<int>(player->getPlayerStrategy()->getKind()) << " [";
+		for (Territory* territory : player->getTerritories()) board << territory->getName() << " ";
+		Territory* weakest = player->getWeakestTerritory();
+		Territory* strongest = player->getStrongestTerritory();
+		board << "] weakest " << (weakest ? weakest->getName() : "-") << " strongest " << (strongest ? strongest->getName() : "-")
+			<< " frontier " << player->getFrontier().size() << " attackable " << player->getAttackable().size() << " truces";
+		for (Player* other : players) board << " " << player->hasNegotiatedWith(other);
+	}
+	return board.str();
+}
+
+void testOrderJournal() {
+	cout << "=== Order Journal Testing ===\n\n";
+
+	// An 8 x 8 grid split between three Aggressive players and a Neutral one
+	const int side = 8;
+	Map map;
+	for (int i = 0; i < side * side; i++) {
+		map.addTerritory(new Territory("T" + to_string(i), i % side, i / side, "Grid"));
+	}
+	const vector<Territory*>& grid = map.getTerritories();
+	for (int i = 0; i < side * side; i++) {
+		if (i % side + 1 < side) {
+			grid[i]->addAdjacentTerritory(grid[i + 1]);
+			grid[i + 1]->addAdjacentTerritory(grid[i]);
+		}
+		if (i + side < side * side) {
+			grid[i]->addAdjacentTerritory(grid[i + side]);
+			grid[i + side]->addAdjacentTerritory(grid[i]);
+		}
+	}
+
+	vector<Player*> players;
+	for (int p = 0; p < 4; p++) {
+		PlayerStrategy* strategy = p == 3 ? static_cast<PlayerStrategy*>(new NeutralPlayerStrategy(nullptr)) : new AggressivePlayerStrategy(nullptr);
+		players.push_back(new Player("P" + to_string(p + 1), strategy));
+	}
+
+	mt19937 gen(2024);
+	for (int i = 0; i < side * side; i++) {
+		Player* owner = players[(i / side / (side / 2)) * 2 + (i % side) / (side / 2)];
+		grid[i]->setOwner(owner);
+		owner->addTerritory(grid[i]);
+		grid[i]->setArmies(uniform_int_distribution<int>(1, 12)(gen));
+	}
+
+	// Random orders of every kind, most of them valid
+	auto randomOperands = [&](OrderType type) {
+		uniform_int_distribution<int> anyTerritory(0, side * side - 1), anyPlayer(0, 3);
+		Player* issuer = players[anyPlayer(gen)];
+		Territory* source = issuer->getTerritories().empty() ? nullptr
+			: issuer->getTerritories()[uniform_int_distribution<size_t>(0, issuer->getTerritories().size() - 1)(gen)];
+		Territory* target = grid[anyTerritory(gen)];
+		if (source && (type == OrderType::Advance || type == OrderType::Bomb)) {
+			const vector<Territory*>& neighbours = source->getAdjacentTerritories();
+			target = neighbours[uniform_int_distribution<size_t>(0, neighbours.size() - 1)(gen)];
+		}
+		if (type == OrderType::Deploy || type == OrderType::Blockade) target = source;
+		int armies = source ? uniform_int_distribution<int>(1, max(1, source->getArmies()))(gen) : 1;
+		return OrderOperands{ issuer, source, target, players[anyPlayer(gen)], armies };
+	};
+
+	Advance::seedBattles(7);
+	string initial = describeBoard(grid, players);
+
+	OrderJournal journal;
+	const int attempts = 400;
+	int applied = 0;
+	for (int i = 0; i < attempts; i++) {
+		OrderType type = static_cast<OrderType>(uniform_int_distribution<int>(0, 5)(gen));
+		if (journal.apply(type, randomOperands(type))) applied++;
+	}
+	string played = describeBoard(grid, players);
+	uint64_t playedPosition = Advance::getBattleStream().getPosition();
+	cout << applied << " of " << attempts << " random orders applied\n";
+
+	// Back to the start, then forward again with the same battles
+	auto start = chrono::steady_clock::now();
+	journal.rollback(0);
+	double undoNs = chrono::duration<double, nano>(chrono::steady_clock::now() - start).count() / max(applied, 1);
+	cout << "[Check] Undo all: board " << (describeBoard(grid, players) == initial ? "restored" : "DIFFERS")
+		<< ", battle stream at " << Advance::getBattleStream().getPosition() << " (expected 0)\n";
+
+	while (journal.redo()) {}
+	cout << "[Check] Redo all: board " << (describeBoard(grid, players) == played ? "matches" : "DIFFERS")
+		<< ", battle stream " << (Advance::getBattleStream().getPosition() == playedPosition ? "matches" : "DIFFERS") << "\n";
+
+	// Lookahead: try a few orders from the middle, roll back, and the game goes on as if they were never tried
+	journal.rollback(applied / 2);
+	string middle = describeBoard(grid, players);
+	size_t mark = journal.depth();
+	for (int i = 0; i < 20; i++) {
+		OrderType type = static_cast<OrderType>(uniform_int_distribution<int>(0, 5)(gen));
+		journal.apply(type, randomOperands(type));
+	}
+	journal.rollback(mark);
+	cout << "[Check] Lookahead from the middle rolled back: board " << (describeBoard(grid, players) == middle ? "restored" : "DIFFERS")
+		<< ", redo list " << (journal.canRedo() ? "holds the tried orders" : "is empty") << "\n";
+	cout << "Undo cost: " << undoNs << " ns per order\n";
+
+	for (Player* player : players) delete player;
+
+	cout << "\n=== Order Journal Testing Complete ===\n\n";
+}
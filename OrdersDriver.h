@@ -2,4 +2,9 @@
 
 // Function prototypes
 void testOrdersLists(); // Function to test OrdersList class
-void testOrderExecution(); // Function to test order execution and validation
\ No newline at end of file
+void testOrderExecution(); // Function to test order execution and validation
+void testBattleOdds(); // Function to compare the battle odds tables with simulated battles
+void benchmarkOrderRepresentations(); // Function to compare polymorphic and compact orders in memory and speed
+void testBattleKernel(); // Function to check the battle kernel's generator, sampler and batch API
+void benchmarkBattleKernel(); // Function to time battles with the kernel against std::binomial_distribution
+void testOrderJournal(); // Function to apply orders speculatively, undo them and redo them
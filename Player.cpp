@@ -1,28 +1,35 @@
 #include "Player.h"
+#include <algorithm>
+#include <unordered_set>
 
 Player::Player() //Default Constructor
 {
 	name = "Unnamed Player"; //Sets player name
     armies = 0; //Sets armies
+    stateVersion = 1; //Sets state version
     hand = new Hand(); //Creates empty hand
     ordersList = new OrdersList(); //Creates empty orders list
     playerStrategy = new HumanPlayerStrategy(this); //Create default player strategy
+    rebuildArmyHeaps();
 }
 
 Player::Player(string name, PlayerStrategy* playerStrategy) //Parameterized Constructor
 {
     this->name = name; //Sets player name
     armies = 0; //Sets armies
+    stateVersion = 1; //Sets state version
     hand = new Hand(); //Creates empty hand
     ordersList = new OrdersList(); //Creates empty orders list
     this->playerStrategy = playerStrategy; //Sets player strategy
 	playerStrategy->setPlayer(this); //Sets the player for the strategy
+    rebuildArmyHeaps();
 }
 
 Player::Player(const Player& player) //Copy Constructor
 {
 	name = player.name; //Copies player name
     armies = player.armies; //Copies armies
+    stateVersion = player.stateVersion; //Copies state version
 
     //Adds territories
     for(Territory* territory : player.territories)
@@ -30,13 +37,18 @@ Player::Player(const Player& player) //Copy Constructor
         territories.push_back(territory);
     }
 
+    rebuildArmyHeaps();
+    rebuildBorderSets(); //The original's sets carry its own back-indices, so the copy recounts them
+
     hand = new Hand(*player.hand); //Creates hand
     ordersList = new OrdersList(*player.ordersList); //Creates orders list
     playerStrategy = player.playerStrategy ? player.playerStrategy->clone() : nullptr; //Creates player strategy
+    if (playerStrategy) playerStrategy->setPlayer(this); //The copy plays for this player
 }
 
 Player::~Player() //Destructor
 {
+    detachTerritories(); //No territory or neighbour may keep pointing at this player
     delete hand; //Deletes hand
     delete ordersList; //Deletes orders list
     delete playerStrategy; //Deletes player strategy
@@ -50,7 +62,9 @@ Player& Player::operator = (const Player& player) //Assignment Operator Overload
     //Checks if the player is not equal to itself
     if (this != &player) 
     {
+        detachTerritories(); //Gives up the land this player owned before taking the other's list
         territories.clear();
+        markDirty();
 
         //Adds new territories
         for(Territory* territory : player.territories)
@@ -58,6 +72,9 @@ Player& Player::operator = (const Player& player) //Assignment Operator Overload
             territories.push_back(territory);
         }
 
+        rebuildArmyHeaps();
+        rebuildBorderSets();
+
         //Deletes hand and creates new hand
         delete hand;
         hand = new Hand(*player.hand);
@@ -69,6 +86,7 @@ Player& Player::operator = (const Player& player) //Assignment Operator Overload
         //Deletes player strategy and creates new player strategy
         delete playerStrategy;
         playerStrategy = player.playerStrategy ? player.playerStrategy->clone() : nullptr;
+        if (playerStrategy) playerStrategy->setPlayer(this);
     }
 
     return *this;
@@ -131,12 +149,12 @@ ostream& operator << (ostream &output, const Player &player) //Stream Insertion
 
 //Functions
 
-list<Territory*> Player::toDefend()
+const vector<Territory*>& Player::toDefend()
 {
     return playerStrategy->toDefend();
 }
 
-list<Territory*> Player::toAttack()
+const vector<Territory*>& Player::toAttack()
 {
     return playerStrategy->toAttack();
 }
@@ -146,19 +164,395 @@ bool Player::issueOrder(Deck* deck)
     return playerStrategy->issueOrder(deck);
 }
 
+bool Player::issueOrder(Deck* deck, const TurnBudget& budget)
+{
+    return playerStrategy->issueOrderWithin(deck, budget);
+}
+
 void Player::issueOrder(Order* order)
 {
     ordersList->add(order); //Adds the order to the orders list
 }
 
+TurnPlan Player::planTurn(const TurnBudget& budget)
+{
+    return playerStrategy->planTurn(GameView(this, budget));
+}
+
+void Player::issueOrders(TurnPlan& plan, Deck* deck)
+{
+    ordersList->add(plan.takeOrders());
+    armies -= plan.takeDeployedArmies(); //Planning leaves the pool alone, so the deploys are paid for here
+
+    for (CardType type : plan.takePlayedCards())
+    {
+        deck->addCard(type);
+    }
+}
+
 void Player::addTerritory(Territory* territory)
 {
+    int slot = static_cast<int>(territories.size());
+    territory->setOwnerIndex(slot); //Remembers where the territory is stored
 	territories.push_back(territory); //Adds the territory to the player's list of territories
+    weakestHeap.push(slot);
+    strongestHeap.push(slot);
+    markDirty();
 }
 
 void Player::removeTerritory(Territory* territory)
 {
-    territories.remove(territory); //Removes the territory from the player's list of territories
+    int index = findSlot(territories, territory, territory->getOwnerIndex());
+
+    if (index < 0)
+    {
+        return;
+    }
+
+    //Moves the last territory into the freed slot and drops the last slot
+    int lastSlot = static_cast<int>(territories.size()) - 1;
+    weakestHeap.erase(index);
+    strongestHeap.erase(index);
+    weakestHeap.relabel(lastSlot, index);
+    strongestHeap.relabel(lastSlot, index);
+
+    Territory* last = territories.back();
+    territories[index] = last;
+    last->setOwnerIndex(index);
+    territories.pop_back();
+
+    //The moved territory's tie-break changed with its slot
+    weakestHeap.update(index);
+    strongestHeap.update(index);
+
+    territory->setOwnerIndex(-1);
+    markDirty();
+}
+
+void Player::restoreTerritory(Territory* territory, int slot)
+{
+    int end = static_cast<int>(territories.size());
+
+    if (slot < 0 || slot >= end)
+    {
+        addTerritory(territory);
+        return;
+    }
+
+    //The territory removeTerritory moved into the slot goes back to the end
+    Territory* moved = territories[slot];
+    weakestHeap.relabel(slot, end);
+    strongestHeap.relabel(slot, end);
+    territories.push_back(moved);
+    moved->setOwnerIndex(end);
+    weakestHeap.update(end);
+    strongestHeap.update(end);
+
+    territories[slot] = territory;
+    territory->setOwnerIndex(slot);
+    weakestHeap.push(slot);
+    strongestHeap.push(slot);
+    markDirty();
+}
+
+int Player::acquireTerritories(const vector<Territory*>& conquered)
+{
+    //Epoch marks over territory ids drop repeated entries without building a set
+    static thread_local vector<unsigned int> seen;
+    static thread_local unsigned int epoch = 0;
+
+    if (++epoch == 0)
+    {
+        fill(seen.begin(), seen.end(), 0);
+        epoch = 1;
+    }
+
+    vector<Territory*> moving;
+    moving.reserve(conquered.size());
+
+    for (Territory* territory : conquered)
+    {
+        if (territory->getOwner() == this)
+        {
+            continue;
+        }
+
+        int id = territory->getId();
+
+        if (id >= 0)
+        {
+            if (id >= static_cast<int>(seen.size()))
+            {
+                seen.resize(id + 1, 0);
+            }
+
+            if (seen[id] == epoch)
+            {
+                continue;
+            }
+
+            seen[id] = epoch;
+        }
+        else if (find(moving.begin(), moving.end(), territory) != moving.end()) //Territories outside a map have no id
+        {
+            continue;
+        }
+
+        moving.push_back(territory);
+    }
+
+    if (moving.empty())
+    {
+        return 0;
+    }
+
+    //Every previous owner gives up all of its territories at once
+    vector<Player*> previousOwners;
+    vector<Territory*> released;
+
+    for (Territory* territory : moving)
+    {
+        Player* previous = territory->getOwner();
+
+        if (previous != nullptr && find(previousOwners.begin(), previousOwners.end(), previous) == previousOwners.end())
+        {
+            previousOwners.push_back(previous);
+        }
+    }
+
+    for (Player* previous : previousOwners)
+    {
+        released.clear();
+
+        for (Territory* territory : moving)
+        {
+            if (territory->getOwner() == previous)
+            {
+                released.push_back(territory);
+            }
+        }
+
+        previous->releaseTerritories(released);
+    }
+
+    size_t before = territories.size();
+    territories.reserve(before + moving.size());
+
+    for (Territory* territory : moving)
+    {
+        territory->setOwner(this);
+        territory->setOwnerIndex(static_cast<int>(territories.size()));
+        territories.push_back(territory);
+    }
+
+    int gained = static_cast<int>(moving.size());
+
+    //Large batches are cheaper to heapify from scratch than to push one by one
+    if (static_cast<size_t>(gained) * 4 >= territories.size())
+    {
+        weakestHeap.assign(static_cast<int>(territories.size()));
+        strongestHeap.assign(static_cast<int>(territories.size()));
+    }
+    else
+    {
+        for (int slot = static_cast<int>(before); slot < static_cast<int>(territories.size()); slot++)
+        {
+            weakestHeap.push(slot);
+            strongestHeap.push(slot);
+        }
+    }
+
+    markDirty();
+    return gained;
+}
+
+void Player::releaseTerritories(const vector<Territory*>& released)
+{
+    //A few removals are cheaper one at a time
+    if (released.size() * 4 < territories.size())
+    {
+        for (Territory* territory : released)
+        {
+            removeTerritory(territory);
+        }
+
+        return;
+    }
+
+    //Otherwise mark the slots to drop, compact the list in order and heapify once
+    vector<char> drop(territories.size(), 0);
+
+    for (Territory* territory : released)
+    {
+        int slot = findSlot(territories, territory, territory->getOwnerIndex());
+
+        if (slot >= 0)
+        {
+            drop[slot] = 1;
+        }
+    }
+
+    size_t kept = 0;
+
+    for (size_t slot = 0; slot < territories.size(); slot++)
+    {
+        if (drop[slot])
+        {
+            territories[slot]->setOwnerIndex(-1);
+            continue;
+        }
+
+        territories[kept] = territories[slot];
+        territories[kept]->setOwnerIndex(static_cast<int>(kept));
+        kept++;
+    }
+
+    territories.resize(kept);
+    weakestHeap.assign(static_cast<int>(kept));
+    strongestHeap.assign(static_cast<int>(kept));
+    markDirty();
+}
+
+void Player::addFrontierTerritory(Territory* territory)
+{
+    int slot = static_cast<int>(frontier.size());
+    territory->setFrontierIndex(slot);
+    frontier.push_back(territory);
+    frontierHeapStale = true;
+}
+
+void Player::removeFrontierTerritory(Territory* territory)
+{
+    int index = territory->getFrontierIndex();
+
+    if (index < 0 || index >= static_cast<int>(frontier.size()) || frontier[index] != territory)
+    {
+        return;
+    }
+
+    //Swap-removes like removeTerritory
+    Territory* last = frontier.back();
+    frontier[index] = last;
+    last->setFrontierIndex(index);
+    frontier.pop_back();
+
+    territory->setFrontierIndex(-1);
+    frontierHeapStale = true;
+}
+
+void Player::addAttackableTerritory(Territory* territory)
+{
+    territory->setAttackableIndex(this, static_cast<int>(attackable.size()));
+    attackable.push_back(territory);
+}
+
+void Player::removeAttackableTerritory(Territory* territory)
+{
+    int index = territory->getAttackableIndex(this);
+
+    if (index < 0 || index >= static_cast<int>(attackable.size()) || attackable[index] != territory)
+    {
+        return;
+    }
+
+    //Swap-removes like removeTerritory
+    Territory* last = attackable.back();
+    attackable[index] = last;
+    last->setAttackableIndex(this, index);
+    attackable.pop_back();
+
+    territory->setAttackableIndex(this, -1);
+}
+
+void Player::reorderTerritory(Territory* territory)
+{
+    int slot = findSlot(territories, territory, territory->getOwnerIndex());
+
+    if (slot >= 0)
+    {
+        weakestHeap.update(slot);
+        strongestHeap.update(slot);
+    }
+
+    int frontierSlot = territory->getFrontierIndex();
+
+    if (!frontierHeapStale && frontierSlot >= 0 && frontierSlot < static_cast<int>(frontier.size()) && frontier[frontierSlot] == territory)
+    {
+        strongestFrontierHeap.update(frontierSlot);
+    }
+}
+
+int Player::findSlot(const vector<Territory*>& list, Territory* territory, int hint) const
+{
+    if (hint >= 0 && hint < static_cast<int>(list.size()) && list[hint] == territory)
+    {
+        return hint;
+    }
+
+    //Falls back to a search if the stored index belongs to another player's list
+    auto found = find(list.begin(), list.end(), territory);
+    return found == list.end() ? -1 : static_cast<int>(found - list.begin());
+}
+
+void Player::detachTerritories()
+{
+    //Territories taken out of the list by setTerritories are still on the frontier, so both are walked
+    vector<Territory*> owned(territories);
+    owned.insert(owned.end(), frontier.begin(), frontier.end());
+
+    for (Territory* territory : owned)
+    {
+        if (territory->getOwner() == this)
+        {
+            territory->setOwner(nullptr); //Clears this player from the frontier, attackable and adjacent owner entries
+        }
+    }
+}
+
+void Player::rebuildBorderSets()
+{
+    //Counts the borders of this player's own list; only the real owner's sets are kept in step by Territory::setOwner
+    frontier.clear();
+    attackable.clear();
+    unordered_set<const Territory*> owned(territories.begin(), territories.end());
+    unordered_set<const Territory*> listed;
+
+    for (Territory* territory : territories)
+    {
+        bool border = false;
+
+        for (Territory* adjacent : territory->getAdjacentTerritories())
+        {
+            if (owned.count(adjacent) > 0)
+            {
+                continue;
+            }
+
+            border = true;
+            if (listed.insert(adjacent).second)
+            {
+                attackable.push_back(adjacent);
+            }
+        }
+
+        if (border)
+        {
+            frontier.push_back(territory);
+        }
+    }
+
+    frontierHeapStale = true;
+}
+
+void Player::rebuildArmyHeaps()
+{
+    weakestHeap = IndexedHeap<FewerArmies>(FewerArmies{ &territories });
+    strongestHeap = IndexedHeap<MoreArmies>(MoreArmies{ &territories });
+    strongestFrontierHeap = IndexedHeap<MoreArmies>(MoreArmies{ &frontier });
+    frontierHeapStale = true;
+
+    weakestHeap.assign(static_cast<int>(territories.size()));
+    strongestHeap.assign(static_cast<int>(territories.size()));
 }
 
 //Mutator Methods (Setters)
@@ -173,10 +567,16 @@ void Player::setArmies(int armyNumber)
     armies = armyNumber;
 }
 
-void Player::setTerritories(list<Territory*> newTerritories)
+void Player::setTerritories(const vector<Territory*>& newTerritories)
 {
     territories.clear();
-    territories = newTerritories;
+    weakestHeap.clear();
+    strongestHeap.clear();
+
+    for (Territory* territory : newTerritories)
+    {
+        addTerritory(territory);
+    }
 }
 
 void Player::setHand(Hand* newHand)
@@ -209,11 +609,64 @@ int Player::getArmies()
     return armies;
 }
 
-list<Territory*> Player::getTerritories()
+const vector<Territory*>& Player::getTerritories() const
 {
     return territories;
 }
 
+const vector<Territory*>& Player::getFrontier() const
+{
+    return frontier;
+}
+
+const vector<Territory*>& Player::getAttackable() const
+{
+    return attackable;
+}
+
+Territory* Player::getStrongestTerritory() const
+{
+    return strongestHeap.empty() ? nullptr : territories[strongestHeap.top()];
+}
+
+Territory* Player::getWeakestTerritory() const
+{
+    return weakestHeap.empty() ? nullptr : territories[weakestHeap.top()];
+}
+
+Territory* Player::getStrongestFrontierTerritory() const
+{
+    //Frontier membership churns with every conquest nearby, so its heap is rebuilt on demand rather than kept in step
+    if (frontierHeapStale)
+    {
+        strongestFrontierHeap.assign(static_cast<int>(frontier.size()));
+        frontierHeapStale = false;
+    }
+
+    return strongestFrontierHeap.empty() ? nullptr : frontier[strongestFrontierHeap.top()];
+}
+
+void Player::getWeakestTerritories(vector<Territory*>& weakest) const
+{
+    weakest.clear();
+
+    if (weakestHeap.empty())
+    {
+        return;
+    }
+
+    //Only the top of the heap holds the tied territories, so this costs O(ties) rather than O(territories)
+    int fewest = territories[weakestHeap.top()]->getArmies();
+    vector<int> slots;
+    weakestHeap.collect([&](int slot) { return territories[slot]->getArmies() == fewest; }, slots);
+    sort(slots.begin(), slots.end());
+
+    for (int slot : slots)
+    {
+        weakest.push_back(territories[slot]);
+    }
+}
+
 Hand* Player::getHand()
 {
     return hand;
@@ -229,6 +682,16 @@ PlayerStrategy* Player::getPlayerStrategy()
     return playerStrategy;
 }
 
+void Player::markDirty()
+{
+    stateVersion++;
+}
+
+unsigned long Player::getStateVersion() const
+{
+    return stateVersion;
+}
+
 void Player::addNegotiatedPlayer(Player* other) {
     if (!other || other == this) return;
     // avoid duplicates
@@ -237,6 +700,13 @@ void Player::addNegotiatedPlayer(Player* other) {
     }
 }
 
+void Player::removeNegotiatedPlayer(Player* other) {
+    auto found = std::find(negotiatedPlayers.begin(), negotiatedPlayers.end(), other);
+    if (found != negotiatedPlayers.end()) {
+        negotiatedPlayers.erase(found);
+    }
+}
+
 bool Player::hasNegotiatedWith(Player* other) const {
     if (!other) return false;
     return std::find(negotiatedPlayers.begin(), negotiatedPlayers.end(), other) != negotiatedPlayers.end();
@@ -1,11 +1,13 @@
 #pragma once
 
 #include <iostream>
-#include <list>
+#include <vector>
 #include "Map.h"
 #include "Orders.h"
 #include "Cards.h"
 #include "PlayerStrategies.h"
+#include "TurnPlan.h"
+#include "IndexedHeap.h"
 
 using namespace std;
 
@@ -27,18 +29,31 @@ class Player //Player class represents a player playing the game
         bool operator != (const Player& player); //Not Equals Operator Overloading
         friend ostream& operator << (ostream &output, const Player &player); //Stream Insertion Operator Overloading
 
-        list<Territory*> toDefend(); //Returns list of territories to defend
-        list<Territory*> toAttack(); //Returns list of territories to attack
+        const vector<Territory*>& toDefend(); //Returns read-only view of territories to defend
+        const vector<Territory*>& toAttack(); //Returns read-only view of territories to attack
         bool issueOrder(Deck* deck); //Returns if an order was issued
+        bool issueOrder(Deck* deck, const TurnBudget& budget); //Returns if an order was issued, planning within the budget
         void issueOrder(Order* order); //Issues an order
+        TurnPlan planTurn(const TurnBudget& budget); //Plans a whole turn without issuing it (strategies that plan on a snapshot can do this side by side)
+        void issueOrders(TurnPlan& plan, Deck* deck); //Moves a planned turn into the orders list in one step and returns its cards to the deck
 
 		void addTerritory(Territory* territory); //Adds a territory to the player's list of territories
-        void removeTerritory(Territory* territory); //Removes a territory from the player's list of territories
+        void removeTerritory(Territory* territory); //Removes a territory from the player's list of territories in O(1)
+        void restoreTerritory(Territory* territory, int slot); //Undoes removeTerritory: puts the territory back in its old slot in O(log n)
+        int acquireTerritories(const vector<Territory*>& conquered); //Takes every listed territory from its owner in one pass, returns how many changed hands
+        void releaseTerritories(const vector<Territory*>& released); //Removes many territories at once, keeping the others in order
+
+        //Border sets, maintained by Territory::setOwner and Territory::addAdjacentTerritory
+        void addFrontierTerritory(Territory* territory);
+        void removeFrontierTerritory(Territory* territory);
+        void addAttackableTerritory(Territory* territory);
+        void removeAttackableTerritory(Territory* territory);
+        void reorderTerritory(Territory* territory); //Re-sorts an owned territory after its armies changed (called by Territory::setArmies)
 
         //Mutator Methods (Setters)
         void setName(string newName);
         void setArmies(int armyNumber);
-        void setTerritories(list<Territory*> newTerritories); //Sets list of territories
+        void setTerritories(const vector<Territory*>& newTerritories); //Sets list of territories
         void setHand(Hand* newHand); //Sets hand
         void setOrdersList(OrdersList* newOrdersList); //Sets orders list
         void setPlayerStrategy(PlayerStrategy* newStrategy); //Sets strategy
@@ -46,23 +61,69 @@ class Player //Player class represents a player playing the game
         //Accessor Methods (Getters)
 		string getName(); //Returns name
         int getArmies();
-        list<Territory*> getTerritories(); //Returns list of territories
+        const vector<Territory*>& getTerritories() const; //Returns read-only view of territories (no copy)
+        const vector<Territory*>& getFrontier() const; //Returns owned territories with at least one enemy neighbour
+        const vector<Territory*>& getAttackable() const; //Returns territories not owned by the player that border one it owns
+        Territory* getStrongestTerritory() const; //Returns the first owned territory with the most armies in O(1), or nullptr
+        Territory* getWeakestTerritory() const; //Returns the first owned territory with the fewest armies in O(1), or nullptr
+        Territory* getStrongestFrontierTerritory() const; //Returns the first frontier territory with the most armies in O(1), or nullptr
+        void getWeakestTerritories(vector<Territory*>& weakest) const; //Fills in every territory tied for fewest armies, in list order
         Hand* getHand(); //Returns hand
         OrdersList* getOrdersList(); //Returns orders list
         PlayerStrategy* getPlayerStrategy(); //Returns player strategy
 
+        //For invalidating cached strategy queries
+        void markDirty(); //Called whenever an owned or bordering territory changes owner or armies
+        unsigned long getStateVersion() const;
+
         //For tracking truces
         void addNegotiatedPlayer(Player* other);
+        void removeNegotiatedPlayer(Player* other);
         bool hasNegotiatedWith(Player* other) const;
         void clearNegotiatedPlayers();
 
     private:
+        //Orders slots of a territory list by armies, ties going to the earlier slot (the order a linear scan would pick)
+        struct FewerArmies
+        {
+            const vector<Territory*>* list;
+            bool operator()(int a, int b) const
+            {
+                int armiesA = (*list)[a]->getArmies();
+                int armiesB = (*list)[b]->getArmies();
+                return armiesA != armiesB ? armiesA < armiesB : a < b;
+            }
+        };
+
+        struct MoreArmies
+        {
+            const vector<Territory*>* list;
+            bool operator()(int a, int b) const
+            {
+                int armiesA = (*list)[a]->getArmies();
+                int armiesB = (*list)[b]->getArmies();
+                return armiesA != armiesB ? armiesA > armiesB : a < b;
+            }
+        };
+
+        int findSlot(const vector<Territory*>& list, Territory* territory, int hint) const; //Returns the territory's slot in the list, or -1
+        void rebuildArmyHeaps(); //Rebinds the heaps to this player's lists and refills them
+        void rebuildBorderSets(); //Recounts frontier and attackable from the territory list (for copies, which own nothing)
+        void detachTerritories(); //Makes every territory still owned unowned, so nothing points at this player once it is gone
+
         //Data Members
         string name;
         int armies;
-        list<Territory*> territories;
+        vector<Territory*> territories; //Each territory stores its index in this vector for swap-removal
+        vector<Territory*> frontier; //Each territory stores its index in this vector too
+        vector<Territory*> attackable; //Indices are stored per player on the attackable territory
+        IndexedHeap<FewerArmies> weakestHeap; //Slots of territories, fewest armies on top
+        IndexedHeap<MoreArmies> strongestHeap; //Slots of territories, most armies on top
+        mutable IndexedHeap<MoreArmies> strongestFrontierHeap; //Slots of frontier, most armies on top
+        mutable bool frontierHeapStale; //Set when frontier membership changes, the heap is rebuilt by the next query
         Hand* hand;
         OrdersList* ordersList;
         std::vector<Player*> negotiatedPlayers;
         PlayerStrategy* playerStrategy;
+        unsigned long stateVersion; //Starts at 1, strategies treat 0 as "not computed"
 };
\ No newline at end of file
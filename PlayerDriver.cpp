@@ -8,7 +8,7 @@ void testPlayers() //Free function that tests the Player class's functionality
     cout << "=== Players Testing ===\n\n";
 
     Player* player1 = new Player(); //Creates new Player
-	list<Territory*> testTerritories = { new Territory("TerritoryA", 10, 30, "ContinentB"), new Territory("TerritoryB", 30, 20, "ContinentB") }; //Creates list of territories
+	vector<Territory*> testTerritories = { new Territory("TerritoryA", 10, 30, "ContinentB"), new Territory("TerritoryB", 30, 20, "ContinentB") }; //Creates list of territories
 	player1->setTerritories(testTerritories); //Adds territories to the player
     player1->getHand()->addCard(make_unique<Card>(CardType::Bomb)); //Adds a card to the player's hand
     player1->getHand()->addCard(make_unique<Card>(CardType::Reinforcement)); //Adds a card to the player's hand
@@ -18,7 +18,7 @@ void testPlayers() //Free function that tests the Player class's functionality
 
     cout << "Player toDefend() method\n----------------------------\n";
     
-    list<Territory*> toDefendTerritories = player1->toDefend(); //Tests the toDefend() method
+    const vector<Territory*>& toDefendTerritories = player1->toDefend(); //Tests the toDefend() method
 
     //Prints the list of territories
     for(const Territory* territory : toDefendTerritories)
@@ -33,7 +33,7 @@ void testPlayers() //Free function that tests the Player class's functionality
 
     cout << "\n\nPlayer toAttack() method\n----------------------------\n";
     
-    list<Territory*> toAttackTerritories = player1->toAttack(); //Tests the toAttack() method
+    const vector<Territory*>& toAttackTerritories = player1->toAttack(); //Tests the toAttack() method
 
     //Prints the list of territories
     for(const Territory* territory : toAttackTerritories)
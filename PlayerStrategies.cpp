@@ -3,26 +3,38 @@
 #include "Orders.h"
 #include "Cards.h"
 #include "Player.h"
+#include "TurnPlan.h"
+#include "ThreadPool.h"
+#include "StrategyRegistry.h"
+#include "ConsoleLog.h"
+#include "BattleOdds.h"
+#include "BoardEvaluator.h"
 #include <set>
+#include <deque>
+#include <sstream>
+#include <limits>
+#include <cmath>
+#include <algorithm>
 
 //PlayerStrategy class implementation
 
 PlayerStrategy::PlayerStrategy(Player* player) //Parameterized Constructor
 {
 	this->player = player;
+	invalidateCache();
 }
 
 PlayerStrategy::PlayerStrategy(const PlayerStrategy& playerStrategy) //Copy Constructor
 {
-	player = new Player(*playerStrategy.player);
+	player = nullptr; //The player copying its strategy binds it (copying the player here would copy this strategy again, without end)
+	invalidateCache();
 }
 
 PlayerStrategy& PlayerStrategy::operator = (const PlayerStrategy& playerStrategy) //Assignment Operator Overloading
 {
 	if (this != &playerStrategy)
 	{
-		delete player;
-		player = new Player(*playerStrategy.player);
+		invalidateCache(); //Keeps playing for its own player, which owns this strategy
 	}
 
 	return *this;
@@ -37,6 +49,7 @@ ostream& operator << (ostream& output, const PlayerStrategy& playerStrategy) //S
 void PlayerStrategy::setPlayer(Player* player)
 {
 	this->player = player;
+	invalidateCache();
 }
 
 Player* PlayerStrategy::getPlayer()
@@ -49,6 +62,64 @@ string PlayerStrategy::getStrategyString() const
 	return "Abstract";
 }
 
+bool PlayerStrategy::issueOrder(Deck* deck)
+{
+	return issueOrderWithin(deck, TurnBudget());
+}
+
+bool PlayerStrategy::issueOrderWithin(Deck* deck, const TurnBudget& budget)
+{
+	TurnPlan plan = planTurn(GameView(player, budget));
+	bool orderIssued = !plan.empty();
+
+	player->issueOrders(plan, deck); //The whole turn joins the orders list at once
+	return orderIssued;
+}
+
+TurnPlan PlayerStrategy::planTurn(const GameView& view)
+{
+	return TurnPlan();
+}
+
+bool PlayerStrategy::plansOnSnapshot() const
+{
+	return false;
+}
+
+void PlayerStrategy::setMap(Map* map) {}
+
+bool PlayerStrategy::isCached(unsigned long& version)
+{
+	if (player == nullptr)
+	{
+		return false;
+	}
+
+	if (version == player->getStateVersion())
+	{
+		return true;
+	}
+
+	version = player->getStateVersion();
+	return false;
+}
+
+void PlayerStrategy::invalidateCache()
+{
+	defendVersion = 0;
+	attackVersion = 0;
+}
+
+Territory* PlayerStrategy::getStrongestTerritory()
+{
+	return player->getStrongestTerritory();
+}
+
+Territory* PlayerStrategy::getWeakestTerritory()
+{
+	return player->getWeakestTerritory();
+}
+
 //HumanPlayerStrategy class implementation
 
 HumanPlayerStrategy::HumanPlayerStrategy(Player* player) : PlayerStrategy(player) {} //Parameterized Constructor
@@ -113,13 +184,9 @@ bool HumanPlayerStrategy::issueOrder(Deck* deck)
 	};
 
 	auto getTerritoryByIndex = [this](int index) -> Territory* {
-		if (index < 0) return nullptr;
-		int i = 0;
-		for (Territory* t : player->getTerritories()) {
-			if (i == index) return t;
-			++i;
-		}
-		return nullptr;
+		const vector<Territory*>& territories = player->getTerritories();
+		if (index < 0 || index >= static_cast<int>(territories.size())) return nullptr;
+		return territories[index];
 	};
 
 	switch (choice) {
@@ -253,7 +320,7 @@ bool HumanPlayerStrategy::issueOrder(Deck* deck)
 				std::vector<Territory*> enemyTerr;
 				int i = 0;
 
-				list<Territory*> attackList = toAttack();
+				const vector<Territory*>& attackList = toAttack();
 				for (Territory* t : attackList) { // if you have such helper; otherwise build like toAttack()
 					cout << "  [" << i << "] " << t->getName()
 						<< " (owner: " << t->getOwner()->getName()
@@ -355,12 +422,9 @@ bool HumanPlayerStrategy::issueOrder(Deck* deck)
 			else if (type == "Diplomacy") {
 				// Collect adjacent enemy players
 				std::set<Player*> enemyPlayersSet;
-				for (Territory* myTerr : player->getTerritories()) {
-					for (Territory* adj : myTerr->getAdjacentTerritories()) {
-						if (adj->getOwner() != nullptr &&
-							adj->getOwner() != player) {
-							enemyPlayersSet.insert(adj->getOwner());
-						}
+				for (Territory* adj : player->getAttackable()) {
+					if (adj->getOwner() != nullptr) {
+						enemyPlayersSet.insert(adj->getOwner());
 					}
 				}
 
@@ -400,34 +464,38 @@ bool HumanPlayerStrategy::issueOrder(Deck* deck)
 	}
 }
 
-list<Territory*> HumanPlayerStrategy::toDefend()
+bool HumanPlayerStrategy::issueOrderWithin(Deck* deck, const TurnBudget& budget)
+{
+	return issueOrder(deck);
+}
+
+const vector<Territory*>& HumanPlayerStrategy::toDefend()
 {
 	// For a human, just return all owned territories; the player decides in issueOrder.
-	list<Territory*> defendList;
-	for (Territory* t : player->getTerritories()) {
-		defendList.push_back(t);
-	}
-	return defendList;
+	return player->getTerritories();
 }
 
-list<Territory*> HumanPlayerStrategy::toAttack()
+const vector<Territory*>& HumanPlayerStrategy::toAttack()
 {
 	// All adjacent enemy territories to any of the human player's territories.
-	list<Territory*> attackList;
-	std::set<Territory*> seen;
-
-	for (Territory* t : player->getTerritories()) {
-		for (Territory* adj : t->getAdjacentTerritories()) {
-			if (adj->getOwner() != player && adj->getOwner() != nullptr) {
-				if (!seen.count(adj)) {
-					seen.insert(adj);
-					attackList.push_back(adj);
-				}
-			}
+	if (isCached(attackVersion)) {
+		return attackBuffer;
+	}
+
+	attackBuffer.clear();
+
+	for (Territory* adj : player->getAttackable()) {
+		if (adj->getOwner() != nullptr) {
+			attackBuffer.push_back(adj);
 		}
 	}
 
-	return attackList;
+	return attackBuffer;
+}
+
+StrategyKind HumanPlayerStrategy::getKind() const
+{
+	return StrategyKind::Human;
 }
 
 string HumanPlayerStrategy::getStrategyString() const
@@ -435,17 +503,22 @@ string HumanPlayerStrategy::getStrategyString() const
 	return "Human";
 }
 
+//Humans need a console, so they cannot take part in tournaments
+static const bool humanRegistered = StrategyRegistry::add(StrategyKind::Human, "Human", {}, false,
+	[](const StrategyParameters& parameters) { return new HumanPlayerStrategy(nullptr); });
+
 //AggressivePlayerStrategy class implementation
 
-AggressivePlayerStrategy::AggressivePlayerStrategy(Player* player) : PlayerStrategy(player) {} //Parameterized Constructor
+AggressivePlayerStrategy::AggressivePlayerStrategy(Player* player, int split) : PlayerStrategy(player), split(max(0, split)) {} //Parameterized Constructor
 
-AggressivePlayerStrategy::AggressivePlayerStrategy(const AggressivePlayerStrategy& playerStrategy) : PlayerStrategy(playerStrategy) {} //Copy Constructor
+AggressivePlayerStrategy::AggressivePlayerStrategy(const AggressivePlayerStrategy& playerStrategy) : PlayerStrategy(playerStrategy), split(playerStrategy.split) {} //Copy Constructor
 
 AggressivePlayerStrategy& AggressivePlayerStrategy::operator = (const AggressivePlayerStrategy& playerStrategy) //Assignment Operator Overloading
 {
 	if (this != &playerStrategy)
 	{
 		PlayerStrategy::operator=(playerStrategy);
+		split = playerStrategy.split;
 	}
 
 	return *this;
@@ -462,23 +535,21 @@ AggressivePlayerStrategy* AggressivePlayerStrategy::clone() //Clone function
 	return new AggressivePlayerStrategy(*this);
 }
 
-bool AggressivePlayerStrategy::issueOrder(Deck* deck)
+TurnPlan AggressivePlayerStrategy::planTurn(const GameView& view)
 {
+	TurnPlan plan;
+
 	if (player->getTerritories().empty())
 	{
-		return false;
+		return plan;
 	}
 
-	bool orderIssued = false;
-
 	Territory* strongest = toDefend().front(); //Finds the strongest territory owned
 
 	if (player->getArmies() > 0) //Checks if there are armies to deploy
 	{
 		//Deploys all armies to the strongest territory
-		player->issueOrder(new Deploy(player, strongest, player->getArmies()));
-		player->setArmies(0);
-		orderIssued = true;
+		plan.add(new Deploy(player, strongest, player->getArmies()));
 	}
 	
 	//Advances all possible armies from adjacent territories to the strongest territory
@@ -486,12 +557,22 @@ bool AggressivePlayerStrategy::issueOrder(Deck* deck)
 	{
 		if (adjacent->getOwner() == player && adjacent->getArmies() > 1)
 		{
-			player->issueOrder(new Advance(player, adjacent, strongest, (adjacent->getArmies() - 1)));
-			orderIssued = true;
+			plan.add(new Advance(player, adjacent, strongest, (adjacent->getArmies() - 1)));
 		}
 	}
 
-	list<Territory*> attackList = toAttack(); //Finds all possible territories to attack from the strongest territory
+	const vector<Territory*>* targets = &toAttack(); //Finds all possible territories to attack from the strongest territory
+	vector<Territory*> weakestTargets;
+
+	if (split > 0 && targets->size() > static_cast<size_t>(split)) //Only divides the attack between the weakest few targets
+	{
+		weakestTargets = *targets;
+		stable_sort(weakestTargets.begin(), weakestTargets.end(), [](Territory* a, Territory* b) { return a->getArmies() < b->getArmies(); });
+		weakestTargets.resize(split);
+		targets = &weakestTargets;
+	}
+
+	const vector<Territory*>& attackList = *targets;
 	
 	if (!attackList.empty()) //Checks if there are any territories to attack
 	{
@@ -505,18 +586,13 @@ bool AggressivePlayerStrategy::issueOrder(Deck* deck)
 			}
 		}
 
-		//Plays all possible Bomb cards on the strongest enemy territory
-		for (const auto& card : player->getHand()->getCards())
+		//Plays all Bomb cards on the strongest enemy territory
+		for (int bombs = player->getHand()->count(CardType::Bomb); bombs > 0; bombs--)
 		{
-			if (card->getTypeAsString() == "Bomb")
-			{
-				CardPlayContext& context = CardPlayContext();
-				context.target = strongestEnemy;
-
-				card->play(player, deck, player->getHand(), context);
+			CardPlayContext context;
+			context.target = strongestEnemy;
 
-				orderIssued = true;
-			}
+			plan.playCard(player, CardType::Bomb, context);
 		}
 
 		//Calculates armies to attack with
@@ -524,76 +600,55 @@ bool AggressivePlayerStrategy::issueOrder(Deck* deck)
 		int armyRemainder = strongest->getArmies() % attackList.size();
 
 		//Issues Advance orders to all territories in the attack list
-		while (!attackList.empty() && strongest->getArmies() > 1 && armyAmount > 0)
+		for (size_t i = 0; i < attackList.size() && strongest->getArmies() > 1 && armyAmount > 0; i++)
 		{
-			if (attackList.size() == 1)
+			if (i == attackList.size() - 1)
 			{
 				armyAmount += (armyRemainder - 1);
 			}
 
-			player->issueOrder(new Advance(player, strongest, attackList.front(), armyAmount));
-			attackList.pop_front();
-			orderIssued = true;
+			plan.add(new Advance(player, strongest, attackList[i], armyAmount));
 		}
 	}
 
-	return orderIssued;
+	return plan;
 }
 
-list<Territory*> AggressivePlayerStrategy::toDefend()
+const vector<Territory*>& AggressivePlayerStrategy::toDefend()
 {
-	if (player->getTerritories().empty())
+	if (isCached(defendVersion))
 	{
-		return {};
+		return defendBuffer;
 	}
 
-	bool enemyAdjacent = false;
-	Territory* strongest = nullptr;
+	defendBuffer.clear();
 
-	//Iterates through all territories owned by the player
-	for (Territory* territory : player->getTerritories())
+	if (player->getTerritories().empty())
 	{
-		if (strongest == nullptr)
-		{
-			strongest = territory;
-		}
+		return defendBuffer;
+	}
 
-		bool hasEnemyNeighbours = false;
+	//Prefers the strongest territory with enemy neighbours, falling back to the strongest overall
+	Territory* strongest = player->getFrontier().empty() ? getStrongestTerritory() : player->getStrongestFrontierTerritory();
 
-		//Check if territory has any enemy neighbours
-		for (Territory* adjacent : territory->getAdjacentTerritories())
-		{
-			if (adjacent->getOwner() != player)
-			{
-				hasEnemyNeighbours = true;
-				break;
-			}
-		}
+	defendBuffer.push_back(strongest);
+	return defendBuffer;
+}
 
-		//Select the strongest territory with enemy neighbours
-		if (!enemyAdjacent && hasEnemyNeighbours)
-		{
-			strongest = territory;
-			enemyAdjacent = true;
-		}
-		else if (strongest->getArmies() < territory->getArmies() && ((enemyAdjacent && hasEnemyNeighbours) || (!enemyAdjacent && !hasEnemyNeighbours)))
-		{
-			strongest = territory;
-		}
+const vector<Territory*>& AggressivePlayerStrategy::toAttack()
+{
+	if (isCached(attackVersion))
+	{
+		return attackBuffer;
 	}
 
-	return {strongest};
-}
+	attackBuffer.clear();
 
-list<Territory*> AggressivePlayerStrategy::toAttack()
-{
 	if (player->getTerritories().empty())
 	{
-		return {};
+		return attackBuffer;
 	}
 
-	list<Territory*> attackList;
-
 	Territory* attackFrom = toDefend().front();
 
 	//Iterates through all adjacent territories to find possible attack targets
@@ -602,11 +657,16 @@ list<Territory*> AggressivePlayerStrategy::toAttack()
 		//Adds to attack list if the adjacent territory is not owned by the player
 		if (adjacent->getOwner() != player)
 		{
-			attackList.push_back(adjacent);
+			attackBuffer.push_back(adjacent);
 		}
 	}
 
-	return attackList;
+	return attackBuffer;
+}
+
+StrategyKind AggressivePlayerStrategy::getKind() const
+{
+	return StrategyKind::Aggressive;
 }
 
 string AggressivePlayerStrategy::getStrategyString() const
@@ -614,6 +674,19 @@ string AggressivePlayerStrategy::getStrategyString() const
 	return "Aggressive";
 }
 
+int AggressivePlayerStrategy::getSplit() const
+{
+	return split;
+}
+
+static const bool aggressiveRegistered = StrategyRegistry::add(StrategyKind::Aggressive, "Aggressive", { "split" }, true,
+	[](const StrategyParameters& parameters) { return new AggressivePlayerStrategy(nullptr, parameters.get("split", 0)); });
+
+bool AggressivePlayerStrategy::plansOnSnapshot() const
+{
+	return true;
+}
+
 //BenevolentPlayerStrategy class implementation
 
 BenevolentPlayerStrategy::BenevolentPlayerStrategy(Player* player) : PlayerStrategy(player) {} //Parameterized Constructor
@@ -641,219 +714,183 @@ BenevolentPlayerStrategy* BenevolentPlayerStrategy::clone() //Clone function
 	return new BenevolentPlayerStrategy(*this);
 }
 
-bool BenevolentPlayerStrategy::issueOrder(Deck* deck)
+TurnPlan BenevolentPlayerStrategy::planTurn(const GameView& view)
 {
+	TurnPlan plan;
+
 	if (player->getTerritories().empty())
 	{
-		return false;
+		return plan;
 	}
 
-	bool orderIssued = false;
-	
-	if (player->getArmies() > 0) //Checks if there are armies to deploy
+	int undeployed = player->getArmies(); //The pool itself is only charged when the plan is issued
+
+	if (undeployed > 0) //Checks if there are armies to deploy
 	{
 		//Calculates armies to deploy to each territory in the defend list
-		list<Territory*> defendList = toDefend();
+		const vector<Territory*>& defendList = toDefend();
 		int armyAmount = player->getArmies() / defendList.size();
 		int armyRemainder = player->getArmies() % defendList.size();
 
 		//Issues Deploy orders to all territories in the defend list
-		while (!defendList.empty())
+		for (size_t i = 0; i < defendList.size(); i++)
 		{
-			if (defendList.size() == 1)
+			if (i == defendList.size() - 1)
 			{
 				armyAmount += armyRemainder;
 			}
 
-			player->issueOrder(new Deploy(player, defendList.front(), armyAmount));
-			defendList.pop_front();
-			orderIssued = true;
+			plan.add(new Deploy(player, defendList[i], armyAmount));
 		}
 
-		player->setArmies(0);
+		undeployed = 0;
 	}
 
-	Territory* strongest = nullptr;
-
-	//Finds the strongest territory owned
-	for (Territory* territory : player->getTerritories())
-	{
-		if (strongest == nullptr || strongest->getArmies() < territory->getArmies())
-		{
-			strongest = territory;
-		}
-	}
+	Territory* strongest = getStrongestTerritory(); //Finds the strongest territory owned
 
-	list<Territory*> defendList = toDefend();
+	const vector<Territory*>& defendList = toDefend();
+	size_t next = 0; //Next territory of the defend list to receive a card
 
-	//Plays all possible Reinforcement, Airlift, Blockade and Negotiate cards
-	for (const auto& card : player->getHand()->getCards())
+	//Plays all possible Reinforcement, Airlift, Blockade and Diplomacy cards (playing removes cards from the hand, so iterate over a copy of its types)
+	for (CardType type : player->getHand()->getTypes())
 	{
-		if (!defendList.empty() && strongest == defendList.front())
+		if (next < defendList.size() && strongest == defendList[next])
 		{
-			defendList.pop_front();
+			next++;
 		}
 
-		if (card->getTypeAsString() == "Reinforcement")
+		if (type == CardType::Reinforcement)
 		{
 			//Plays Reinforcement card on the weakest territory
-			if (defendList.empty())
+			if (next >= defendList.size())
 			{
-				defendList = toDefend();
+				next = 0;
 			}
 
-			CardPlayContext& context = CardPlayContext();
-			context.target = defendList.front();
+			CardPlayContext context;
+			context.target = defendList[next];
 			context.armies = 3;
 
-			card->play(player, deck, player->getHand(), context);
+			plan.playCard(player, type, context);
 
-			defendList.pop_front();
-			orderIssued = true;
+			next++;
 		}
-		else if (card->getTypeAsString() == "Airlift")
+		else if (type == CardType::Airlift)
 		{
 			//Plays Airlift card to move armies to the weakest territory
-			if (defendList.empty())
+			if (next >= defendList.size())
 			{
-				defendList = toDefend();
+				next = 0;
 			}
 
 			if (strongest != nullptr)
 			{
-				CardPlayContext& context = CardPlayContext();
+				CardPlayContext context;
 				context.source = strongest;
-				context.target = defendList.front();
+				context.target = defendList[next];
 				context.armies = strongest->getArmies() / 2;
 
-				card->play(player, deck, player->getHand(), context);
+				plan.playCard(player, type, context);
 
-				defendList.pop_front();
-				orderIssued = true;
+				next++;
 			}
 		}
-		else if (card->getTypeAsString() == "Blockade")
+		else if (type == CardType::Blockade)
 		{
 			//Plays Blockade card on the weakest territory
-			if (defendList.empty())
+			if (next >= defendList.size())
 			{
-				defendList = toDefend();
+				next = 0;
 			}
 
-			CardPlayContext& context = CardPlayContext();
-			context.target = defendList.front();
+			CardPlayContext context;
+			context.target = defendList[next];
 
-			card->play(player, deck, player->getHand(), context);
+			plan.playCard(player, type, context);
 
-			defendList.pop_front();
-			orderIssued = true;
+			next++;
 		}
-		else if (card->getTypeAsString() == "Negotiate")
+		else if (type == CardType::Diplomacy)
 		{
-			//Plays Negotiate card with an adjacent enemy player
-			CardPlayContext& context = CardPlayContext();
+			//Plays Diplomacy card with an adjacent enemy player
+			CardPlayContext context;
 			context.targetPlayer = player;
 
 			bool targetPlayerFound = false;
 
 			//Finds an adjacent enemy player
-			for (Territory* territory : player->getTerritories())
+			for (Territory* adjacentTerritory : player->getAttackable())
 			{
-				for (Territory* adjacentTerritory : territory->getAdjacentTerritories())
-				{
-					if (adjacentTerritory->getOwner() != player && adjacentTerritory->getOwner() != nullptr)
-					{
-						context.targetPlayer = adjacentTerritory->getOwner();
-						targetPlayerFound = true;
-						break;
-					}
-				}
-
-				if (targetPlayerFound)
+				if (adjacentTerritory->getOwner() != nullptr)
 				{
+					context.targetPlayer = adjacentTerritory->getOwner();
+					targetPlayerFound = true;
 					break;
 				}
 			}
 
 			if (targetPlayerFound)
 			{
-				card->play(player, deck, player->getHand(), context);
+				plan.playCard(player, type, context);
 
-				defendList.pop_front();
-				orderIssued = true;
+				next++;
 			}
 		}
 	}
 
-	list<Territory*> attackList = toAttack();
-	int armyAmount = player->getArmies() / (attackList.size() + 1);
+	const vector<Territory*>& attackList = toAttack();
+	int armyAmount = undeployed / (attackList.size() + 1);
 
 	//Issues Advance orders to all territories neighbouring the strongest territory
-	while (!attackList.empty())
+	for (size_t i = 0; i < attackList.size(); i++)
 	{
 		if (armyAmount == 0)
 		{
 			break;
 		}
 
-		player->issueOrder(new Advance(player, strongest, attackList.front(), armyAmount));
-		attackList.pop_front();
-		orderIssued = true;
+		plan.add(new Advance(player, strongest, attackList[i], armyAmount));
 	}
 
-	return orderIssued;
+	return plan;
 }
 
-list<Territory*> BenevolentPlayerStrategy::toDefend()
+const vector<Territory*>& BenevolentPlayerStrategy::toDefend()
 {
-	if (player->getTerritories().empty())
+	if (isCached(defendVersion))
 	{
-		return {};
+		return defendBuffer;
 	}
 
-	Territory* weakest = nullptr;
+	defendBuffer.clear();
 
-	//Finds the weakest territory owned
-	for (Territory* territory : player->getTerritories())
+	if (player->getTerritories().empty())
 	{
-		if (weakest == nullptr || weakest->getArmies() > territory->getArmies())
-		{
-			weakest = territory;
-		}
+		return defendBuffer;
 	}
 
-	list<Territory*> defendList;
-
-	//Finds all territories with the same army count as the weakest territory
-	for (Territory* territory : player->getTerritories())
-	{
-		if (weakest->getArmies() == territory->getArmies())
-		{
-			defendList.push_back(territory);
-		}
-	}
+	//Finds all territories tied for the fewest armies
+	player->getWeakestTerritories(defendBuffer);
 
-	return defendList;
+	return defendBuffer;
 }
 
-list<Territory*> BenevolentPlayerStrategy::toAttack()
+const vector<Territory*>& BenevolentPlayerStrategy::toAttack()
 {
-	if (player->getTerritories().empty())
+	if (isCached(attackVersion))
 	{
-		return {};
+		return attackBuffer;
 	}
 
-	Territory* strongest = nullptr;
+	attackBuffer.clear();
 
-	//Finds the strongest territory owned
-	for (Territory* territory : player->getTerritories())
+	if (player->getTerritories().empty())
 	{
-		if (strongest == nullptr || strongest->getArmies() < territory->getArmies())
-		{
-			strongest = territory;
-		}
+		return attackBuffer;
 	}
 
+	Territory* strongest = getStrongestTerritory(); //Finds the strongest territory owned
+
 	Territory* weakestNeighbour = nullptr;
 
 	//Finds the weakest neighbouring territory
@@ -870,8 +907,6 @@ list<Territory*> BenevolentPlayerStrategy::toAttack()
 		}
 	}
 
-	list<Territory*> advanceList;
-
 	//Finds all neighbouring territories with the same army count as the weakest neighbouring territory
 	if (weakestNeighbour != nullptr)
 	{
@@ -884,12 +919,17 @@ list<Territory*> BenevolentPlayerStrategy::toAttack()
 
 			if (weakestNeighbour->getArmies() == territory->getArmies())
 			{
-				advanceList.push_back(territory);
+				attackBuffer.push_back(territory);
 			}
 		}
 	}
 
-	return advanceList;
+	return attackBuffer;
+}
+
+StrategyKind BenevolentPlayerStrategy::getKind() const
+{
+	return StrategyKind::Benevolent;
 }
 
 string BenevolentPlayerStrategy::getStrategyString() const
@@ -897,6 +937,14 @@ string BenevolentPlayerStrategy::getStrategyString() const
 	return "Benevolent";
 }
 
+static const bool benevolentRegistered = StrategyRegistry::add(StrategyKind::Benevolent, "Benevolent", {}, true,
+	[](const StrategyParameters& parameters) { return new BenevolentPlayerStrategy(nullptr); });
+
+bool BenevolentPlayerStrategy::plansOnSnapshot() const
+{
+	return true;
+}
+
 //NeutralPlayerStrategy class implementation
 
 NeutralPlayerStrategy::NeutralPlayerStrategy(Player* player) : PlayerStrategy(player) {} //Parameterized Constructor
@@ -924,22 +972,29 @@ NeutralPlayerStrategy* NeutralPlayerStrategy::clone() //Clone function
 	return new NeutralPlayerStrategy(*this);
 }
 
-bool NeutralPlayerStrategy::issueOrder(Deck* deck)
+TurnPlan NeutralPlayerStrategy::planTurn(const GameView& view)
 {
 	//Issues no orders
-	return false;
+	return TurnPlan();
 }
 
-list<Territory*> NeutralPlayerStrategy::toDefend()
+const vector<Territory*>& NeutralPlayerStrategy::toDefend()
 {
 	//Defends no territories
-	return {};
+	defendBuffer.clear();
+	return defendBuffer;
 }
 
-list<Territory*> NeutralPlayerStrategy::toAttack()
+const vector<Territory*>& NeutralPlayerStrategy::toAttack()
 {
 	//Attacks no territories
-	return {};
+	attackBuffer.clear();
+	return attackBuffer;
+}
+
+StrategyKind NeutralPlayerStrategy::getKind() const
+{
+	return StrategyKind::Neutral;
 }
 
 string NeutralPlayerStrategy::getStrategyString() const
@@ -947,6 +1002,14 @@ string NeutralPlayerStrategy::getStrategyString() const
 	return "Neutral";
 }
 
+static const bool neutralRegistered = StrategyRegistry::add(StrategyKind::Neutral, "Neutral", {}, true,
+	[](const StrategyParameters& parameters) { return new NeutralPlayerStrategy(nullptr); });
+
+bool NeutralPlayerStrategy::plansOnSnapshot() const
+{
+	return true;
+}
+
 //CheaterPlayerStrategy class implementation
 
 CheaterPlayerStrategy::CheaterPlayerStrategy(Player* player) : PlayerStrategy(player) {} //Parameterized Constructor
@@ -974,73 +1037,1081 @@ CheaterPlayerStrategy* CheaterPlayerStrategy::clone() //Clone function
 	return new CheaterPlayerStrategy(*this);
 }
 
-bool CheaterPlayerStrategy::issueOrder(Deck* deck)
+TurnPlan CheaterPlayerStrategy::planTurn(const GameView& view)
 {
-	std::set<Territory*> toConquer;
+	std::vector<Territory*> toConquer;
 
-	// Collect all adjacent enemy territories
-	for (Territory* myTerr : player->getTerritories()) {
-		for(Territory* adjTerr : myTerr->getAdjacentTerritories()) {
-			if (adjTerr->getOwner() != player && !player->hasNegotiatedWith(adjTerr->getOwner()) && !adjTerr->getOwner()->hasNegotiatedWith(player)) {
-				toConquer.insert(adjTerr);
-			}
+	// Collect all adjacent enemy territories (copied, since conquering reshapes the attackable set)
+	for (Territory* adjTerr : player->getAttackable()) {
+		Player* owner = adjTerr->getOwner();
+		if (owner == nullptr || (!player->hasNegotiatedWith(owner) && !owner->hasNegotiatedWith(player))) {
+			toConquer.push_back(adjTerr);
 		}
 	}
 
 	if (toConquer.empty()) {
-		return false; // No territories to conquer
+		return TurnPlan(); // No territories to conquer
 	}
 
-	// Perform the conquest
-	for(Territory* enemyTerr : toConquer) {
+	// Conquer in map order, so the outcome does not depend on how the attackable set happened to be built
+	sort(toConquer.begin(), toConquer.end(), [](Territory* a, Territory* b) { return a->getId() < b->getId(); });
+
+	// Attacked Neutral players turn Aggressive
+	for (Territory* enemyTerr : toConquer) {
 		Player* previousOwner = enemyTerr->getOwner();
-		if (previousOwner != nullptr) {
-			if (previousOwner->getPlayerStrategy()->getStrategyString() == "Neutral") {
-				previousOwner->setPlayerStrategy(new AggressivePlayerStrategy(previousOwner));
-			}
+		if (previousOwner != nullptr && previousOwner->getPlayerStrategy()->getKind() == StrategyKind::Neutral) {
+			previousOwner->setPlayerStrategy(new AggressivePlayerStrategy(previousOwner));
+		}
+	}
+
+	// Perform the conquest as one batch transfer
+	player->acquireTerritories(toConquer);
+
+	ConsoleLog::out() << player->getName() << " (Cheater Player) has conquered " << toConquer.size() << " adjacent territories! \n" << std::endl;
+
+	// We don't issue traditional orders
+	return TurnPlan();
+}
+
+const vector<Territory*>& CheaterPlayerStrategy::toDefend()
+{
+	return player->getTerritories();
+}
 
-			previousOwner->removeTerritory(enemyTerr);
+const vector<Territory*>& CheaterPlayerStrategy::toAttack()
+{
+	if (isCached(attackVersion)) {
+		return attackBuffer;
+	}
+
+	attackBuffer.clear();
+
+	for (Territory* adjTerr : player->getAttackable()) {
+		if (adjTerr->getOwner() != nullptr) {
+			attackBuffer.push_back(adjTerr);
 		}
-		enemyTerr->setOwner(player);
-		player->addTerritory(enemyTerr);
 	}
 
-	std::cout << player->getName() << " (Cheater Player) has conquered " << toConquer.size() << " adjacent territories! \n" << std::endl;
+	return attackBuffer;
+}
 
-	// We don't issue traditional orders, return false
-	return false;
+StrategyKind CheaterPlayerStrategy::getKind() const
+{
+	return StrategyKind::Cheater;
+}
+
+string CheaterPlayerStrategy::getStrategyString() const
+{
+	return "Cheater";
 }
 
-list<Territory*> CheaterPlayerStrategy::toDefend()
+static const bool cheaterRegistered = StrategyRegistry::add(StrategyKind::Cheater, "Cheater", {}, true,
+	[](const StrategyParameters& parameters) { return new CheaterPlayerStrategy(nullptr); });
+
+//MCTSPlayerStrategy class implementation
+
+//How the search models each opponent, picked from its current strategy
+enum SeatPolicy : char
+{
+	RolloutSeat,
+	PassiveSeat,
+	CheaterSeat
+};
+
+MCTSStatistics MCTSPlayerStrategy::statistics = { 0, 0, 0.0 };
+
+//Seat 0 is the given player, the other owners on the board follow in board order
+static vector<Player*> collectSeats(const BoardTopology* topology, Player* player)
 {
-	list<Territory*> defendList;
-	for(Territory* territory : player->getTerritories())
+	vector<Player*> seats = { player };
+
+	for (int t = 0; t < topology->getTerritoryCount(); t++)
 	{
-		defendList.push_back(territory);
+		Player* owner = topology->getTerritory(t)->getOwner();
+
+		if (owner != nullptr && find(seats.begin(), seats.end(), owner) == seats.end())
+		{
+			seats.push_back(owner);
+		}
 	}
-	return defendList;
+
+	return seats;
+}
+
+static mutex statisticsMutex; //Several MCTS players may plan at the same time
+
+MCTSPlayerStrategy::MCTSPlayerStrategy(Player* player, int timeBudgetMs, int rolloutBudget, int threadCount) : PlayerStrategy(player) //Parameterized Constructor
+{
+	this->timeBudgetMs = timeBudgetMs;
+	this->rolloutBudget = rolloutBudget;
+	this->threadCount = threadCount > 0 ? threadCount : static_cast<int>(max(1u, thread::hardware_concurrency()));
+	seed = random_device{}();
+	maxDepth = 3;
+	rolloutRounds = 6;
+	maxActions = 12;
+	map = nullptr;
+	decisionCount = 0;
+	lastRolloutCount = 0;
 }
 
-list<Territory*> CheaterPlayerStrategy::toAttack()
+MCTSPlayerStrategy::MCTSPlayerStrategy(const MCTSPlayerStrategy& playerStrategy) : PlayerStrategy(playerStrategy) //Copy Constructor
 {
-	list<Territory*> attackList;
-	std::set<Territory*> uniqueAttackList; // To avoid duplicates
+	timeBudgetMs = playerStrategy.timeBudgetMs;
+	rolloutBudget = playerStrategy.rolloutBudget;
+	threadCount = playerStrategy.threadCount;
+	seed = playerStrategy.seed;
+	maxDepth = playerStrategy.maxDepth;
+	rolloutRounds = playerStrategy.rolloutRounds;
+	maxActions = playerStrategy.maxActions;
+	map = playerStrategy.map;
+	decisionCount = 0;
+	lastRolloutCount = 0;
+}
 
-	for(Territory* myTerr : player->getTerritories()) {
-		for(Territory* adjTerr : myTerr->getAdjacentTerritories()) {
-			if (adjTerr->getOwner() != player && adjTerr->getOwner() != nullptr) {
-				if(!uniqueAttackList.count(adjTerr)) {
-					uniqueAttackList.insert(adjTerr);
-					attackList.push_back(adjTerr);
-				}
+MCTSPlayerStrategy::~MCTSPlayerStrategy() = default; //Destructor (the pool joins its threads)
+
+MCTSPlayerStrategy& MCTSPlayerStrategy::operator = (const MCTSPlayerStrategy& playerStrategy) //Assignment Operator Overloading
+{
+	if (this != &playerStrategy)
+	{
+		PlayerStrategy::operator=(playerStrategy);
+		timeBudgetMs = playerStrategy.timeBudgetMs;
+		rolloutBudget = playerStrategy.rolloutBudget;
+		threadCount = playerStrategy.threadCount;
+		seed = playerStrategy.seed;
+		maxDepth = playerStrategy.maxDepth;
+		rolloutRounds = playerStrategy.rolloutRounds;
+		maxActions = playerStrategy.maxActions;
+		map = playerStrategy.map;
+		topology.reset();
+		pool.reset();
+	}
+
+	return *this;
+}
+
+ostream& operator << (ostream& output, const MCTSPlayerStrategy& playerStrategy) //Stream Insertion Operator Overloading
+{
+	output << "Strategy Type: MCTS (" << playerStrategy.timeBudgetMs << " ms, " << playerStrategy.threadCount << " threads)\n";
+	return output;
+}
+
+MCTSPlayerStrategy* MCTSPlayerStrategy::clone() //Clone function
+{
+	return new MCTSPlayerStrategy(*this);
+}
+
+TurnPlan MCTSPlayerStrategy::planTurn(const GameView& view)
+{
+	TurnPlan plan;
+	const TurnBudget& budget = view.getBudget();
+
+	if (player->getTerritories().empty())
+	{
+		return plan;
+	}
+
+	auto start = chrono::steady_clock::now();
+
+	//Builds the board layout once and rebuilds it only if it no longer covers the player's territories
+	if (!topology || topology->getTerritoryIndex(player->getTerritories().front()) < 0)
+	{
+		topology.reset(map != nullptr ? new BoardTopology(map) : new BoardTopology(player->getTerritories()));
+	}
+
+	vector<Player*> seats = collectSeats(topology.get(), player);
+	vector<char> seatPolicies = { RolloutSeat };
+
+	for (size_t s = 1; s < seats.size(); s++)
+	{
+		StrategyKind kind = seats[s]->getPlayerStrategy()->getKind();
+		seatPolicies.push_back(kind == StrategyKind::Neutral ? PassiveSeat : kind == StrategyKind::Cheater ? CheaterSeat : RolloutSeat);
+	}
+
+	BoardState root = BoardState::fromGame(topology.get(), seats);
+	int reinforcements = player->getArmies();
+	vector<TurnAction> rootActions = TurnSimulator::candidateActions(root, 0, reinforcements, maxActions);
+
+	if (rootActions.empty())
+	{
+		return plan;
+	}
+
+	size_t best = 0;
+	lastRolloutCount = 0;
+
+	if (rootActions.size() > 1)
+	{
+		if (!pool)
+		{
+			pool.reset(new ThreadPool(threadCount));
+		}
+
+		//Stops at the strategy's own budget or the turn's, whichever comes first; a tree that got no rollouts plays the first candidate
+		TurnBudget decision = budget.limitedTo(chrono::milliseconds(timeBudgetMs));
+		atomic<int> rolloutsPlayed(0);
+		vector<SearchResult> results(threadCount);
+
+		pool->parallelFor(threadCount, [&](size_t i) {
+			unsigned int threadSeed = seed + static_cast<unsigned int>(decisionCount * 7919 + i);
+			results[i] = search(root, rootActions, reinforcements, seatPolicies, threadSeed, decision, rolloutsPlayed);
+		});
+
+		//Merges the root statistics of every tree and plays the most visited action
+		vector<int> visits(rootActions.size(), 0);
+		for (const SearchResult& result : results)
+		{
+			for (size_t a = 0; a < rootActions.size(); a++)
+			{
+				visits[a] += result.visits[a];
+				lastRolloutCount += result.visits[a];
 			}
 		}
+
+		best = max_element(visits.begin(), visits.end()) - visits.begin();
+	}
+
+	//Turns the chosen macro action into real orders
+	for (const SimOrder& order : TurnSimulator::planTurn(root, 0, rootActions[best], reinforcements))
+	{
+		Territory* target = topology->getTerritory(order.target);
+
+		if (order.source < 0)
+		{
+			plan.add(new Deploy(player, target, order.armies));
+		}
+		else
+		{
+			plan.add(new Advance(player, topology->getTerritory(order.source), target, order.armies));
+		}
 	}
 
-	return attackList;
+	decisionCount++;
+
+	lock_guard<mutex> lock(statisticsMutex);
+	statistics.decisions++;
+	statistics.rollouts += lastRolloutCount;
+	statistics.seconds += chrono::duration<double>(chrono::steady_clock::now() - start).count();
+
+	return plan;
 }
 
-string CheaterPlayerStrategy::getStrategyString() const
+MCTSPlayerStrategy::SearchResult MCTSPlayerStrategy::search(const BoardState& root, const vector<TurnAction>& rootActions, int reinforcements, const vector<char>& seatPolicies,
+	unsigned int threadSeed, const TurnBudget& budget, atomic<int>& rolloutsPlayed) const
 {
-	return "Cheater";
-}
\ No newline at end of file
+	//Open-loop tree: a node is a sequence of own macro actions, the board under it is re-sampled on every visit
+	struct Node
+	{
+		TurnAction action;
+		vector<int> children;
+		int visits;
+		double value;
+		bool expanded;
+	};
+
+	const double exploration = 0.5;
+	mt19937 gen(threadSeed);
+
+	vector<Node> tree;
+	tree.push_back({ { -1, -1, -1 }, {}, 0, 0.0, true });
+	for (const TurnAction& action : rootActions)
+	{
+		tree[0].children.push_back(static_cast<int>(tree.size()));
+		tree.push_back({ action, {}, 0, 0.0, false });
+	}
+
+	vector<int> path;
+
+	while (!budget.expired())
+	{
+		//Claims a rollout from the shared budget
+		if (rolloutsPlayed.fetch_add(1) >= rolloutBudget && rolloutBudget > 0)
+		{
+			break;
+		}
+
+		BoardState state = root; //The cheap clone
+		path.assign(1, 0);
+		int node = 0;
+		int depth = 0;
+		bool terminal = false;
+
+		//Selection and expansion over own turns, opponents move with their rollout policies in between
+		while (!terminal)
+		{
+			int turnReinforcements = depth == 0 ? reinforcements : state.getReinforcements(0);
+
+			if (!tree[node].expanded)
+			{
+				if (tree[node].visits == 0 || depth >= maxDepth)
+				{
+					break;
+				}
+
+				tree[node].expanded = true;
+				for (const TurnAction& action : TurnSimulator::candidateActions(state, 0, turnReinforcements, maxActions))
+				{
+					tree[node].children.push_back(static_cast<int>(tree.size()));
+					tree.push_back({ action, {}, 0, 0.0, false });
+				}
+			}
+
+			if (tree[node].children.empty())
+			{
+				break;
+			}
+
+			//UCB1 over the children
+			int chosen = -1;
+			double bestScore = -1.0;
+			double logVisits = log(static_cast<double>(max(1, tree[node].visits)));
+
+			for (int child : tree[node].children)
+			{
+				if (tree[child].visits == 0)
+				{
+					chosen = child;
+					break;
+				}
+
+				double score = tree[child].value / tree[child].visits + exploration * sqrt(logVisits / tree[child].visits);
+				if (score > bestScore)
+				{
+					bestScore = score;
+					chosen = child;
+				}
+			}
+
+			TurnSimulator::applyPlan(state, 0, TurnSimulator::planTurn(state, 0, tree[chosen].action, turnReinforcements), gen);
+			playOpponents(state, seatPolicies, gen);
+
+			path.push_back(chosen);
+			node = chosen;
+			depth++;
+			terminal = state.getWinner() >= 0 || state.getTerritoryCount(0) == 0;
+		}
+
+		//Rollout
+		for (int round = 0; round < rolloutRounds && !terminal; round++)
+		{
+			TurnSimulator::playRolloutTurn(state, 0, gen);
+			playOpponents(state, seatPolicies, gen);
+			terminal = state.getWinner() >= 0 || state.getTerritoryCount(0) == 0;
+		}
+
+		//Backpropagation
+		double reward = TurnSimulator::evaluate(state, 0);
+		for (int visited : path)
+		{
+			tree[visited].visits++;
+			tree[visited].value += reward;
+		}
+	}
+
+	SearchResult result;
+	for (int child : tree[0].children)
+	{
+		result.visits.push_back(tree[child].visits);
+		result.values.push_back(tree[child].value);
+	}
+
+	return result;
+}
+
+void MCTSPlayerStrategy::playOpponents(BoardState& state, const vector<char>& seatPolicies, mt19937& gen) const
+{
+	for (int seat = 1; seat < state.getSeatCount(); seat++)
+	{
+		if (state.getTerritoryCount(seat) == 0)
+		{
+			continue;
+		}
+
+		if (seatPolicies[seat] == RolloutSeat)
+		{
+			TurnSimulator::playRolloutTurn(state, seat, gen);
+		}
+		else if (seatPolicies[seat] == CheaterSeat)
+		{
+			TurnSimulator::playCheaterTurn(state, seat);
+		}
+	}
+}
+
+const vector<Territory*>& MCTSPlayerStrategy::toDefend()
+{
+	return player->getFrontier().empty() ? player->getTerritories() : player->getFrontier();
+}
+
+const vector<Territory*>& MCTSPlayerStrategy::toAttack()
+{
+	if (isCached(attackVersion))
+	{
+		return attackBuffer;
+	}
+
+	attackBuffer.clear();
+
+	for (Territory* territory : player->getAttackable())
+	{
+		if (territory->getOwner() != nullptr)
+		{
+			attackBuffer.push_back(territory);
+		}
+	}
+
+	return attackBuffer;
+}
+
+StrategyKind MCTSPlayerStrategy::getKind() const
+{
+	return StrategyKind::MCTS;
+}
+
+string MCTSPlayerStrategy::getStrategyString() const
+{
+	return "MCTS";
+}
+
+//budget = milliseconds per decision, rollouts = rollout limit (0 = none), threads = search threads (0 = all cores)
+static const bool mctsRegistered = StrategyRegistry::add(StrategyKind::MCTS, "MCTS", { "budget", "rollouts", "threads", "seed" }, true,
+	[](const StrategyParameters& parameters)
+	{
+		MCTSPlayerStrategy* strategy = new MCTSPlayerStrategy(nullptr, parameters.get("budget", 50), parameters.get("rollouts", 0), parameters.get("threads", 0));
+		if (parameters.has("seed"))
+		{
+			strategy->setSeed(static_cast<unsigned int>(parameters.get("seed", 0)));
+		}
+		return strategy;
+	});
+
+bool MCTSPlayerStrategy::plansOnSnapshot() const
+{
+	return true;
+}
+
+void MCTSPlayerStrategy::setMap(Map* map)
+{
+	this->map = map;
+	topology.reset();
+}
+
+void MCTSPlayerStrategy::setBudget(int timeBudgetMs, int rolloutBudget)
+{
+	this->timeBudgetMs = timeBudgetMs;
+	this->rolloutBudget = rolloutBudget;
+}
+
+void MCTSPlayerStrategy::setSeed(unsigned int seed)
+{
+	this->seed = seed;
+}
+
+int MCTSPlayerStrategy::getLastRolloutCount() const
+{
+	return lastRolloutCount;
+}
+
+MCTSStatistics MCTSPlayerStrategy::getStatistics()
+{
+	lock_guard<mutex> lock(statisticsMutex);
+	return statistics;
+}
+
+void MCTSPlayerStrategy::resetStatistics()
+{
+	lock_guard<mutex> lock(statisticsMutex);
+	statistics = { 0, 0, 0.0 };
+}
+
+//HeuristicParameters class implementation
+
+//Spec key, default and range of each weight, in HeuristicParameters::Index order
+struct HeuristicWeight
+{
+	string name;
+	int defaultValue;
+	int minimum;
+	int maximum;
+};
+
+static const HeuristicWeight heuristicWeights[HeuristicParameters::Count] =
+{
+	{ "attackOdds", 60, 30, 95 },
+	{ "deployShare", 70, 0, 100 },
+	{ "maxTargets", 2, 1, 6 },
+	{ "reserve", 1, 0, 5 },
+	{ "cardArmies", 3, 0, 5 },
+	{ "airliftShare", 50, 0, 100 },
+	{ "gatherShare", 100, 0, 100 }
+};
+
+HeuristicParameters::HeuristicParameters() //Default Constructor
+{
+	for (int i = 0; i < Count; i++)
+	{
+		values[i] = heuristicWeights[i].defaultValue;
+	}
+}
+
+const string& HeuristicParameters::getName(int index)
+{
+	return heuristicWeights[index].name;
+}
+
+int HeuristicParameters::getDefault(int index)
+{
+	return heuristicWeights[index].defaultValue;
+}
+
+int HeuristicParameters::getMinimum(int index)
+{
+	return heuristicWeights[index].minimum;
+}
+
+int HeuristicParameters::getMaximum(int index)
+{
+	return heuristicWeights[index].maximum;
+}
+
+vector<string> HeuristicParameters::getNames()
+{
+	vector<string> names;
+	for (int i = 0; i < Count; i++)
+	{
+		names.push_back(heuristicWeights[i].name);
+	}
+	return names;
+}
+
+int HeuristicParameters::get(int index) const
+{
+	return values[index];
+}
+
+void HeuristicParameters::set(int index, int value)
+{
+	values[index] = min(max(value, heuristicWeights[index].minimum), heuristicWeights[index].maximum);
+}
+
+string HeuristicParameters::toSpec() const
+{
+	ostringstream spec;
+	spec << "Heuristic";
+	for (int i = 0; i < Count; i++)
+	{
+		spec << ":" << heuristicWeights[i].name << "=" << values[i];
+	}
+	return spec.str();
+}
+
+//HeuristicPlayerStrategy class implementation
+
+HeuristicPlayerStrategy::HeuristicPlayerStrategy(Player* player, const HeuristicParameters& parameters) : PlayerStrategy(player), parameters(parameters) {} //Parameterized Constructor
+
+HeuristicPlayerStrategy::HeuristicPlayerStrategy(const HeuristicPlayerStrategy& playerStrategy) : PlayerStrategy(playerStrategy), parameters(playerStrategy.parameters) {} //Copy Constructor
+
+HeuristicPlayerStrategy& HeuristicPlayerStrategy::operator = (const HeuristicPlayerStrategy& playerStrategy) //Assignment Operator Overloading
+{
+	if (this != &playerStrategy)
+	{
+		PlayerStrategy::operator=(playerStrategy);
+		parameters = playerStrategy.parameters;
+	}
+
+	return *this;
+}
+
+ostream& operator << (ostream& output, const HeuristicPlayerStrategy& playerStrategy) //Stream Insertion Operator Overloading
+{
+	output << "Strategy Type: Heuristic (" << playerStrategy.parameters.toSpec() << ")\n";
+	return output;
+}
+
+HeuristicPlayerStrategy* HeuristicPlayerStrategy::clone() //Clone function
+{
+	return new HeuristicPlayerStrategy(*this);
+}
+
+TurnPlan HeuristicPlayerStrategy::planTurn(const GameView& view)
+{
+	TurnPlan plan;
+
+	if (player->getTerritories().empty())
+	{
+		return plan;
+	}
+
+	int reserve = parameters.get(HeuristicParameters::Reserve);
+	double attackOdds = parameters.get(HeuristicParameters::AttackOdds) / 100.0;
+
+	Territory* front = toDefend().front(); //Main front, every deploy order executes before it attacks
+
+	//Finds the weakest frontier territory to shore up
+	Territory* weakest = nullptr;
+	for (Territory* territory : player->getFrontier())
+	{
+		if (weakest == nullptr || territory->getArmies() < weakest->getArmies())
+		{
+			weakest = territory;
+		}
+	}
+
+	int frontArmies = front->getArmies();
+	int weakestArmies = weakest != nullptr ? weakest->getArmies() : 0;
+
+	if (player->getArmies() > 0) //Checks if there are armies to deploy
+	{
+		int reinforcements = player->getArmies();
+		int frontShare = (weakest == nullptr || weakest == front) ? reinforcements : reinforcements * parameters.get(HeuristicParameters::DeployShare) / 100;
+
+		if (frontShare > 0)
+		{
+			plan.add(new Deploy(player, front, frontShare));
+			frontArmies += frontShare;
+		}
+
+		if (reinforcements - frontShare > 0)
+		{
+			plan.add(new Deploy(player, weakest, reinforcements - frontShare));
+			weakestArmies += reinforcements - frontShare;
+		}
+	}
+
+	//Playing removes cards from the hand, so iterate over a copy of its types
+	Territory* airliftSource = nullptr;
+	int airlifted = 0; //Armies promised to Airlift orders, kept out of the gathering advances
+
+	for (CardType type : player->getHand()->getTypes())
+	{
+		CardPlayContext context;
+
+		if (type == CardType::Reinforcement && parameters.get(HeuristicParameters::CardArmies) > 0)
+		{
+			//Reinforces the main front (card deploys also execute before any attack)
+			context.target = front;
+			context.armies = parameters.get(HeuristicParameters::CardArmies);
+			frontArmies += context.armies;
+		}
+		else if (type == CardType::Airlift)
+		{
+			//Brings armies from the strongest territory to the main front, unless that would strip another front
+			Territory* source = getStrongestTerritory();
+			if (source == front || source->getEnemyNeighbourCount() > 0)
+			{
+				continue;
+			}
+
+			context.source = source;
+			context.target = front;
+			context.armies = (source->getArmies() - airlifted) * parameters.get(HeuristicParameters::AirliftShare) / 100;
+			if (context.armies <= 0)
+			{
+				continue;
+			}
+
+			airliftSource = source;
+			airlifted += context.armies;
+		}
+		else if (type == CardType::Bomb)
+		{
+			//Bombs the strongest enemy next to the main front
+			for (Territory* target : toAttack())
+			{
+				if (context.target == nullptr || context.target->getArmies() < target->getArmies())
+				{
+					context.target = target;
+				}
+			}
+
+			if (context.target == nullptr)
+			{
+				continue;
+			}
+		}
+		else
+		{
+			continue; //Keeps Blockade (gives the territory away) and Diplomacy (would stop its own attacks)
+		}
+
+		plan.playCard(player, type, context);
+	}
+
+	//Attacks the weakest targets next to the main front with just enough armies to reach the wanted odds
+	int available = frontArmies - reserve;
+	int attacks = 0;
+
+	for (Territory* target : toAttack())
+	{
+		if (attacks >= parameters.get(HeuristicParameters::MaxTargets) || available <= 0)
+		{
+			break;
+		}
+
+		int needed = BattleOdds::attackersNeeded(target->getArmies(), attackOdds, available);
+		if (needed < 0)
+		{
+			break; //Targets only get stronger from here
+		}
+
+		plan.add(new Advance(player, front, target, needed));
+		available -= needed;
+		attacks++;
+	}
+
+	//Every other frontier territory takes a shot at its weakest enemy neighbour when the odds allow
+	for (Territory* territory : player->getFrontier())
+	{
+		if (territory == front)
+		{
+			continue;
+		}
+
+		Territory* target = nullptr;
+		for (Territory* adjacent : territory->getAdjacentTerritories())
+		{
+			Player* owner = adjacent->getOwner();
+			if (owner != player && !(owner != nullptr && player->hasNegotiatedWith(owner)) && (target == nullptr || adjacent->getArmies() < target->getArmies()))
+			{
+				target = adjacent;
+			}
+		}
+
+		int spare = (territory == weakest ? weakestArmies : territory->getArmies()) - reserve;
+		int needed = target != nullptr ? BattleOdds::attackersNeeded(target->getArmies(), attackOdds, spare) : -1;
+
+		if (needed > 0)
+		{
+			plan.add(new Advance(player, territory, target, needed));
+		}
+	}
+
+	planGatherOrders(plan, airliftSource, airlifted);
+	return plan;
+}
+
+void HeuristicPlayerStrategy::planGatherOrders(TurnPlan& plan, Territory* airliftSource, int airlifted)
+{
+	int share = parameters.get(HeuristicParameters::GatherShare);
+	const vector<Territory*>& territories = player->getTerritories();
+
+	if (share == 0 || player->getFrontier().empty() || player->getFrontier().size() == territories.size())
+	{
+		return;
+	}
+
+	//Steps from every owned territory to the nearest frontier territory, found with one breadth-first search from the whole frontier
+	int maxId = 0;
+	for (Territory* territory : territories)
+	{
+		maxId = max(maxId, territory->getId());
+	}
+
+	vector<int> distance(maxId + 1, -1);
+	deque<Territory*> pending;
+
+	for (Territory* territory : player->getFrontier())
+	{
+		distance[territory->getId()] = 0;
+		pending.push_back(territory);
+	}
+
+	while (!pending.empty())
+	{
+		Territory* territory = pending.front();
+		pending.pop_front();
+
+		for (Territory* adjacent : territory->getAdjacentTerritories())
+		{
+			if (adjacent->getOwner() == player && distance[adjacent->getId()] < 0)
+			{
+				distance[adjacent->getId()] = distance[territory->getId()] + 1;
+				pending.push_back(adjacent);
+			}
+		}
+	}
+
+	for (Territory* territory : territories)
+	{
+		int steps = distance[territory->getId()];
+		int armies = (territory->getArmies() - (territory == airliftSource ? airlifted : 0) - 1) * share / 100;
+
+		if (steps <= 0 || armies <= 0)
+		{
+			continue;
+		}
+
+		for (Territory* adjacent : territory->getAdjacentTerritories())
+		{
+			if (adjacent->getOwner() == player && distance[adjacent->getId()] == steps - 1)
+			{
+				plan.add(new Advance(player, territory, adjacent, armies));
+				break;
+			}
+		}
+	}
+}
+
+const vector<Territory*>& HeuristicPlayerStrategy::toDefend()
+{
+	if (isCached(defendVersion))
+	{
+		return defendBuffer;
+	}
+
+	defendBuffer.clear();
+
+	if (player->getTerritories().empty())
+	{
+		return defendBuffer;
+	}
+
+	//The main front is the strongest territory with enemy neighbours, falling back to the strongest overall
+	defendBuffer.push_back(player->getFrontier().empty() ? getStrongestTerritory() : player->getStrongestFrontierTerritory());
+	return defendBuffer;
+}
+
+const vector<Territory*>& HeuristicPlayerStrategy::toAttack()
+{
+	if (isCached(attackVersion))
+	{
+		return attackBuffer;
+	}
+
+	attackBuffer.clear();
+
+	if (player->getTerritories().empty())
+	{
+		return attackBuffer;
+	}
+
+	//Enemies next to the main front that are not protected by a negotiation, weakest first (map order breaks ties)
+	for (Territory* adjacent : toDefend().front()->getAdjacentTerritories())
+	{
+		Player* owner = adjacent->getOwner();
+		if (owner != player && !(owner != nullptr && player->hasNegotiatedWith(owner)))
+		{
+			attackBuffer.push_back(adjacent);
+		}
+	}
+
+	sort(attackBuffer.begin(), attackBuffer.end(), [](Territory* a, Territory* b)
+		{
+			return a->getArmies() != b->getArmies() ? a->getArmies() < b->getArmies() : a->getId() < b->getId();
+		});
+
+	return attackBuffer;
+}
+
+bool HeuristicPlayerStrategy::plansOnSnapshot() const
+{
+	return true;
+}
+
+StrategyKind HeuristicPlayerStrategy::getKind() const
+{
+	return StrategyKind::Heuristic;
+}
+
+string HeuristicPlayerStrategy::getStrategyString() const
+{
+	return "Heuristic";
+}
+
+const HeuristicParameters& HeuristicPlayerStrategy::getParameters() const
+{
+	return parameters;
+}
+
+//Every HeuristicParameters weight can be set by name, e.g. "Heuristic:attackOdds=75:maxTargets=3"
+static const bool heuristicRegistered = StrategyRegistry::add(StrategyKind::Heuristic, "Heuristic", HeuristicParameters::getNames(), true,
+	[](const StrategyParameters& parameters)
+	{
+		HeuristicParameters weights;
+		for (int i = 0; i < HeuristicParameters::Count; i++)
+		{
+			weights.set(i, parameters.get(HeuristicParameters::getName(i), HeuristicParameters::getDefault(i)));
+		}
+		return new HeuristicPlayerStrategy(nullptr, weights);
+	});
+
+//GreedyPlayerStrategy class implementation
+
+GreedyPlayerStrategy::GreedyPlayerStrategy(Player* player, int samples) : PlayerStrategy(player) //Parameterized Constructor
+{
+	this->samples = max(1, samples);
+	seed = random_device{}();
+	maxActions = 12;
+	map = nullptr;
+	decisionCount = 0;
+}
+
+GreedyPlayerStrategy::GreedyPlayerStrategy(const GreedyPlayerStrategy& playerStrategy) : PlayerStrategy(playerStrategy) //Copy Constructor
+{
+	samples = playerStrategy.samples;
+	seed = playerStrategy.seed;
+	maxActions = playerStrategy.maxActions;
+	map = playerStrategy.map;
+	decisionCount = 0;
+}
+
+GreedyPlayerStrategy::~GreedyPlayerStrategy() = default; //Destructor (BoardEvaluator is complete here)
+
+GreedyPlayerStrategy& GreedyPlayerStrategy::operator = (const GreedyPlayerStrategy& playerStrategy) //Assignment Operator Overloading
+{
+	if (this != &playerStrategy)
+	{
+		PlayerStrategy::operator=(playerStrategy);
+		samples = playerStrategy.samples;
+		seed = playerStrategy.seed;
+		maxActions = playerStrategy.maxActions;
+		map = playerStrategy.map;
+		evaluator.reset();
+		topology.reset();
+	}
+
+	return *this;
+}
+
+ostream& operator << (ostream& output, const GreedyPlayerStrategy& playerStrategy) //Stream Insertion Operator Overloading
+{
+	output << "Strategy Type: Greedy (" << playerStrategy.samples << " samples per turn)\n";
+	return output;
+}
+
+GreedyPlayerStrategy* GreedyPlayerStrategy::clone() //Clone function
+{
+	return new GreedyPlayerStrategy(*this);
+}
+
+TurnPlan GreedyPlayerStrategy::planTurn(const GameView& view)
+{
+	TurnPlan plan;
+	const TurnBudget& budget = view.getBudget();
+
+	if (player->getTerritories().empty())
+	{
+		return plan;
+	}
+
+	//Builds the board layout once and rebuilds it only if it no longer covers the player's territories
+	if (!topology || topology->getTerritoryIndex(player->getTerritories().front()) < 0)
+	{
+		evaluator.reset();
+		topology.reset(map != nullptr ? new BoardTopology(map) : new BoardTopology(player->getTerritories()));
+		evaluator.reset(new BoardEvaluator(topology.get()));
+	}
+
+	vector<Player*> seats = collectSeats(topology.get(), player);
+	if (seats.size() > static_cast<size_t>(BoardEvaluator::MaxSeats))
+	{
+		seats.resize(BoardEvaluator::MaxSeats); //Further owners count as unowned territory
+	}
+
+	BoardState root = BoardState::fromGame(topology.get(), seats);
+	int reinforcements = player->getArmies();
+	vector<TurnAction> actions = TurnSimulator::candidateActions(root, 0, reinforcements, maxActions);
+
+	if (actions.empty())
+	{
+		return plan;
+	}
+
+	//Every candidate draws its battles from the same seeds, so differences come mostly from the plans
+	vector<vector<SimOrder>> plans;
+	size_t best = 0;
+	double bestValue = -numeric_limits<double>::infinity();
+	double scores[BoardEvaluator::MaxSeats];
+
+	//Candidates come strongest first, so running out of time only drops the least promising ones
+	for (size_t a = 0; a < actions.size() && (a == 0 || !budget.expired()); a++)
+	{
+		plans.push_back(TurnSimulator::planTurn(root, 0, actions[a], reinforcements));
+
+		double value = 0.0;
+		for (int sample = 0; sample < samples; sample++)
+		{
+			mt19937 gen(seed + static_cast<unsigned int>(decisionCount * 7919 + sample));
+			BoardState state = root;
+			TurnSimulator::applyPlan(state, 0, plans[a], gen);
+
+			evaluator->evaluate(state, scores);
+			double strongestOpponent = state.getSeatCount() > 1 ? *max_element(scores + 1, scores + state.getSeatCount()) : 0.0;
+			value += scores[0] - strongestOpponent;
+		}
+
+		if (value > bestValue)
+		{
+			bestValue = value;
+			best = a;
+		}
+	}
+
+	//Turns the chosen plan into real orders
+	for (const SimOrder& order : plans[best])
+	{
+		Territory* target = topology->getTerritory(order.target);
+
+		if (order.source < 0)
+		{
+			plan.add(new Deploy(player, target, order.armies));
+		}
+		else
+		{
+			plan.add(new Advance(player, topology->getTerritory(order.source), target, order.armies));
+		}
+	}
+
+	decisionCount++;
+
+	return plan;
+}
+
+const vector<Territory*>& GreedyPlayerStrategy::toDefend()
+{
+	return player->getFrontier().empty() ? player->getTerritories() : player->getFrontier();
+}
+
+const vector<Territory*>& GreedyPlayerStrategy::toAttack()
+{
+	return player->getAttackable();
+}
+
+bool GreedyPlayerStrategy::plansOnSnapshot() const
+{
+	return true;
+}
+
+StrategyKind GreedyPlayerStrategy::getKind() const
+{
+	return StrategyKind::Greedy;
+}
+
+string GreedyPlayerStrategy::getStrategyString() const
+{
+	return "Greedy";
+}
+
+void GreedyPlayerStrategy::setMap(Map* map)
+{
+	this->map = map;
+	evaluator.reset();
+	topology.reset();
+}
+
+void GreedyPlayerStrategy::setSeed(unsigned int seed)
+{
+	this->seed = seed;
+}
+
+//samples = battle outcomes drawn per candidate turn, seed = fixes those outcomes for repeatable games
+static const bool greedyRegistered = StrategyRegistry::add(StrategyKind::Greedy, "Greedy", { "samples", "seed" }, true,
+	[](const StrategyParameters& parameters)
+	{
+		GreedyPlayerStrategy* strategy = new GreedyPlayerStrategy(nullptr, parameters.get("samples", 4));
+		if (parameters.has("seed"))
+		{
+			strategy->setSeed(static_cast<unsigned int>(parameters.get("seed", 0)));
+		}
+		return strategy;
+	});
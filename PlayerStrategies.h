@@ -1,7 +1,12 @@
 #pragma once
 
 #include <iostream>
-#include <list>
+#include <vector>
+#include <memory>
+#include <atomic>
+#include <chrono>
+#include "Simulation.h"
+#include "TurnBudget.h"
 
 using namespace std;
 
@@ -10,31 +15,65 @@ class Territory;
 class Player;
 class Order;
 class Deck;
+class Map;
+class ThreadPool;
+class BoardEvaluator;
+class TurnPlan;
+class GameView;
+
+//Identity of a strategy, compared instead of strategy strings wherever the game needs to know who it is dealing with
+enum class StrategyKind
+{
+	Human,
+	Aggressive,
+	Benevolent,
+	Neutral,
+	Cheater,
+	MCTS,
+	Heuristic,
+	Greedy
+};
 
 class PlayerStrategy
 {
 	public:
 		PlayerStrategy(Player* player); //Parameterized Constructor
 		PlayerStrategy(const PlayerStrategy& playerStrategy); //Copy Constructor
-		~PlayerStrategy() = default; //Destructor
+		virtual ~PlayerStrategy() = default; //Destructor (virtual so derived strategies release their resources)
 		PlayerStrategy& operator = (const PlayerStrategy& playerStrategy); //Assignment Operator Overloading
 		friend ostream& operator << (ostream& output, const PlayerStrategy& playerStrategy); //Stream Insertion Operator Overloading
 		virtual PlayerStrategy* clone() = 0; //Pure virtual clone function
 
-		virtual bool issueOrder(Deck* deck) = 0; //Returns if an order was issued
-		virtual list<Territory*> toDefend() = 0; //Returns a list of territories to defend
-		virtual list<Territory*> toAttack() = 0; //Returns a list of territories to attack
+		virtual bool issueOrder(Deck* deck); //Returns if an order was issued; by default plans the whole turn and issues it in one step
+		virtual bool issueOrderWithin(Deck* deck, const TurnBudget& budget); //Same, planning within the budget (anytime planners return the best turn found by its deadline or cancellation)
+		virtual TurnPlan planTurn(const GameView& view); //Returns the whole turn's orders and card plays without issuing them (empty by default)
+		virtual const vector<Territory*>& toDefend() = 0; //Returns a read-only view of territories to defend
+		virtual const vector<Territory*>& toAttack() = 0; //Returns a read-only view of territories to attack
+		virtual bool plansOnSnapshot() const; //Returns if planTurn only reads the board and the player (deploys are charged to the pool when the plan is issued), so it can run alongside other such players
 
 		//Mutator Methods (Setters)
 		void setPlayer(Player* player);
+		virtual void setMap(Map* map); //Called once the game's map is known (ignored by default)
 
 		//Accessor Methods (Getters)
 		Player* getPlayer(); //Returns player
+		virtual StrategyKind getKind() const = 0; //Returns the strategy's kind
 		virtual string getStrategyString() const; //Returns the strategy as a string
 
 	protected:
-		//Data member
+		//Data members
 		Player* player;
+		vector<Territory*> defendBuffer; //Reused storage behind toDefend() views
+		vector<Territory*> attackBuffer; //Reused storage behind toAttack() views
+
+		//Per-turn query cache, keyed by the player's state version
+		bool isCached(unsigned long& version); //Returns if a cached result is current, otherwise stamps it as computed now
+		void invalidateCache();
+		Territory* getStrongestTerritory(); //Returns the first owned territory with the most armies (O(1), kept by the player's heaps)
+		Territory* getWeakestTerritory(); //Returns the first owned territory with the fewest armies (O(1), kept by the player's heaps)
+
+		unsigned long defendVersion;
+		unsigned long attackVersion;
 };
 
 class HumanPlayerStrategy : public PlayerStrategy
@@ -47,28 +86,38 @@ class HumanPlayerStrategy : public PlayerStrategy
 		friend ostream& operator << (ostream& output, const HumanPlayerStrategy& playerStrategy); //Stream Insertion Operator Overloading
 		HumanPlayerStrategy* clone() override; //Clone function
 
-		bool issueOrder(Deck* deck) override; //Returns if an order was issued
-		list<Territory*> toDefend() override; //Returns a list of territories to defend
-		list<Territory*> toAttack() override; //Returns a list of territories to attack
+		bool issueOrder(Deck* deck) override; //Asks for one order at a time
+		bool issueOrderWithin(Deck* deck, const TurnBudget& budget) override; //Humans are not timed
+		const vector<Territory*>& toDefend() override; //Returns a read-only view of territories to defend
+		const vector<Territory*>& toAttack() override; //Returns a read-only view of territories to attack
 
+		StrategyKind getKind() const override; //Returns StrategyKind::Human
 		string getStrategyString() const override; //Returns the strategy as a string
 };
 
 class AggressivePlayerStrategy : public PlayerStrategy
 {
 	public:
-		AggressivePlayerStrategy(Player* player); //Parameterized Constructor
+		AggressivePlayerStrategy(Player* player, int split = 0); //Parameterized Constructor (split = most targets an attack is divided between, 0 = all)
 		AggressivePlayerStrategy(const AggressivePlayerStrategy& playerStrategy); //Copy Constructor
 		~AggressivePlayerStrategy() = default; //Destructor
 		AggressivePlayerStrategy& operator = (const AggressivePlayerStrategy& playerStrategy); //Assignment Operator Overloading
 		friend ostream& operator << (ostream& output, const AggressivePlayerStrategy& playerStrategy); //Stream Insertion Operator Overloading
 		AggressivePlayerStrategy* clone() override; //Clone function
 
-		bool issueOrder(Deck* deck) override; //Returns if an order was issued
-		list<Territory*> toDefend() override; //Returns a list of territories to defend
-		list<Territory*> toAttack() override; //Returns a list of territories to attack
+		TurnPlan planTurn(const GameView& view) override; //Returns the turn's orders
+		const vector<Territory*>& toDefend() override; //Returns a read-only view of territories to defend
+		const vector<Territory*>& toAttack() override; //Returns a read-only view of territories to attack
+		bool plansOnSnapshot() const override; //Returns true, planTurn only reads the board
 
+		StrategyKind getKind() const override; //Returns StrategyKind::Aggressive
 		string getStrategyString() const override; //Returns the strategy as a string
+
+		//Accessor Methods (Getters)
+		int getSplit() const;
+
+	private:
+		int split;
 };
 
 class BenevolentPlayerStrategy : public PlayerStrategy
@@ -81,10 +130,12 @@ class BenevolentPlayerStrategy : public PlayerStrategy
 		friend ostream& operator << (ostream& output, const BenevolentPlayerStrategy& playerStrategy); //Stream Insertion Operator Overloading
 		BenevolentPlayerStrategy* clone() override; //Clone function
 
-		bool issueOrder(Deck* deck) override; //Returns if an order was issued
-		list<Territory*> toDefend() override; //Returns a list of territories to defend
-		list<Territory*> toAttack() override; //Returns a list of territories to advance towards
+		TurnPlan planTurn(const GameView& view) override; //Returns the turn's orders
+		const vector<Territory*>& toDefend() override; //Returns a read-only view of territories to defend
+		const vector<Territory*>& toAttack() override; //Returns a read-only view of territories to advance towards
+		bool plansOnSnapshot() const override; //Returns true, planTurn only reads the board
 
+		StrategyKind getKind() const override; //Returns StrategyKind::Benevolent
 		string getStrategyString() const override; //Returns the strategy as a string
 };
 
@@ -98,10 +149,12 @@ class NeutralPlayerStrategy : public PlayerStrategy
 		friend ostream& operator << (ostream& output, const NeutralPlayerStrategy& playerStrategy); //Stream Insertion Operator Overloading
 		NeutralPlayerStrategy* clone() override; //Clone function
 
-		bool issueOrder(Deck* deck) override; //Returns if an order was issued
-		list<Territory*> toDefend() override; //Returns a list of territories to defend
-		list<Territory*> toAttack() override; //Returns a list of territories to attack
+		TurnPlan planTurn(const GameView& view) override; //Issues no orders, so the plan is always empty
+		const vector<Territory*>& toDefend() override; //Returns a read-only view of territories to defend
+		const vector<Territory*>& toAttack() override; //Returns a read-only view of territories to attack
+		bool plansOnSnapshot() const override; //Returns true, planTurn only reads the board
 
+		StrategyKind getKind() const override; //Returns StrategyKind::Neutral
 		string getStrategyString() const override; //Returns the strategy as a string
 };
 
@@ -115,9 +168,171 @@ class CheaterPlayerStrategy : public PlayerStrategy
 		friend ostream& operator << (ostream& output, const CheaterPlayerStrategy& playerStrategy); //Stream Insertion Operator Overloading
 		CheaterPlayerStrategy* clone() override; //Clone function
 
-		bool issueOrder(Deck* deck) override; //Returns if an order was issued
-		list<Territory*> toDefend() override; //Returns a list of territories to defend
-		list<Territory*> toAttack() override; //Returns a list of territories to attack
+		TurnPlan planTurn(const GameView& view) override; //Conquers every adjacent territory outright, so the plan is always empty
+		const vector<Territory*>& toDefend() override; //Returns a read-only view of territories to defend
+		const vector<Territory*>& toAttack() override; //Returns a read-only view of territories to attack
 
+		StrategyKind getKind() const override; //Returns StrategyKind::Cheater
 		string getStrategyString() const override; //Returns the strategy as a string
-};
\ No newline at end of file
+};
+//Totals across every MCTS decision since the last reset (used for benchmarking)
+struct MCTSStatistics
+{
+	long long decisions;
+	long long rollouts;
+	double seconds;
+};
+
+//Searches over turn-level macro actions with Monte Carlo Tree Search on a compact copy of the board.
+//Each worker thread grows its own open-loop tree (root parallelisation) and the root statistics are merged.
+class MCTSPlayerStrategy : public PlayerStrategy
+{
+	public:
+		MCTSPlayerStrategy(Player* player, int timeBudgetMs = 50, int rolloutBudget = 0, int threadCount = 0); //Parameterized Constructor (0 = no rollout limit / all cores)
+		MCTSPlayerStrategy(const MCTSPlayerStrategy& playerStrategy); //Copy Constructor
+		~MCTSPlayerStrategy(); //Destructor
+		MCTSPlayerStrategy& operator = (const MCTSPlayerStrategy& playerStrategy); //Assignment Operator Overloading
+		friend ostream& operator << (ostream& output, const MCTSPlayerStrategy& playerStrategy); //Stream Insertion Operator Overloading
+		MCTSPlayerStrategy* clone() override; //Clone function
+
+		TurnPlan planTurn(const GameView& view) override; //Searches for the best turn until its own budget or the view's runs out
+		const vector<Territory*>& toDefend() override; //Returns a read-only view of territories to defend
+		const vector<Territory*>& toAttack() override; //Returns a read-only view of territories to attack
+		bool plansOnSnapshot() const override; //Returns true, searches run on a copy of the board
+
+		StrategyKind getKind() const override; //Returns StrategyKind::MCTS
+		string getStrategyString() const override; //Returns the strategy as a string
+
+		//Mutator Methods (Setters)
+		void setMap(Map* map) override; //Lets simulations use the map's continent bonuses (otherwise the board is discovered from adjacency)
+		void setBudget(int timeBudgetMs, int rolloutBudget); //A decision stops at whichever budget runs out first
+		void setSeed(unsigned int seed);
+
+		//Accessor Methods (Getters)
+		int getLastRolloutCount() const; //Returns rollouts played for the last decision
+		static MCTSStatistics getStatistics();
+		static void resetStatistics();
+
+	private:
+		//Root-level statistics for one search thread
+		struct SearchResult
+		{
+			vector<int> visits;
+			vector<double> values;
+		};
+
+		SearchResult search(const BoardState& root, const vector<TurnAction>& rootActions, int reinforcements, const vector<char>& seatPolicies,
+			unsigned int threadSeed, const TurnBudget& budget, atomic<int>& rolloutsPlayed) const;
+		void playOpponents(BoardState& state, const vector<char>& seatPolicies, mt19937& gen) const;
+
+		int timeBudgetMs;
+		int rolloutBudget;
+		int threadCount;
+		unsigned int seed;
+		int maxDepth; //Own turns expanded in the tree before switching to rollouts
+		int rolloutRounds; //Rounds played by the rollout policy after the tree
+		size_t maxActions; //Macro actions considered per decision
+
+		Map* map;
+		unique_ptr<BoardTopology> topology;
+		unique_ptr<ThreadPool> pool;
+		long long decisionCount;
+		int lastRolloutCount;
+
+		static MCTSStatistics statistics;
+};
+
+//Integer weights of HeuristicPlayerStrategy, kept as integers so a whole set can be written as a strategy spec
+class HeuristicParameters
+{
+	public:
+		enum Index
+		{
+			AttackOdds, //Smallest conquest chance (percent) worth attacking for
+			DeployShare, //Percent of reinforcements deployed on the main front, the rest shores up the weakest frontier territory
+			MaxTargets, //Most territories attacked from the main front in one turn
+			Reserve, //Armies an attacking territory keeps at home
+			CardArmies, //Armies deployed by a Reinforcement card
+			AirliftShare, //Percent of the strongest back territory's armies airlifted to the main front
+			GatherShare, //Percent of an interior territory's spare armies advanced towards the frontier
+			Count
+		};
+
+		HeuristicParameters(); //Default Constructor (every weight at its default)
+
+		static const string& getName(int index); //Returns the spec key of a weight
+		static int getDefault(int index);
+		static int getMinimum(int index);
+		static int getMaximum(int index);
+		static vector<string> getNames(); //Returns every spec key in Index order
+
+		int get(int index) const;
+		void set(int index, int value); //Clamps the value to the weight's range
+		string toSpec() const; //Returns the full spec, e.g. "Heuristic:attackOdds=60:deployShare=70:..."
+
+	private:
+		int values[Count];
+};
+
+//Rule-based bot whose choices are all driven by HeuristicParameters, so its weights can be tuned by self-play (see StrategyTuner)
+class HeuristicPlayerStrategy : public PlayerStrategy
+{
+	public:
+		HeuristicPlayerStrategy(Player* player, const HeuristicParameters& parameters = HeuristicParameters()); //Parameterized Constructor
+		HeuristicPlayerStrategy(const HeuristicPlayerStrategy& playerStrategy); //Copy Constructor
+		~HeuristicPlayerStrategy() = default; //Destructor
+		HeuristicPlayerStrategy& operator = (const HeuristicPlayerStrategy& playerStrategy); //Assignment Operator Overloading
+		friend ostream& operator << (ostream& output, const HeuristicPlayerStrategy& playerStrategy); //Stream Insertion Operator Overloading
+		HeuristicPlayerStrategy* clone() override; //Clone function
+
+		TurnPlan planTurn(const GameView& view) override; //Returns the turn's orders
+		const vector<Territory*>& toDefend() override; //Returns a read-only view of territories to defend (the main front)
+		const vector<Territory*>& toAttack() override; //Returns a read-only view of territories to attack from the main front, weakest first
+		bool plansOnSnapshot() const override; //Returns true, planTurn only reads the board
+
+		StrategyKind getKind() const override; //Returns StrategyKind::Heuristic
+		string getStrategyString() const override; //Returns the strategy as a string
+
+		//Accessor Methods (Getters)
+		const HeuristicParameters& getParameters() const;
+
+	private:
+		void planGatherOrders(TurnPlan& plan, Territory* airliftSource, int airlifted); //Advances interior armies one step closer to the frontier (leaving airlifted armies behind)
+
+		HeuristicParameters parameters;
+};
+
+//One-ply lookahead: plays out each candidate turn on a copy of the board a few times and keeps the one
+//whose resulting positions BoardEvaluator rates best against the strongest opponent
+class GreedyPlayerStrategy : public PlayerStrategy
+{
+	public:
+		GreedyPlayerStrategy(Player* player, int samples = 4); //Parameterized Constructor (samples = battle outcomes drawn per candidate turn)
+		GreedyPlayerStrategy(const GreedyPlayerStrategy& playerStrategy); //Copy Constructor
+		~GreedyPlayerStrategy(); //Destructor
+		GreedyPlayerStrategy& operator = (const GreedyPlayerStrategy& playerStrategy); //Assignment Operator Overloading
+		friend ostream& operator << (ostream& output, const GreedyPlayerStrategy& playerStrategy); //Stream Insertion Operator Overloading
+		GreedyPlayerStrategy* clone() override; //Clone function
+
+		TurnPlan planTurn(const GameView& view) override; //Picks the best-rated turn, comparing candidates until the view's budget runs out
+		const vector<Territory*>& toDefend() override; //Returns a read-only view of territories to defend
+		const vector<Territory*>& toAttack() override; //Returns a read-only view of territories to attack
+		bool plansOnSnapshot() const override; //Returns true, candidate turns are played on a copy of the board
+
+		StrategyKind getKind() const override; //Returns StrategyKind::Greedy
+		string getStrategyString() const override; //Returns the strategy as a string
+
+		//Mutator Methods (Setters)
+		void setMap(Map* map) override; //Lets the evaluation count continent bonuses (otherwise the board is discovered from adjacency)
+		void setSeed(unsigned int seed);
+
+	private:
+		int samples;
+		unsigned int seed;
+		size_t maxActions; //Candidate turns compared per decision
+
+		Map* map;
+		unique_ptr<BoardTopology> topology;
+		unique_ptr<BoardEvaluator> evaluator;
+		long long decisionCount;
+};
@@ -5,6 +5,16 @@
 #include "GameEngine.h"
 #include "CommandProcessing.h"
 #include "LoggingObserver.h"
+#include "StrategyRegistry.h"
+#include "BoardEvaluator.h"
+#include "ConsoleLog.h"
+#include "TurnPlan.h"
+#include "Orders.h"
+#include "OrderExecutor.h"
+#include "ThreadPool.h"
+#include <chrono>
+#include <limits>
+#include <sstream>
 
 void testPlayerStrategies()
 {
@@ -66,4 +76,590 @@ void testPlayerStrategies()
 	delete map;
 	delete players;
 	delete deck;
-}
\ No newline at end of file
+}
+
+//Builds a square grid map of side x side territories split into 5x5 continents
+static Map* buildGridMap(int side)
+{
+	Map* map = new Map();
+	vector<Territory*> grid;
+
+	for (int row = 0; row < side; row++)
+	{
+		for (int col = 0; col < side; col++)
+		{
+			string continentName = "C" + to_string(row / 5) + "-" + to_string(col / 5);
+			Territory* territory = new Territory("T" + to_string(row) + "-" + to_string(col), col, row, continentName);
+			territory->setArmies(1 + (row * 7 + col * 3) % 10);
+			map->addTerritory(territory);
+			grid.push_back(territory);
+
+			if (row % 5 == 0 && col % 5 == 0)
+			{
+				map->addContinent(new Continent(continentName, 3));
+			}
+		}
+	}
+
+	for (int row = 0; row < side; row++)
+	{
+		for (int col = 0; col < side; col++)
+		{
+			Territory* territory = grid[row * side + col];
+
+			if (row > 0) territory->addAdjacentTerritory(grid[(row - 1) * side + col]);
+			if (row < side - 1) territory->addAdjacentTerritory(grid[(row + 1) * side + col]);
+			if (col > 0) territory->addAdjacentTerritory(grid[row * side + col - 1]);
+			if (col < side - 1) territory->addAdjacentTerritory(grid[row * side + col + 1]);
+
+			for (Continent* continent : map->getContinents())
+			{
+				if (continent->getName() == territory->getContinent())
+				{
+					continent->addTerritory(territory);
+					break;
+				}
+			}
+		}
+	}
+
+	return map;
+}
+
+void benchmarkStrategyTurn()
+{
+	cout << "=== Strategy Turn Benchmark ===\n\n";
+
+	const int sides[] = { 10, 32, 64 };
+	const int turns = 200;
+
+	for (int side : sides)
+	{
+		GameEngine gEngine;
+		gEngine.setSeed(345);
+		CommandProcessor* commandProcessor = new CommandProcessor();
+		Map* map = buildGridMap(side);
+		Deck* deck = new Deck();
+		vector<Player*>* players = new vector<Player*>;
+
+		for (int i = 0; i < 4; i++)
+		{
+			deck->addCard(make_unique<Card>(CardType::Reinforcement));
+			deck->addCard(make_unique<Card>(CardType::Bomb));
+			deck->addCard(make_unique<Card>(CardType::Blockade));
+			deck->addCard(make_unique<Card>(CardType::Airlift));
+			deck->addCard(make_unique<Card>(CardType::Diplomacy));
+		}
+
+		//The Cheater is left out because it changes the board while issuing orders
+		players->push_back(new Player("Aggressive 1", new AggressivePlayerStrategy(nullptr)));
+		players->push_back(new Player("Benevolent 1", new BenevolentPlayerStrategy(nullptr)));
+		players->push_back(new Player("Aggressive 2", new AggressivePlayerStrategy(nullptr)));
+		players->push_back(new Player("Benevolent 2", new BenevolentPlayerStrategy(nullptr)));
+		players->push_back(new Player("Neutral", new NeutralPlayerStrategy(nullptr)));
+
+		streambuf* console = cout.rdbuf(nullptr); //Silence order output while timing
+
+		gEngine.startupPhaseProcess(commandProcessor, map, players, deck);
+
+		//Plans a full turn for every player, then discards the orders so the board stays comparable between turns.
+		//A few armies change every turn, as executing orders would, so cached queries have to be recomputed.
+		const vector<Territory*>& territories = map->getTerritories();
+		auto start = chrono::steady_clock::now();
+
+		for (int turn = 0; turn < turns; turn++)
+		{
+			for (int i = 0; i < 8; i++)
+			{
+				Territory* touched = territories[(turn * 131 + i * 977) % territories.size()];
+				touched->setArmies(1 + (turn + i) % 10);
+			}
+
+			gEngine.reinforcementPhase(map, players);
+			gEngine.issueOrdersPhase(players, deck);
+
+			for (Player* player : *players)
+			{
+				while (player->getOrdersList()->size() > 0)
+				{
+					player->getOrdersList()->remove(0);
+				}
+			}
+		}
+
+		auto elapsed = chrono::duration_cast<chrono::microseconds>(chrono::steady_clock::now() - start).count();
+
+		cout.rdbuf(console);
+
+		cout << map->getTerritories().size() << " territories: "
+			<< (static_cast<double>(elapsed) / turns) << " us per turn (" << turns << " turns)\n";
+
+		for (Player* player : *players)
+		{
+			delete player;
+		}
+
+		delete commandProcessor;
+		delete map;
+		delete players;
+		delete deck;
+	}
+
+	cout << "\n=== Strategy Turn Benchmark Complete ===\n\n";
+}
+
+//Plays a seeded game on a grid map and returns everything printed, every issued order and the final owners
+static string playRecordedGame(bool parallel, bool withCheater, bool parallelExecution = false)
+{
+	GameEngine gEngine;
+	gEngine.setSeed(2024);
+	gEngine.setParallelPlanning(parallel, 4);
+	gEngine.setParallelExecution(parallelExecution);
+	CommandProcessor* commandProcessor = new CommandProcessor();
+	Map* map = buildGridMap(10);
+	Deck* deck = new Deck();
+	vector<Player*>* players = new vector<Player*>;
+	ostringstream transcript;
+
+	for (int i = 0; i < 4; i++)
+	{
+		deck->addCard(make_unique<Card>(CardType::Reinforcement));
+		deck->addCard(make_unique<Card>(CardType::Bomb));
+		deck->addCard(make_unique<Card>(CardType::Blockade));
+		deck->addCard(make_unique<Card>(CardType::Airlift));
+		deck->addCard(make_unique<Card>(CardType::Diplomacy));
+	}
+
+	MCTSPlayerStrategy* search = new MCTSPlayerStrategy(nullptr, 10000, 300, 1);
+	search->setMap(map);
+	search->setSeed(7);
+
+	players->push_back(new Player("Aggressive 1", new AggressivePlayerStrategy(nullptr)));
+	players->push_back(new Player("Benevolent", new BenevolentPlayerStrategy(nullptr)));
+	if (withCheater)
+	{
+		//The Cheater changes the board while issuing orders, so it splits the concurrent players into groups
+		players->push_back(new Player("Cheater", new CheaterPlayerStrategy(nullptr)));
+	}
+	players->push_back(new Player("Aggressive 2", new AggressivePlayerStrategy(nullptr)));
+	players->push_back(new Player("MCTS", search));
+	players->push_back(new Player("Neutral", new NeutralPlayerStrategy(nullptr)));
+
+	streambuf* console = cout.rdbuf(transcript.rdbuf()); //Printed output is part of what must match
+
+	gEngine.startupPhaseProcess(commandProcessor, map, players, deck);
+
+	for (int turn = 0; turn < (withCheater ? 3 : 30); turn++) //The Cheater takes the board within a few turns
+	{
+		gEngine.reinforcementPhase(map, players);
+		gEngine.issueOrdersPhase(players, deck);
+
+		for (Player* player : *players)
+		{
+			for (Order* order : player->getOrdersList()->getOrders())
+			{
+				transcript << player->getName() << ": " << order->toString() << "\n";
+			}
+		}
+
+		gEngine.executeOrdersPhase(players);
+	}
+
+	cout.rdbuf(console);
+
+	for (Territory* territory : map->getTerritories())
+	{
+		transcript << territory->getName() << " " << (territory->getOwner() ? territory->getOwner()->getName() : "none")
+			<< " " << territory->getArmies() << "\n";
+	}
+
+	for (Player* player : *players)
+	{
+		delete player;
+	}
+
+	delete commandProcessor;
+	delete map;
+	delete players;
+	delete deck;
+
+	return transcript.str();
+}
+
+void testParallelPlanning()
+{
+	cout << "=== Parallel Planning Testing ===\n\n";
+
+	//Same seed, same roster: planning concurrently must not change a single order or battle
+	for (bool withCheater : { false, true })
+	{
+		auto start = chrono::steady_clock::now();
+		string sequential = playRecordedGame(false, withCheater);
+		auto middle = chrono::steady_clock::now();
+		string parallel = playRecordedGame(true, withCheater);
+		auto end = chrono::steady_clock::now();
+
+		cout << (withCheater ? "With a Cheater" : "Without a Cheater") << ":\n";
+		cout << "Sequential game: " << chrono::duration_cast<chrono::milliseconds>(middle - start).count() << " ms\n";
+		cout << "Parallel game: " << chrono::duration_cast<chrono::milliseconds>(end - middle).count() << " ms\n";
+		cout << "Transcript length: " << sequential.size() << " characters\n";
+		cout << "Transcripts " << (sequential == parallel ? "MATCH" : "MISMATCH") << "\n\n";
+	}
+
+	cout << "\n=== Parallel Planning Testing Complete ===\n\n";
+}
+
+//Deals a grid in square blocks, one per player, has every territory with armies to spare advance half of them
+//to a random neighbour and executes the orders in round-robin sequence; returns the output and the final board
+static string executeGridTurn(ThreadPool* pool, size_t minParallelWave, OrderExecutor& executor, double& milliseconds)
+{
+	const int side = 60, block = 20;
+	Map* map = buildGridMap(side);
+	vector<Player*> players;
+	for (int i = 0; i < (side / block) * (side / block); i++)
+	{
+		players.push_back(new Player("P" + to_string(i + 1), new AggressivePlayerStrategy(nullptr)));
+	}
+
+	const vector<Territory*>& territories = map->getTerritories();
+	for (int t = 0; t < side * side; t++)
+	{
+		Player* owner = players[(t / side / block) * (side / block) + (t % side) / block];
+		owner->addTerritory(territories[t]);
+		territories[t]->setOwner(owner);
+	}
+
+	mt19937 gen(99);
+	vector<vector<unique_ptr<Order>>> issued(players.size());
+	for (size_t p = 0; p < players.size(); p++)
+	{
+		for (Territory* territory : players[p]->getTerritories())
+		{
+			const vector<Territory*>& neighbours = territory->getAdjacentTerritories();
+			Territory* target = neighbours[uniform_int_distribution<size_t>(0, neighbours.size() - 1)(gen)];
+			if (territory->getArmies() > 1) issued[p].emplace_back(new Advance(players[p], territory, target, territory->getArmies() / 2));
+		}
+	}
+
+	vector<Order*> sequence;
+	for (size_t round = 0; ; round++)
+	{
+		bool any = false;
+		for (const vector<unique_ptr<Order>>& orders : issued)
+		{
+			if (round < orders.size()) sequence.push_back(orders[round].get());
+			any = any || round < orders.size();
+		}
+		if (!any) break;
+	}
+
+	ostringstream transcript;
+	Advance::seedBattles(11);
+	ConsoleLog::redirect(&transcript);
+	auto start = chrono::steady_clock::now();
+	executor = OrderExecutor(pool, minParallelWave);
+	executor.execute(sequence);
+	milliseconds = chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+	ConsoleLog::redirect(nullptr);
+
+	for (Territory* territory : territories)
+	{
+		transcript << territory->getName() << " " << (territory->getOwner() ? territory->getOwner()->getName() : "none")
+			<< " " << territory->getArmies() << "\n";
+	}
+
+	issued.clear();
+	for (Player* player : players)
+	{
+		delete player;
+	}
+	delete map;
+
+	return transcript.str();
+}
+
+void testParallelExecution()
+{
+	cout << "=== Parallel Execution Testing ===\n\n";
+
+	//Same seed, same roster: running independent orders side by side must not change the board, the output or a battle
+	for (bool withCheater : { false, true })
+	{
+		string sequential = playRecordedGame(false, withCheater);
+		string parallel = playRecordedGame(false, withCheater, true);
+
+		cout << (withCheater ? "With a Cheater" : "Without a Cheater") << ": transcripts "
+			<< (sequential == parallel ? "MATCH" : "MISMATCH") << " (" << sequential.size() << " characters)\n";
+	}
+
+	//One turn of a 60x60 grid held by nine players, most orders moving armies inside a player's own block
+	//Every wave on the workers however small it is (cutoff 1), then with the cutoff this machine gets by default
+	ThreadPool pool(4);
+	OrderExecutor inOrder, everyWave, withCutoff;
+	double sequentialMs = 0.0, everyWaveMs = 0.0, cutoffMs = 0.0;
+	const size_t cutoff = OrderExecutor::defaultMinParallelWave();
+	string sequential = executeGridTurn(nullptr, cutoff, inOrder, sequentialMs);
+	string parallel = executeGridTurn(&pool, 1, everyWave, everyWaveMs);
+	string defaulted = executeGridTurn(&pool, cutoff, withCutoff, cutoffMs);
+
+	cout << "\nGrid turn: " << inOrder.getWaveCount() << " orders in " << everyWave.getWaveCount()
+		<< " waves, at most " << everyWave.getWidestWave() << " side by side\n";
+	cout << "One by one: " << sequentialMs << " ms, every wave on " << pool.size() << " workers: " << everyWaveMs << " ms\n";
+	if (cutoff == numeric_limits<size_t>::max())
+		cout << "Cutoff: none, " << thread::hardware_concurrency() << " hardware thread so every order runs one by one";
+	else
+		cout << "Cutoff: waves of " << cutoff << " orders or more go to the workers (" << thread::hardware_concurrency()
+			<< " hardware threads)";
+	cout << ": " << cutoffMs << " ms\n";
+	cout << "Transcripts " << (sequential == parallel && sequential == defaulted ? "MATCH" : "MISMATCH") << "\n";
+
+	cout << "\n=== Parallel Execution Testing Complete ===\n\n";
+}
+
+void testStrategyRegistry()
+{
+	cout << "=== Strategy Registry Testing ===\n\n";
+
+	cout << "Registered strategies:";
+	for (const string& name : StrategyRegistry::getNames())
+	{
+		cout << " " << name;
+	}
+	cout << "\n\n";
+
+	//Specs are a registered name followed by optional integer parameters
+	const string specs[] = { "Aggressive", "Aggressive:split=3", "MCTS:budget=20:threads=1", "Human", "Aggressive:split=x", "Benevolent:split=2", "Random" };
+
+	for (const string& spec : specs)
+	{
+		string error;
+		PlayerStrategy* strategy = StrategyRegistry::create(spec, &error);
+
+		cout << spec << " -> ";
+		if (strategy == nullptr)
+		{
+			cout << "rejected (" << error << ")\n";
+			continue;
+		}
+
+		cout << strategy->getStrategyString() << " (kind " << static_cast<int>(strategy->getKind()) << ")"
+			<< (StrategyRegistry::isValid(spec, true) ? "" : ", not allowed in tournaments") << "\n";
+		delete strategy;
+	}
+
+	//Tournament commands accept parameterized specs
+	vector<string> maps, strategies;
+	int games = 0, maxTurns = 0;
+	string command = "tournament -M TestMap.map -P Aggressive:split=2,MCTS:budget=10,Cheater -G 2 -D 20";
+	bool valid = CommandProcessor::parseTournamentCommand(command, maps, strategies, games, maxTurns);
+	cout << "\n" << command << " -> " << (valid ? "valid" : "invalid") << "\n";
+
+	cout << "\n=== Strategy Registry Testing Complete ===\n\n";
+}
+
+void benchmarkBoardEvaluator()
+{
+	cout << "=== Board Evaluator Benchmark ===\n\n";
+
+	Map* map = MapLoader::loadMap("Chicago.map");
+	if (map == nullptr)
+	{
+		cout << "Could not load Chicago.map\n";
+		return;
+	}
+
+	//A map that loads empty would time an evaluator with nothing to evaluate
+	const int mapTerritories = static_cast<int>(map->getTerritories().size());
+	cout << "[Check] Chicago.map has " << mapTerritories << " territories: " << (mapTerritories > 0 ? "yes" : "NO") << "\n";
+	if (mapTerritories == 0)
+	{
+		delete map;
+		return;
+	}
+
+	BoardTopology topology(map);
+	BoardEvaluator evaluator(&topology);
+	const int seats = 4;
+	const int boards = 64;
+
+	//Random positions, all kept in memory so the timing covers the evaluation and not the setup
+	mt19937 gen(345);
+	vector<BoardState> positions;
+	for (int b = 0; b < boards; b++)
+	{
+		BoardState state(&topology, seats);
+		for (int t = 0; t < topology.getTerritoryCount(); t++)
+		{
+			state.setOwner(t, static_cast<int>(gen() % seats));
+			state.setArmies(t, 1 + static_cast<int>(gen() % 30));
+		}
+		positions.push_back(state);
+	}
+
+	//Both kernels have to agree exactly
+	BoardEvaluator scalar(&topology);
+	scalar.setVectorized(false);
+	bool match = true;
+
+	for (const BoardState& state : positions)
+	{
+		double vectorScores[seats], scalarScores[seats];
+		evaluator.evaluate(state, vectorScores);
+		scalar.evaluate(state, scalarScores);
+		match = match && equal(vectorScores, vectorScores + seats, scalarScores);
+	}
+
+	const bool vectorKernel = BoardEvaluator::hasAvx2Kernel();
+	cout << topology.getTerritoryCount() << " territories, " << seats << " seats, AVX2 kernel "
+		<< (vectorKernel ? "in use" : "not available on this processor") << "\n";
+	if (vectorKernel)
+		cout << "Scalar and vectorized scores " << (match ? "MATCH" : "DIFFER") << "\n";
+	else
+		cout << "No vector kernel to compare against, only the scalar kernel is timed\n";
+
+	const int rounds = 200000;
+	vector<BoardEvaluator*> kernels = { &scalar };
+	if (vectorKernel)
+		kernels.push_back(&evaluator);
+	for (BoardEvaluator* kernel : kernels)
+	{
+		double checksum = 0.0;
+		double scores[seats];
+		auto start = chrono::steady_clock::now();
+
+		for (int round = 0; round < rounds; round++)
+		{
+			const BoardState& state = positions[round % boards];
+			kernel->evaluate(state, scores);
+			checksum += scores[round % seats];
+		}
+
+		double seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+		cout << (kernel->isVectorized() ? "Vectorized" : "Scalar") << ": "
+			<< static_cast<long long>(rounds / seconds) << " evaluations per second (checksum " << checksum << ")\n";
+	}
+
+	//The one-ply bot built on the evaluator (Chicago.map itself does not pass validation, so the games use England.map)
+	GameEngine engine;
+	engine.setSeed(345);
+	ConsoleLog::setQuiet(true);
+	int wins = 0;
+	int played = 0;
+	const int games = 4;
+	Map* england = MapLoader::loadMap("England.map");
+	const int englandTerritories = england ? static_cast<int>(england->getTerritories().size()) : 0;
+	delete england;
+	for (int game = 0; game < games; game++)
+	{
+		GameResult result = engine.playGame("England.map", { "Greedy:seed=" + to_string(game), "Aggressive" }, 60);
+		int held = 0;
+		for (int count : result.territoryCounts)
+		{
+			held += count;
+		}
+		played += result.played && englandTerritories > 0 && held == englandTerritories ? 1 : 0;
+		wins += result.winner == 0 ? 1 : 0;
+	}
+	ConsoleLog::setQuiet(false);
+	cout << "[Check] Every game played on all " << englandTerritories << " territories of England.map: "
+		<< (played == games ? "yes" : "NO") << "\n";
+	cout << "Greedy beat Aggressive in " << wins << " of " << games << " games on England.map\n";
+
+	delete map;
+
+	cout << "\n=== Board Evaluator Benchmark Complete ===\n\n";
+}
+
+void testTurnPlan()
+{
+	cout << "=== Turn Plan Testing ===\n\n";
+
+	GameEngine gEngine;
+	gEngine.setSeed(345);
+	CommandProcessor* commandProcessor = new CommandProcessor();
+	Map* map = buildGridMap(10);
+	Deck* deck = new Deck();
+	vector<Player*>* players = new vector<Player*>;
+
+	for (int i = 0; i < 4; i++)
+	{
+		deck->addCard(make_unique<Card>(CardType::Reinforcement));
+		deck->addCard(make_unique<Card>(CardType::Bomb));
+	}
+
+	players->push_back(new Player("Aggressive", new AggressivePlayerStrategy(nullptr)));
+	players->push_back(new Player("Benevolent", new BenevolentPlayerStrategy(nullptr)));
+	players->push_back(new Player("Heuristic", new HeuristicPlayerStrategy(nullptr)));
+	players->push_back(new Player("Greedy", new GreedyPlayerStrategy(nullptr)));
+
+	streambuf* console = cout.rdbuf(nullptr); //Silence the setup
+	gEngine.startupPhaseProcess(commandProcessor, map, players, deck);
+	gEngine.reinforcementPhase(map, players);
+	cout.rdbuf(console);
+
+	//A plan holds the whole turn; nothing reaches the orders list or the deck until it is issued
+	for (Player* player : *players)
+	{
+		player->getHand()->addCard(make_unique<Card>(CardType::Reinforcement));
+		player->getHand()->addCard(make_unique<Card>(CardType::Bomb));
+
+		ostringstream cardOutput;
+		ConsoleLog::redirect(&cardOutput);
+		int deckBefore = deck->size();
+		int poolBefore = player->getArmies();
+		TurnPlan plan = player->planTurn(TurnBudget());
+		ConsoleLog::redirect(nullptr);
+
+		cout << player->getName() << ": " << plan.size() << " orders and " << plan.getPlayedCards().size() << " cards planned, "
+			<< player->getOrdersList()->size() << " orders listed, deck " << (deck->size() == deckBefore ? "untouched" : "CHANGED")
+			<< ", reinforcement pool " << (player->getArmies() == poolBefore ? "untouched" : "CHANGED") << "\n";
+
+		player->issueOrders(plan, deck);
+
+		cout << "  issued: " << player->getOrdersList()->size() << " orders listed, " << (deck->size() - deckBefore)
+			<< " cards back in the deck, " << player->getArmies() << " of " << poolBefore << " armies left in the pool, plan "
+			<< (plan.empty() ? "empty" : "NOT EMPTY") << "\n";
+	}
+
+	//Moving a turn in one step against copying it in order by order
+	const int count = 100000;
+	Territory* source = map->getTerritories()[0];
+	Territory* target = map->getTerritories()[1];
+	Player* player = players->front();
+
+	auto start = chrono::steady_clock::now();
+	{
+		OrdersList ordersList;
+		for (int i = 0; i < count; i++)
+		{
+			Advance order(player, source, target, 1);
+			ordersList.add(order);
+		}
+	}
+	auto middle = chrono::steady_clock::now();
+	{
+		OrdersList ordersList;
+		TurnPlan plan;
+		for (int i = 0; i < count; i++)
+		{
+			plan.add(new Advance(player, source, target, 1));
+		}
+		ordersList.add(plan.takeOrders());
+	}
+	auto end = chrono::steady_clock::now();
+
+	cout << "\n" << count << " orders one at a time: " << chrono::duration_cast<chrono::milliseconds>(middle - start).count() << " ms\n";
+	cout << count << " orders as one plan: " << chrono::duration_cast<chrono::milliseconds>(end - middle).count() << " ms\n";
+
+	for (Player* player : *players)
+	{
+		delete player;
+	}
+
+	delete commandProcessor;
+	delete map;
+	delete players;
+	delete deck;
+
+	cout << "\n=== Turn Plan Testing Complete ===\n\n";
+}
@@ -1,4 +1,10 @@
 #pragma once
 
-//Function Prototype
-void testPlayerStrategies();
\ No newline at end of file
+//Function Prototypes
+void testPlayerStrategies();
+void benchmarkStrategyTurn();
+void testParallelPlanning();
+void testParallelExecution();
+void testStrategyRegistry();
+void benchmarkBoardEvaluator();
+void testTurnPlan();
\ No newline at end of file
@@ -0,0 +1,160 @@
+#include "ScriptRunner.h"
+#include "GameEngine.h"
+#include "Map.h"
+#include "Player.h"
+#include "Cards.h"
+#include "ThreadPool.h"
+#include "ConsoleLog.h"
+#include <algorithm>
+#include <chrono>
+#include <exception>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+
+ScriptRunner::ScriptRunner(const ScriptBatchSettings& settings) : settings(settings) {}
+
+ScriptResult ScriptRunner::runScript(const string& script, unsigned int seed, size_t historyLimit, ostream& log) {
+    ScriptResult result;
+    result.script = script;
+    auto start = chrono::steady_clock::now();
+
+    ConsoleLog::redirect(&log);
+
+    FileCommandProcessorAdapter* fileProcessor = new FileCommandProcessorAdapter(script);
+    CommandProcessor* commandProcessor = fileProcessor;
+    Map* map = nullptr;
+    vector<Player*>* players = nullptr;
+    Deck* deck = new Deck();
+
+    result.opened = fileProcessor->isOpen();
+    if (result.opened) {
+        try {
+            commandProcessor->setHistoryLimit(historyLimit);
+
+            // Same deck as a tournament game: four cards of each type
+            for (int type = 0; type < CardTypeCount; type++) {
+                deck->addCard(static_cast<CardType>(type), 4);
+            }
+
+            GameEngine engine;
+            engine.setSeed(seed);
+            engine.startupPhase(commandProcessor, map, players, deck);
+
+            result.finalState = commandProcessor->getCurrentState();
+            result.started = result.finalState == AssignReinforcements;
+            if (result.started) {
+                for (Player* player : *players) {
+                    result.territoryCounts.push_back(static_cast<int>(player->getTerritories().size()));
+                }
+            }
+        }
+        catch (const exception& e) {
+            result.error = e.what();
+            log << "\n[Script] Stopped: " << e.what() << "\n";
+        }
+        result.commands = commandProcessor->getHistory().getTotal();
+    }
+    else {
+        result.error = "could not open the script";
+    }
+
+    if (players) {
+        for (Player* player : *players) {
+            delete player;
+        }
+        delete players;
+    }
+    delete map;
+    delete deck;
+    delete commandProcessor;
+
+    ConsoleLog::redirect(nullptr);
+    result.seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+    return result;
+}
+
+const vector<ScriptResult>& ScriptRunner::run() {
+    results.assign(settings.scripts.size(), ScriptResult());
+    if (!settings.logDirectory.empty()) {
+        error_code ignored;
+        filesystem::create_directories(settings.logDirectory, ignored);
+    }
+
+    ThreadPool pool(settings.threads);
+    pool.parallelFor(results.size(), [&](size_t i) {
+        const string& script = settings.scripts[i];
+
+        // Logs are named after the script, so a batch run twice overwrites its own logs
+        string logFile;
+        ofstream log;
+        if (!settings.logDirectory.empty()) {
+            logFile = (filesystem::path(settings.logDirectory) / (filesystem::path(script).filename().string() + ".log")).string();
+            log.open(logFile);
+        }
+
+        // Without a log the run's output is dropped
+        bool wasQuiet = ConsoleLog::isQuiet();
+        ConsoleLog::setQuiet(!log.is_open());
+
+        ostream discard(nullptr);
+        results[i] = runScript(script, settings.seed + static_cast<unsigned int>(i), settings.historyLimit,
+                               log.is_open() ? static_cast<ostream&>(log) : discard);
+        if (log.is_open()) results[i].logFile = logFile;
+
+        ConsoleLog::setQuiet(wasQuiet);
+    });
+
+    return results;
+}
+
+const vector<ScriptResult>& ScriptRunner::getResults() const {
+    return results;
+}
+
+void ScriptRunner::printSummary(ostream& out) const {
+    static const char* stateNames[] = { "Start", "MapLoaded", "MapValidated", "PlayersAdded", "AssignReinforcements",
+                                        "IssueOrders", "ExecuteOrders", "Win", "End" };
+
+    streamsize precision = out.precision();
+    size_t started = 0;
+    size_t failed = 0;
+    size_t commands = 0;
+    double seconds = 0.0;
+
+    out << left << setw(28) << "Script" << setw(10) << "Commands" << setw(22) << "State" << setw(10) << "Seconds" << "Territories\n";
+    for (const ScriptResult& result : results) {
+        out << left << setw(28) << filesystem::path(result.script).filename().string() << setw(10) << result.commands
+            << setw(22) << (result.error.empty() ? stateNames[result.finalState] : "Error")
+            << setw(10) << fixed << setprecision(3) << result.seconds << defaultfloat;
+
+        if (!result.error.empty()) {
+            out << result.error;
+        }
+        for (size_t i = 0; i < result.territoryCounts.size(); i++) {
+            out << (i > 0 ? " " : "") << result.territoryCounts[i];
+        }
+        out << "\n";
+
+        started += result.started ? 1 : 0;
+        failed += result.error.empty() ? 0 : 1;
+        commands += result.commands;
+        seconds += result.seconds;
+    }
+
+    out << results.size() << " scripts, " << started << " games started, " << failed << " failed, " << commands
+        << " commands, " << fixed << setprecision(3) << seconds << " s of script time\n" << defaultfloat;
+    out.precision(precision);
+}
+
+vector<string> ScriptRunner::listScripts(const string& directory, const string& extension) {
+    vector<string> scripts;
+    error_code error;
+    for (const filesystem::directory_entry& entry : filesystem::directory_iterator(directory, error)) {
+        if (!entry.is_regular_file()) continue;
+        if (!extension.empty() && entry.path().extension() != extension) continue;
+        scripts.push_back(entry.path().string());
+    }
+    sort(scripts.begin(), scripts.end());
+    return scripts;
+}
@@ -0,0 +1,57 @@
+#pragma once
+
+#include <iostream>
+#include <string>
+#include <vector>
+#include "CommandProcessing.h"
+using namespace std;
+
+class ThreadPool;
+
+// What a batch of command scripts runs with
+struct ScriptBatchSettings {
+    vector<string> scripts;     // command script files, reported in this order
+    size_t threads = 0;         // scripts run side by side, 0 uses every core
+    unsigned int seed = 1;      // the game of script i is dealt with seed + i, so a batch can be repeated
+    string logDirectory;        // each script's output is written to <logDirectory>/<script name>.log when set
+    size_t historyLimit = 256;  // commands each run keeps in memory (see CommandProcessor::setHistoryLimit)
+};
+
+// Outcome of one script
+struct ScriptResult {
+    string script;
+    string logFile;              // empty when the output was discarded
+    bool opened = false;         // false when the script could not be read
+    bool started = false;        // a gamestart was accepted, so the startup phase ran
+    GameState finalState = Start; // state of the command processor once the script stopped
+    size_t commands = 0;         // commands read from the script
+    vector<int> territoryCounts; // territories dealt to each player, in order of play
+    double seconds = 0.0;
+    string error;                // what a run that threw reported, empty otherwise
+};
+
+// Replays a batch of recorded command scripts. Every script drives its own game through
+// GameEngine::startupPhase, with its own engine, command processor, map, players and deck, so scripts
+// share nothing and run side by side on a thread pool. Each run writes its output to its own log and
+// leaves a result record; the summary lists them in the order the scripts were given.
+class ScriptRunner {
+    private:
+        ScriptBatchSettings settings;
+        vector<ScriptResult> results;
+
+    public:
+        explicit ScriptRunner(const ScriptBatchSettings& settings);
+
+        // Runs every script and returns their results
+        const vector<ScriptResult>& run();
+        const vector<ScriptResult>& getResults() const;
+
+        // Prints one line per script and the totals
+        void printSummary(ostream& out) const;
+
+        // Runs one script to the end of its startup phase, writing its output to log
+        static ScriptResult runScript(const string& script, unsigned int seed, size_t historyLimit, ostream& log);
+
+        // Regular files of a directory, sorted by name (only the ones ending in extension, unless it is empty)
+        static vector<string> listScripts(const string& directory, const string& extension = ".txt");
+};
@@ -0,0 +1,372 @@
+#include "Simulation.h"
+#include "Map.h"
+#include "Player.h"
+#include "Orders.h"
+#include "BattleOdds.h"
+#include <algorithm>
+#include <queue>
+
+// BoardTopology Implementation
+BoardTopology::BoardTopology(Map* map) {
+    unordered_map<string, int> bonuses;
+    for (Continent* continent : map->getContinents()) {
+        bonuses[continent->getName()] = continent->getBonus();
+    }
+    build(map->getTerritories(), bonuses);
+}
+
+BoardTopology::BoardTopology(const vector<Territory*>& seeds) {
+    vector<Territory*> territoryList;
+    unordered_map<const Territory*, bool> seen;
+    queue<Territory*> frontier;
+
+    for (Territory* seed : seeds) {
+        if (!seen[seed]) {
+            seen[seed] = true;
+            frontier.push(seed);
+        }
+    }
+
+    while (!frontier.empty()) {
+        Territory* territory = frontier.front();
+        frontier.pop();
+        territoryList.push_back(territory);
+
+        for (Territory* adj : territory->getAdjacentTerritories()) {
+            if (!seen[adj]) {
+                seen[adj] = true;
+                frontier.push(adj);
+            }
+        }
+    }
+
+    build(territoryList, {});
+}
+
+void BoardTopology::build(const vector<Territory*>& territoryList, const unordered_map<string, int>& bonuses) {
+    territories = territoryList;
+    indices.reserve(territories.size());
+    for (size_t i = 0; i < territories.size(); i++) {
+        indices[territories[i]] = static_cast<int>(i);
+    }
+
+    adjacencyOffsets.assign(1, 0);
+    for (Territory* territory : territories) {
+        for (Territory* adj : territory->getAdjacentTerritories()) {
+            int index = getTerritoryIndex(adj);
+            if (index >= 0) adjacency.push_back(index);
+        }
+        adjacencyOffsets.push_back(static_cast<int>(adjacency.size()));
+    }
+
+    // Continents are numbered in order of first appearance
+    unordered_map<string, int> continentIds;
+    vector<vector<int>> members;
+    for (size_t i = 0; i < territories.size(); i++) {
+        string name = territories[i]->getContinent();
+        auto found = continentIds.find(name);
+        if (found == continentIds.end()) {
+            found = continentIds.emplace(name, static_cast<int>(members.size())).first;
+            members.emplace_back();
+            auto bonus = bonuses.find(name);
+            continentBonuses.push_back(bonus != bonuses.end() ? bonus->second : 0);
+        }
+        members[found->second].push_back(static_cast<int>(i));
+    }
+
+    continentOffsets.assign(1, 0);
+    for (const vector<int>& continent : members) {
+        continentMembers.insert(continentMembers.end(), continent.begin(), continent.end());
+        continentOffsets.push_back(static_cast<int>(continentMembers.size()));
+    }
+}
+
+int BoardTopology::getTerritoryCount() const { return static_cast<int>(territories.size()); }
+
+int BoardTopology::getTerritoryIndex(const Territory* territory) const {
+    auto found = indices.find(territory);
+    return found != indices.end() ? found->second : -1;
+}
+
+Territory* BoardTopology::getTerritory(int index) const { return territories[index]; }
+
+const int* BoardTopology::neighboursBegin(int index) const { return adjacency.data() + adjacencyOffsets[index]; }
+const int* BoardTopology::neighboursEnd(int index) const { return adjacency.data() + adjacencyOffsets[index + 1]; }
+
+int BoardTopology::getContinentCount() const { return static_cast<int>(continentBonuses.size()); }
+int BoardTopology::getContinentBonus(int continent) const { return continentBonuses[continent]; }
+const int* BoardTopology::continentBegin(int continent) const { return continentMembers.data() + continentOffsets[continent]; }
+const int* BoardTopology::continentEnd(int continent) const { return continentMembers.data() + continentOffsets[continent + 1]; }
+
+// BoardState Implementation
+BoardState::BoardState(const BoardTopology* topology, int seatCount)
+    : topology(topology), owners(topology->getTerritoryCount(), -1), armies(topology->getTerritoryCount(), 0),
+      territoryCounts(seatCount, 0), armyTotals(seatCount, 0) {}
+
+BoardState BoardState::fromGame(const BoardTopology* topology, const vector<Player*>& seats) {
+    BoardState state(topology, static_cast<int>(seats.size()));
+
+    for (int t = 0; t < topology->getTerritoryCount(); t++) {
+        Territory* territory = topology->getTerritory(t);
+        auto seat = find(seats.begin(), seats.end(), territory->getOwner());
+        state.setOwner(t, seat != seats.end() ? static_cast<int>(seat - seats.begin()) : -1);
+        state.setArmies(t, territory->getArmies());
+    }
+
+    return state;
+}
+
+const BoardTopology* BoardState::getTopology() const { return topology; }
+int BoardState::getSeatCount() const { return static_cast<int>(territoryCounts.size()); }
+
+int BoardState::getOwner(int territory) const { return owners[territory]; }
+int BoardState::getArmies(int territory) const { return armies[territory]; }
+const int32_t* BoardState::getOwnerData() const { return owners.data(); }
+const int32_t* BoardState::getArmyData() const { return armies.data(); }
+
+void BoardState::setOwner(int territory, int seat) {
+    int previous = owners[territory];
+    if (previous == seat) return;
+
+    if (previous >= 0) {
+        territoryCounts[previous]--;
+        armyTotals[previous] -= armies[territory];
+    }
+    if (seat >= 0) {
+        territoryCounts[seat]++;
+        armyTotals[seat] += armies[territory];
+    }
+    owners[territory] = seat;
+}
+
+void BoardState::setArmies(int territory, int count) {
+    if (owners[territory] >= 0) {
+        armyTotals[owners[territory]] += count - armies[territory];
+    }
+    armies[territory] = count;
+}
+
+int BoardState::getTerritoryCount(int seat) const { return territoryCounts[seat]; }
+int BoardState::getArmyTotal(int seat) const { return armyTotals[seat]; }
+
+int BoardState::getAliveCount() const {
+    int alive = 0;
+    for (int count : territoryCounts) {
+        if (count > 0) alive++;
+    }
+    return alive;
+}
+
+int BoardState::getWinner() const {
+    for (size_t seat = 0; seat < territoryCounts.size(); seat++) {
+        if (territoryCounts[seat] == static_cast<int>(owners.size())) return static_cast<int>(seat);
+    }
+    return -1;
+}
+
+int BoardState::getReinforcements(int seat) const {
+    int reinforcements = territoryCounts[seat] / 3;
+
+    for (int c = 0; c < topology->getContinentCount(); c++) {
+        bool ownsContinent = true;
+        for (const int* t = topology->continentBegin(c); t != topology->continentEnd(c); ++t) {
+            if (owners[*t] != seat) {
+                ownsContinent = false;
+                break;
+            }
+        }
+        if (ownsContinent) reinforcements += topology->getContinentBonus(c);
+    }
+
+    return max(reinforcements, 3);
+}
+
+bool BoardState::apply(int seat, const SimOrder& order, mt19937& gen) {
+    if (order.armies <= 0) return false;
+
+    // Deploy
+    if (order.source < 0) {
+        if (owners[order.target] != seat) return false;
+        setArmies(order.target, armies[order.target] + order.armies);
+        return true;
+    }
+
+    // Advance: same checks as Advance::validate (adjacency is guaranteed by how orders are planned)
+    if (owners[order.source] != seat || armies[order.source] < order.armies) return false;
+
+    setArmies(order.source, armies[order.source] - order.armies);
+
+    if (owners[order.target] == seat) {
+        setArmies(order.target, armies[order.target] + order.armies);
+        return true;
+    }
+
+    BattleResult battle = Advance::resolveBattle(order.armies, armies[order.target], gen);
+    if (battle.conquered) {
+        setOwner(order.target, seat);
+        setArmies(order.target, battle.attackersLeft);
+    }
+    else {
+        setArmies(order.target, battle.defendersLeft);
+    }
+
+    return true;
+}
+
+// TurnSimulator Implementation
+vector<TurnAction> TurnSimulator::candidateActions(const BoardState& state, int seat, int reinforcements, size_t maxActions) {
+    const BoardTopology* topology = state.getTopology();
+    vector<pair<double, TurnAction>> scored; // (conquest odds, with expected occupiers breaking ties, action)
+
+    int holdTerritory = -1;
+    int holdPressure = 0;
+
+    for (int t = 0; t < topology->getTerritoryCount(); t++) {
+        if (state.getOwner(t) != seat) continue;
+        if (holdTerritory < 0) holdTerritory = t;
+
+        int pressure = 0;
+        for (const int* n = topology->neighboursBegin(t); n != topology->neighboursEnd(t); ++n) {
+            if (state.getOwner(*n) == seat) continue;
+            pressure += state.getArmies(*n);
+            int attackers = state.getArmies(t) + reinforcements - 1;
+            double score = BattleOdds::conquestProbability(attackers, state.getArmies(*n))
+                + 0.001 * BattleOdds::expectedOccupyingArmies(attackers, state.getArmies(*n));
+            scored.push_back({ score, { t, t, *n } });
+        }
+
+        // Deploy-only turns reinforce the territory under the most pressure
+        pressure -= state.getArmies(t);
+        if (pressure > holdPressure) {
+            holdPressure = pressure;
+            holdTerritory = t;
+        }
+    }
+
+    size_t keep = min(scored.size(), maxActions > 0 ? maxActions - 1 : 0);
+    partial_sort(scored.begin(), scored.begin() + keep, scored.end(),
+        [](const pair<double, TurnAction>& a, const pair<double, TurnAction>& b) { return a.first > b.first; });
+
+    vector<TurnAction> actions;
+    actions.reserve(keep + 1);
+    for (size_t i = 0; i < keep; i++) {
+        actions.push_back(scored[i].second);
+    }
+    if (holdTerritory >= 0) {
+        actions.push_back({ holdTerritory, -1, -1 });
+    }
+
+    return actions;
+}
+
+vector<SimOrder> TurnSimulator::planTurn(const BoardState& state, int seat, const TurnAction& action, int reinforcements) {
+    const BoardTopology* topology = state.getTopology();
+    vector<SimOrder> plan;
+
+    auto available = [&](int t) {
+        return state.getArmies(t) + (t == action.deployTo ? reinforcements : 0);
+    };
+
+    if (action.deployTo >= 0 && reinforcements > 0) {
+        plan.push_back({ -1, action.deployTo, reinforcements });
+    }
+
+    if (action.attackTo >= 0 && state.getOwner(action.attackFrom) == seat && available(action.attackFrom) > 1) {
+        plan.push_back({ action.attackFrom, action.attackTo, available(action.attackFrom) - 1 });
+    }
+
+    // Follow-up attacks from every other territory that is more likely than not to take its weakest enemy neighbour
+    for (int t = 0; t < topology->getTerritoryCount(); t++) {
+        if (state.getOwner(t) != seat || t == action.attackFrom || available(t) <= 1) continue;
+
+        int weakest = -1;
+        for (const int* n = topology->neighboursBegin(t); n != topology->neighboursEnd(t); ++n) {
+            if (state.getOwner(*n) != seat && (weakest < 0 || state.getArmies(*n) < state.getArmies(weakest))) {
+                weakest = *n;
+            }
+        }
+
+        if (weakest >= 0 && BattleOdds::conquestProbability(available(t) - 1, state.getArmies(weakest)) >= 0.5) {
+            plan.push_back({ t, weakest, available(t) - 1 });
+        }
+    }
+
+    return plan;
+}
+
+void TurnSimulator::applyPlan(BoardState& state, int seat, const vector<SimOrder>& plan, mt19937& gen) {
+    for (const SimOrder& order : plan) {
+        state.apply(seat, order, gen);
+    }
+}
+
+void TurnSimulator::playRolloutTurn(BoardState& state, int seat, mt19937& gen) {
+    const BoardTopology* topology = state.getTopology();
+    int reinforcements = state.getReinforcements(seat);
+
+    // Deploy on the border territory with the best attack margin, or on a random border territory now and then
+    int bestFrom = -1;
+    int bestTarget = -1;
+    int bestMargin = 0;
+    int bordersSeen = 0;
+    uniform_int_distribution<int> percent(0, 99);
+    bool explore = percent(gen) < 25;
+
+    for (int t = 0; t < topology->getTerritoryCount(); t++) {
+        if (state.getOwner(t) != seat) continue;
+
+        int weakest = -1;
+        for (const int* n = topology->neighboursBegin(t); n != topology->neighboursEnd(t); ++n) {
+            if (state.getOwner(*n) != seat && (weakest < 0 || state.getArmies(*n) < state.getArmies(weakest))) {
+                weakest = *n;
+            }
+        }
+        if (weakest < 0) continue;
+
+        bordersSeen++;
+        int margin = state.getArmies(t) - state.getArmies(weakest);
+        bool take = explore ? uniform_int_distribution<int>(1, bordersSeen)(gen) == 1 // reservoir sample
+                            : (bestFrom < 0 || margin > bestMargin);
+        if (take) {
+            bestFrom = t;
+            bestTarget = weakest;
+            bestMargin = margin;
+        }
+    }
+
+    if (bestFrom < 0) return;
+
+    applyPlan(state, seat, planTurn(state, seat, { bestFrom, bestFrom, bestTarget }, reinforcements), gen);
+}
+
+void TurnSimulator::playCheaterTurn(BoardState& state, int seat) {
+    const BoardTopology* topology = state.getTopology();
+    vector<int> conquered;
+
+    for (int t = 0; t < topology->getTerritoryCount(); t++) {
+        if (state.getOwner(t) != seat) continue;
+        for (const int* n = topology->neighboursBegin(t); n != topology->neighboursEnd(t); ++n) {
+            if (state.getOwner(*n) != seat) conquered.push_back(*n);
+        }
+    }
+
+    for (int t : conquered) {
+        state.setOwner(t, seat);
+    }
+}
+
+double TurnSimulator::evaluate(const BoardState& state, int seat) {
+    if (state.getWinner() == seat) return 1.0;
+    if (state.getTerritoryCount(seat) == 0) return 0.0;
+
+    int totalArmies = 0;
+    for (int s = 0; s < state.getSeatCount(); s++) {
+        totalArmies += state.getArmyTotal(s);
+    }
+
+    double territoryShare = static_cast<double>(state.getTerritoryCount(seat)) / state.getTopology()->getTerritoryCount();
+    double armyShare = totalArmies > 0 ? static_cast<double>(state.getArmyTotal(seat)) / totalArmies : 0.0;
+
+    // Unfinished games stay strictly between a loss and a win
+    return 0.1 + 0.8 * (0.5 * territoryShare + 0.5 * armyShare);
+}
@@ -0,0 +1,117 @@
+#pragma once
+
+#include <cstdint>
+#include <random>
+#include <string>
+#include <unordered_map>
+#include <vector>
+using namespace std;
+
+//Forward declarations
+class Map;
+class Territory;
+class Player;
+
+// Immutable board layout shared by every simulated state: territories are numbered 0..n-1,
+// adjacency is stored in CSR form and continents are flattened to member lists.
+class BoardTopology {
+    private:
+        vector<Territory*> territories;
+        unordered_map<const Territory*, int> indices;
+        vector<int> adjacencyOffsets; // neighbours of t are adjacency[adjacencyOffsets[t] .. adjacencyOffsets[t + 1])
+        vector<int> adjacency;
+        vector<int> continentOffsets; // members of c are continentMembers[continentOffsets[c] .. continentOffsets[c + 1])
+        vector<int> continentMembers;
+        vector<int> continentBonuses;
+
+        void build(const vector<Territory*>& territoryList, const unordered_map<string, int>& bonuses);
+
+    public:
+        // Uses every territory and continent bonus of a loaded map
+        BoardTopology(Map* map);
+        // Discovers the board by walking adjacency from the given territories (continent bonuses count as 0)
+        BoardTopology(const vector<Territory*>& seeds);
+
+        int getTerritoryCount() const;
+        int getTerritoryIndex(const Territory* territory) const; // -1 if the territory is not on this board
+        Territory* getTerritory(int index) const;
+
+        const int* neighboursBegin(int index) const;
+        const int* neighboursEnd(int index) const;
+
+        int getContinentCount() const;
+        int getContinentBonus(int continent) const;
+        const int* continentBegin(int continent) const;
+        const int* continentEnd(int continent) const;
+};
+
+// One deploy + advance, expressed on board indices
+struct SimOrder {
+    int source;  // -1 for a deploy
+    int target;
+    int armies;
+};
+
+// Compact, cheaply copyable game state: copying a BoardState is the clone used by search rollouts.
+// Seats are dense player numbers, -1 marks territories nobody in the simulation owns.
+class BoardState {
+    private:
+        const BoardTopology* topology;
+        vector<int32_t> owners; // 32-bit so vectorised readers can gather them directly
+        vector<int32_t> armies;
+        vector<int32_t> territoryCounts; // per seat
+        vector<int32_t> armyTotals;      // per seat
+
+    public:
+        BoardState(const BoardTopology* topology, int seatCount);
+        // Snapshot of the live game; territories owned by players outside seats become unowned (-1)
+        static BoardState fromGame(const BoardTopology* topology, const vector<Player*>& seats);
+
+        const BoardTopology* getTopology() const;
+        int getSeatCount() const;
+
+        int getOwner(int territory) const;
+        int getArmies(int territory) const;
+        const int32_t* getOwnerData() const; // territory-indexed, for evaluators that read the whole board
+        const int32_t* getArmyData() const;
+        void setOwner(int territory, int seat);
+        void setArmies(int territory, int count);
+
+        int getTerritoryCount(int seat) const;
+        int getArmyTotal(int seat) const;
+        int getAliveCount() const;
+        int getWinner() const; // seat owning every territory, or -1
+
+        // Same rule as GameEngine::reinforcementPhase: territories / 3 + continent bonuses, at least 3
+        int getReinforcements(int seat) const;
+
+        // Applies a deploy or an advance with the Advance battle rules; returns false if the order was invalid
+        bool apply(int seat, const SimOrder& order, mt19937& gen);
+};
+
+// Macro action used by the search: deploy everything on one territory, then launch the main attack from it
+struct TurnAction {
+    int deployTo;
+    int attackFrom;
+    int attackTo; // -1 when the turn only deploys
+};
+
+// Fast turn policies and evaluation shared by rollouts and the search bot
+class TurnSimulator {
+    public:
+        // Best-looking macro actions for a seat, strongest first (a deploy-only action is always included)
+        static vector<TurnAction> candidateActions(const BoardState& state, int seat, int reinforcements, size_t maxActions);
+
+        // Orders for a macro action: deploy, main attack, then follow-up attacks from other territories
+        // likely to take their weakest enemy neighbour; planned on the board as it is before the turn
+        static vector<SimOrder> planTurn(const BoardState& state, int seat, const TurnAction& action, int reinforcements);
+
+        static void applyPlan(BoardState& state, int seat, const vector<SimOrder>& plan, mt19937& gen);
+
+        // Rollout policies for the opponents being modelled
+        static void playRolloutTurn(BoardState& state, int seat, mt19937& gen); // randomised greedy attacker
+        static void playCheaterTurn(BoardState& state, int seat);                // conquers every adjacent territory
+
+        // Score in [0, 1] for a seat: 1 for a win, 0 when eliminated, otherwise its share of the board
+        static double evaluate(const BoardState& state, int seat);
+};
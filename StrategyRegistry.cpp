@@ -0,0 +1,140 @@
+#include "StrategyRegistry.h"
+#include <algorithm>
+#include <cstdlib>
+#include <sstream>
+
+// ---------------------- StrategyParameters ----------------------------
+
+void StrategyParameters::set(const string& key, int value) {
+    values[key] = value;
+}
+
+bool StrategyParameters::has(const string& key) const {
+    return values.find(key) != values.end();
+}
+
+int StrategyParameters::get(const string& key, int defaultValue) const {
+    auto it = values.find(key);
+    return it == values.end() ? defaultValue : it->second;
+}
+
+const unordered_map<string, int>& StrategyParameters::getValues() const {
+    return values;
+}
+
+// ---------------------- StrategyRegistry ----------------------------
+
+vector<StrategyRegistry::Entry>& StrategyRegistry::entries() {
+    static vector<Entry> registered;
+    return registered;
+}
+
+bool StrategyRegistry::add(StrategyKind kind, const string& name, const vector<string>& parameterNames,
+                           bool tournamentAllowed, Factory create) {
+    vector<Entry>& registered = entries();
+
+    // Keep the table in kind order so listings are stable whatever order the registrations ran in
+    auto position = find_if(registered.begin(), registered.end(),
+        [kind](const Entry& entry) { return entry.kind >= kind; });
+
+    if (position != registered.end() && position->kind == kind) {
+        *position = Entry{ kind, name, parameterNames, tournamentAllowed, create };
+    }
+    else {
+        registered.insert(position, Entry{ kind, name, parameterNames, tournamentAllowed, create });
+    }
+
+    return true;
+}
+
+const StrategyRegistry::Entry* StrategyRegistry::find(StrategyKind kind) {
+    for (const Entry& entry : entries()) {
+        if (entry.kind == kind) return &entry;
+    }
+    return nullptr;
+}
+
+const StrategyRegistry::Entry* StrategyRegistry::find(const string& name) {
+    for (const Entry& entry : entries()) {
+        if (entry.name == name) return &entry;
+    }
+    return nullptr;
+}
+
+bool StrategyRegistry::parse(const string& spec, const Entry*& entry, StrategyParameters& parameters, string* error) {
+    auto fail = [error](const string& reason) {
+        if (error) *error = reason;
+        return false;
+    };
+
+    entry = nullptr;
+    parameters = StrategyParameters();
+
+    stringstream stream(spec);
+    string part;
+    getline(stream, part, ':');
+
+    entry = find(part);
+    if (entry == nullptr) {
+        return fail("unknown strategy \"" + part + "\"");
+    }
+
+    while (getline(stream, part, ':')) {
+        size_t equals = part.find('=');
+        if (equals == string::npos) {
+            return fail("expected key=value, got \"" + part + "\"");
+        }
+
+        string key = part.substr(0, equals);
+        string value = part.substr(equals + 1);
+
+        if (std::find(entry->parameterNames.begin(), entry->parameterNames.end(), key) == entry->parameterNames.end()) {
+            return fail(entry->name + " has no parameter \"" + key + "\"");
+        }
+
+        char* end = nullptr;
+        long number = strtol(value.c_str(), &end, 10);
+        if (value.empty() || *end != '\0') {
+            return fail("parameter \"" + key + "\" needs an integer, got \"" + value + "\"");
+        }
+
+        parameters.set(key, static_cast<int>(number));
+    }
+
+    return true;
+}
+
+PlayerStrategy* StrategyRegistry::create(const string& spec, string* error) {
+    const Entry* entry = nullptr;
+    StrategyParameters parameters;
+
+    if (!parse(spec, entry, parameters, error)) {
+        return nullptr;
+    }
+
+    return entry->create(parameters);
+}
+
+bool StrategyRegistry::isValid(const string& spec, bool forTournament) {
+    const Entry* entry = nullptr;
+    StrategyParameters parameters;
+
+    if (!parse(spec, entry, parameters)) {
+        return false;
+    }
+
+    return !forTournament || entry->tournamentAllowed;
+}
+
+vector<string> StrategyRegistry::getNames() {
+    vector<string> names;
+    for (const Entry& entry : entries()) {
+        names.push_back(entry.name);
+    }
+    return names;
+}
+
+string StrategyRegistry::getName(StrategyKind kind) {
+    const Entry* entry = find(kind);
+    return entry ? entry->name : "Abstract";
+}
@@ -0,0 +1,58 @@
+#pragma once
+
+#include <functional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "PlayerStrategies.h"
+using namespace std;
+
+// Integer parameters of a strategy spec ("Aggressive:split=3" gives { "split": 3 })
+class StrategyParameters {
+    private:
+        unordered_map<string, int> values;
+
+    public:
+        void set(const string& key, int value);
+        bool has(const string& key) const;
+        int get(const string& key, int defaultValue) const;
+        const unordered_map<string, int>& getValues() const;
+};
+
+// Table of every strategy the game can create, keyed by StrategyKind and by name.
+// Strategies register themselves from their own translation unit, so adding one never touches
+// the engine or the command parser. Specs look like "Name" or "Name:key=value:key=value".
+class StrategyRegistry {
+    public:
+        using Factory = function<PlayerStrategy*(const StrategyParameters& parameters)>;
+
+        struct Entry {
+            StrategyKind kind;
+            string name;
+            vector<string> parameterNames; // keys a spec may set, anything else is rejected
+            bool tournamentAllowed;
+            Factory create;
+        };
+
+        // Adds a strategy; returns true so it can initialise a static registration flag
+        static bool add(StrategyKind kind, const string& name, const vector<string>& parameterNames,
+                        bool tournamentAllowed, Factory create);
+
+        // Lookups return nullptr when nothing is registered under the kind or name
+        static const Entry* find(StrategyKind kind);
+        static const Entry* find(const string& name);
+
+        // Splits a spec into its entry and parameters; returns false (with a reason) if it is malformed
+        static bool parse(const string& spec, const Entry*& entry, StrategyParameters& parameters, string* error = nullptr);
+        // Builds the strategy described by a spec (unattached to any player), or nullptr if the spec is invalid
+        static PlayerStrategy* create(const string& spec, string* error = nullptr);
+        // Returns if a spec is valid, and allowed in tournaments when asked
+        static bool isValid(const string& spec, bool forTournament = false);
+
+        // Registered names in kind order
+        static vector<string> getNames();
+        static string getName(StrategyKind kind);
+
+    private:
+        static vector<Entry>& entries(); // constructed on first use so registration order does not matter
+};
@@ -0,0 +1,152 @@
+#include "StrategyTuner.h"
+#include "GameEngine.h"
+#include "ThreadPool.h"
+#include "ConsoleLog.h"
+#include <algorithm>
+#include <fstream>
+#include <numeric>
+
+StrategyTuner::StrategyTuner(const TunerSettings& settings) : settings(settings) {
+    this->settings.populationSize = max(2, settings.populationSize);
+    this->settings.eliteCount = min(max(0, settings.eliteCount), this->settings.populationSize - 1);
+}
+
+double StrategyTuner::scoreGame(const GameResult& result, size_t seat) {
+    if (!result.played) return 0.0;
+    if (result.winner >= 0) return result.winner == static_cast<int>(seat) ? 1.0 : 0.0;
+
+    int total = accumulate(result.territoryCounts.begin(), result.territoryCounts.end(), 0);
+    return total > 0 ? 0.5 * result.territoryCounts[seat] / total : 0.0;
+}
+
+void StrategyTuner::evaluate(vector<Candidate>& population, int generation, ThreadPool& pool) const {
+    size_t seats = settings.opponents.size() + 1;
+    size_t gamesPerCandidate = settings.maps.size() * settings.gamesPerMap;
+    vector<double> scores(population.size() * gamesPerCandidate, 0.0);
+
+    pool.parallelFor(scores.size(), [&](size_t task) {
+        size_t candidate = task / gamesPerCandidate;
+        size_t game = task % gamesPerCandidate;
+
+        // The candidate takes every seat in turn so no weights win just by moving first
+        size_t seat = game % seats;
+        vector<string> specs = settings.opponents;
+        specs.insert(specs.begin() + seat, population[candidate].parameters.toSpec());
+
+        bool wasQuiet = ConsoleLog::isQuiet();
+        ConsoleLog::setQuiet(true);
+
+        GameEngine engine;
+        engine.setSeed(settings.seed + static_cast<unsigned int>(generation * gamesPerCandidate + game) * 7919u);
+        GameResult result = engine.playGame(settings.maps[game / settings.gamesPerMap], specs, settings.maxTurns);
+
+        ConsoleLog::setQuiet(wasQuiet);
+        scores[task] = scoreGame(result, seat);
+    });
+
+    for (size_t candidate = 0; candidate < population.size(); candidate++) {
+        auto first = scores.begin() + candidate * gamesPerCandidate;
+        population[candidate].fitness = gamesPerCandidate > 0
+            ? accumulate(first, first + gamesPerCandidate, 0.0) / gamesPerCandidate : 0.0;
+    }
+}
+
+HeuristicParameters StrategyTuner::breed(const vector<Candidate>& population, mt19937& gen) const {
+    uniform_int_distribution<size_t> pick(0, population.size() - 1);
+    auto select = [&]() -> const HeuristicParameters& {
+        // Tournament of three
+        size_t best = pick(gen);
+        for (int i = 0; i < 2; i++) {
+            size_t challenger = pick(gen);
+            if (population[challenger].fitness > population[best].fitness) best = challenger;
+        }
+        return population[best].parameters;
+    };
+
+    const HeuristicParameters& mother = select();
+    const HeuristicParameters& father = select();
+
+    bernoulli_distribution coin(0.5);
+    bernoulli_distribution mutate(settings.mutationRate);
+    normal_distribution<double> step(0.0, settings.mutationScale);
+
+    HeuristicParameters child;
+    for (int i = 0; i < HeuristicParameters::Count; i++) {
+        int value = coin(gen) ? mother.get(i) : father.get(i);
+        if (mutate(gen)) {
+            int range = HeuristicParameters::getMaximum(i) - HeuristicParameters::getMinimum(i);
+            value += static_cast<int>(lround(step(gen) * range));
+        }
+        child.set(i, value); // clamps into range
+    }
+    return child;
+}
+
+HeuristicParameters StrategyTuner::run() {
+    history.clear();
+    mt19937 gen(settings.seed);
+    ThreadPool pool(settings.threads);
+    ostream& out = ConsoleLog::out();
+
+    // Start from the hand-picked defaults plus random weights across the whole range
+    vector<Candidate> population(settings.populationSize);
+    for (size_t candidate = 1; candidate < population.size(); candidate++) {
+        for (int i = 0; i < HeuristicParameters::Count; i++) {
+            uniform_int_distribution<int> value(HeuristicParameters::getMinimum(i), HeuristicParameters::getMaximum(i));
+            population[candidate].parameters.set(i, value(gen));
+        }
+    }
+
+    auto fitter = [](const Candidate& a, const Candidate& b) { return a.fitness > b.fitness; };
+
+    for (int generation = 0; generation < settings.generations; generation++) {
+        evaluate(population, generation, pool);
+        stable_sort(population.begin(), population.end(), fitter);
+
+        double total = 0.0;
+        for (const Candidate& candidate : population) total += candidate.fitness;
+        history.push_back({ generation, population.front().fitness, total / population.size(), population.front().parameters });
+
+        out << "Generation " << generation << ": best " << population.front().fitness
+            << ", mean " << history.back().meanFitness << ", " << population.front().parameters.toSpec() << "\n";
+
+        if (generation + 1 == settings.generations) break;
+
+        vector<Candidate> next(population.begin(), population.begin() + settings.eliteCount);
+        while (next.size() < population.size()) {
+            next.push_back({ breed(population, gen), 0.0 });
+        }
+        population.swap(next);
+    }
+
+    writeResults();
+    return history.empty() ? HeuristicParameters() : history.back().best;
+}
+
+void StrategyTuner::writeResults() const {
+    if (history.empty()) return;
+
+    if (!settings.bestFile.empty()) {
+        ofstream best(settings.bestFile);
+        best << history.back().best.toSpec() << "\n";
+        if (!best) ConsoleLog::out() << "Could not write " << settings.bestFile << "\n";
+    }
+
+    if (!settings.logFile.empty()) {
+        ofstream log(settings.logFile);
+        log << "generation,best,mean";
+        for (const string& name : HeuristicParameters::getNames()) log << "," << name;
+        log << "\n";
+
+        for (const GenerationSummary& summary : history) {
+            log << summary.generation << "," << summary.bestFitness << "," << summary.meanFitness;
+            for (int i = 0; i < HeuristicParameters::Count; i++) log << "," << summary.best.get(i);
+            log << "\n";
+        }
+        if (!log) ConsoleLog::out() << "Could not write " << settings.logFile << "\n";
+    }
+}
+
+const vector<GenerationSummary>& StrategyTuner::getHistory() const {
+    return history;
+}
@@ -0,0 +1,68 @@
+#pragma once
+
+#include <random>
+#include <string>
+#include <vector>
+#include "PlayerStrategies.h"
+using namespace std;
+
+struct GameResult;
+class ThreadPool;
+
+// What a tuning run plays and how its evolutionary search is shaped
+struct TunerSettings {
+    vector<string> maps;             // map files every candidate is scored on
+    vector<string> opponents;        // strategy specs seated with the candidate
+    int gamesPerMap = 2;             // games per map and candidate in every generation
+    int maxTurns = 50;               // a game still running after this many turns is a draw
+    int populationSize = 16;
+    int generations = 10;
+    int eliteCount = 2;              // best candidates carried unchanged into the next generation
+    double mutationRate = 0.3;       // chance each weight of a child is perturbed
+    double mutationScale = 0.2;      // standard deviation of a perturbation, as a share of the weight's range
+    unsigned int seed = 1;           // drives both the search and the games, so a run can be repeated
+    size_t threads = 0;              // game threads, 0 uses every core
+    string bestFile;                 // the best spec is written here when set
+    string logFile;                  // one CSV line per generation is written here when set
+};
+
+// Scores of one generation
+struct GenerationSummary {
+    int generation;
+    double bestFitness;
+    double meanFitness;
+    HeuristicParameters best;
+};
+
+// Tunes the weights of HeuristicPlayerStrategy by self-play: a genetic algorithm whose candidates are
+// scored by headless games against fixed opponents. Every (candidate, game) pair of a generation is an
+// independent game, so they all run side by side on a thread pool. Within a generation every candidate
+// plays the same seeds (common random numbers), so differences in fitness come from the weights and not
+// from the dice.
+class StrategyTuner {
+    private:
+        struct Candidate {
+            HeuristicParameters parameters;
+            double fitness;
+        };
+
+        TunerSettings settings;
+        vector<GenerationSummary> history;
+
+        // Plays every game of a generation and fills in the candidates' fitness
+        void evaluate(vector<Candidate>& population, int generation, ThreadPool& pool) const;
+        // Child of two tournament-selected parents (uniform crossover, then gaussian mutation)
+        HeuristicParameters breed(const vector<Candidate>& population, mt19937& gen) const;
+        void writeResults() const;
+
+    public:
+        explicit StrategyTuner(const TunerSettings& settings);
+
+        // Runs every generation and returns the best weights of the last one
+        HeuristicParameters run();
+
+        // Fitness of a game for the candidate's seat: 1 for a win, 0 for a loss, and half its share of the map for a draw
+        static double scoreGame(const GameResult& result, size_t seat);
+
+        const vector<GenerationSummary>& getHistory() const;
+};
@@ -0,0 +1,71 @@
+#include "ThreadPool.h"
+
+ThreadPool::ThreadPool(size_t threadCount) : stopping(false) {
+    if (threadCount == 0) {
+        threadCount = max(1u, thread::hardware_concurrency());
+    }
+
+    workers.reserve(threadCount);
+    for (size_t i = 0; i < threadCount; i++) {
+        workers.emplace_back(&ThreadPool::workerLoop, this);
+    }
+}
+
+ThreadPool::~ThreadPool() {
+    {
+        lock_guard<mutex> lock(queueMutex);
+        stopping = true;
+    }
+    taskAvailable.notify_all();
+
+    for (thread& worker : workers) {
+        worker.join();
+    }
+}
+
+size_t ThreadPool::size() const {
+    return workers.size();
+}
+
+void ThreadPool::workerLoop() {
+    while (true) {
+        function<void()> task;
+        {
+            unique_lock<mutex> lock(queueMutex);
+            taskAvailable.wait(lock, [this]() { return stopping || !tasks.empty(); });
+
+            // Drain the queue before stopping so no submitted future is left unfulfilled
+            if (tasks.empty()) {
+                return;
+            }
+
+            task = move(tasks.front());
+            tasks.pop();
+        }
+        task();
+    }
+}
+
+void ThreadPool::parallelFor(size_t count, const function<void(size_t)>& body) {
+    vector<future<void>> pending;
+    pending.reserve(count);
+
+    for (size_t i = 0; i < count; i++) {
+        pending.push_back(submit([&body, i]() { body(i); }));
+    }
+
+    // Every task borrows body, so wait for all of them before rethrowing the first failure
+    exception_ptr failure;
+    for (future<void>& task : pending) {
+        try {
+            task.get();
+        }
+        catch (...) {
+            if (!failure) failure = current_exception();
+        }
+    }
+
+    if (failure) {
+        rethrow_exception(failure);
+    }
+}
@@ -0,0 +1,57 @@
+#pragma once
+
+#include <condition_variable>
+#include <exception>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <queue>
+#include <thread>
+#include <type_traits>
+#include <vector>
+using namespace std;
+
+// Fixed-size pool of worker threads that run submitted tasks in FIFO order.
+// Shared by anything that needs to spread independent work across cores (search rollouts, batch games, ...).
+class ThreadPool {
+    private:
+        vector<thread> workers;
+        queue<function<void()>> tasks;
+        mutex queueMutex;
+        condition_variable taskAvailable;
+        bool stopping;
+
+        // Loop run by every worker until the pool is destroyed
+        void workerLoop();
+
+    public:
+        // Creates the given number of workers (0 uses the hardware concurrency)
+        explicit ThreadPool(size_t threadCount = 0);
+
+        // Pools own threads, so they cannot be copied
+        ThreadPool(const ThreadPool& other) = delete;
+        ThreadPool& operator=(const ThreadPool& other) = delete;
+
+        // Finishes the queued tasks, then joins the workers
+        ~ThreadPool();
+
+        size_t size() const;
+
+        // Queues a task and returns a future for its result
+        template <typename F>
+        future<invoke_result_t<F>> submit(F&& task) {
+            using Result = invoke_result_t<F>;
+            auto packaged = make_shared<packaged_task<Result()>>(forward<F>(task));
+            future<Result> result = packaged->get_future();
+            {
+                lock_guard<mutex> lock(queueMutex);
+                tasks.emplace([packaged]() { (*packaged)(); });
+            }
+            taskAvailable.notify_one();
+            return result;
+        }
+
+        // Runs body(0) ... body(count - 1) on the pool and waits for all of them (must not be called from a worker)
+        void parallelFor(size_t count, const function<void(size_t)>& body);
+};
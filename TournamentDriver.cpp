@@ -1,8 +1,32 @@
 #include "CommandProcessing.h"
 #include "GameEngine.h"
+#include "PlayerStrategies.h"
+#include "StrategyTuner.h"
+#include "ConsoleLog.h"
+#include "Map.h"
 #include <iostream>
 using namespace std;
 
+// Territories of a map that loads and validates (0 otherwise); the tournament counts a game on a map it
+// cannot load as a draw, so a driver checks its maps before reading anything into the results
+static int countPlayableTerritories(const string& mapFile) {
+    Map* map = MapLoader::loadMap(mapFile);
+    int count = map && map->validate() ? static_cast<int>(map->getTerritories().size()) : 0;
+    delete map;
+    return count;
+}
+
+// Prints one check line per map and returns whether every map has a board to play on
+static bool checkMaps(const vector<string>& maps) {
+    bool playable = true;
+    for (const string& mapFile : maps) {
+        int territories = countPlayableTerritories(mapFile);
+        cout << "[Check] " << mapFile << " loads with " << territories << " territories: " << (territories > 0 ? "yes" : "NO") << "\n";
+        playable = playable && territories > 0;
+    }
+    return playable;
+}
+
 /*
  * testTournament()
  * Demonstrates:
@@ -61,3 +85,117 @@ void testTournament()
 
     delete cmd;
 }
+
+/*
+ * benchmarkMCTSTournament()
+ * Plays MCTS against Aggressive in tournament mode and reports
+ * the MCTS win rate and how fast it makes decisions.
+ */
+void benchmarkMCTSTournament()
+{
+    cout << "=== MCTS vs Aggressive Benchmark ===\n\n";
+
+    vector<string> maps = { "England.map", "Florida.map" };
+    vector<string> strategies = { "MCTS", "Aggressive" };
+    const int games = 5;
+    const int maxTurns = 30;
+
+    if (!checkMaps(maps)) {
+        cout << "Cannot benchmark on an empty board.\n\n=== MCTS Benchmark Complete ===\n";
+        return;
+    }
+    cout << "\n";
+
+    MCTSPlayerStrategy::resetStatistics();
+
+    GameEngine engine;
+    ConsoleLog::setQuiet(true); // Silence game output
+    vector<vector<string>> results = engine.runTournament(maps, strategies, games, maxTurns);
+    ConsoleLog::setQuiet(false);
+
+    int played = 0, mctsWins = 0, aggressiveWins = 0;
+    for (const vector<string>& mapResults : results) {
+        for (const string& winner : mapResults) {
+            played++;
+            if (winner == "MCTS") mctsWins++;
+            else if (winner == "Aggressive") aggressiveWins++;
+        }
+    }
+
+    MCTSStatistics stats = MCTSPlayerStrategy::getStatistics();
+
+    cout << "Games played: " << played << " (" << maxTurns << " turns max)\n";
+    cout << "MCTS wins: " << mctsWins << ", Aggressive wins: " << aggressiveWins
+         << ", draws: " << (played - mctsWins - aggressiveWins) << "\n";
+    if (played > 0) {
+        cout << "MCTS win rate: " << (100.0 * mctsWins / played) << "%\n";
+    }
+    if (stats.seconds > 0) {
+        cout << "Decisions: " << stats.decisions << " (" << (stats.decisions / stats.seconds) << " per second)\n";
+        cout << "Rollouts: " << stats.rollouts << " (" << (stats.rollouts / stats.seconds) << " per second)\n";
+    }
+
+    cout << "\n=== MCTS Benchmark Complete ===\n";
+}
+
+/*
+ * testStrategyTuner()
+ * Tunes the Heuristic strategy against Aggressive and Benevolent with a
+ * small genetic search, then checks the tuned weights in a tournament.
+ */
+void testStrategyTuner()
+{
+    cout << "=== Heuristic Strategy Tuner ===\n\n";
+
+    TunerSettings settings;
+    settings.maps = { "England.map", "Florida.map" };
+    settings.opponents = { "Aggressive", "Benevolent" };
+    settings.gamesPerMap = 3;
+    settings.maxTurns = 30;
+    settings.populationSize = 8;
+    settings.generations = 4;
+    settings.seed = 345;
+    settings.bestFile = "heuristic_best.txt";
+    settings.logFile = "heuristic_tuning.csv";
+
+    if (!checkMaps(settings.maps)) {
+        cout << "Cannot tune on an empty board.\n\n=== Tuner Driver Complete ===\n";
+        return;
+    }
+
+    StrategyTuner tuner(settings);
+    HeuristicParameters best = tuner.run();
+
+    const vector<GenerationSummary>& history = tuner.getHistory();
+    cout << "\nDefault weights: " << HeuristicParameters().toSpec() << "\n";
+    cout << "Tuned weights:   " << best.toSpec() << "\n";
+    if (!history.empty()) {
+        cout << "Best fitness went from " << history.front().bestFitness << " to " << history.back().bestFitness << "\n";
+    }
+
+    // Candidates that all score the same (every game a draw on an empty board, say) leave the search nothing to select
+    bool spread = !history.empty();
+    for (const GenerationSummary& summary : history) {
+        spread = spread && summary.bestFitness > summary.meanFitness;
+    }
+    cout << "[Check] Fitness differs across the population in every generation: " << (spread ? "yes" : "NO") << "\n";
+    cout << "Best spec written to " << settings.bestFile << ", convergence log to " << settings.logFile << "\n\n";
+
+    // The tuned spec is an ordinary strategy spec, so tournaments accept it as is
+    GameEngine engine;
+    engine.setSeed(settings.seed);
+    ConsoleLog::setQuiet(true);
+    vector<vector<string>> results = engine.runTournament(settings.maps, { best.toSpec(), "Aggressive", "Benevolent" }, 2, settings.maxTurns);
+    ConsoleLog::setQuiet(false);
+
+    int wins = 0, played = 0;
+    for (const vector<string>& mapResults : results) {
+        for (const string& winner : mapResults) {
+            played++;
+            if (winner == best.toSpec()) wins++;
+        }
+    }
+    cout << "Tuned Heuristic won " << wins << " of " << played << " tournament games\n";
+
+    cout << "\n=== Tuner Driver Complete ===\n";
+}
@@ -4,3 +4,5 @@
 using namespace std;
 
 void testTournament();
+void benchmarkMCTSTournament();
+void testStrategyTuner();
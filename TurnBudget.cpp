@@ -0,0 +1,64 @@
+#include "TurnBudget.h"
+#include <algorithm>
+
+// ---------------------- CancellationToken ----------------------------
+
+CancellationToken::CancellationToken() : cancelled(false) {}
+
+void CancellationToken::cancel() {
+    cancelled.store(true, memory_order_relaxed);
+}
+
+void CancellationToken::reset() {
+    cancelled.store(false, memory_order_relaxed);
+}
+
+bool CancellationToken::isCancelled() const {
+    return cancelled.load(memory_order_relaxed);
+}
+
+// ---------------------- TurnBudget ----------------------------
+
+TurnBudget::TurnBudget()
+    : start(chrono::steady_clock::now()), deadline(chrono::steady_clock::time_point::max()), token(nullptr) {}
+
+TurnBudget::TurnBudget(chrono::milliseconds limit, const CancellationToken* token)
+    : start(chrono::steady_clock::now()), deadline(chrono::steady_clock::time_point::max()), token(token) {
+    if (limit.count() > 0) {
+        deadline = start + limit;
+    }
+}
+
+TurnBudget TurnBudget::limitedTo(chrono::milliseconds limit) const {
+    TurnBudget result = *this;
+    if (limit.count() > 0 && start + limit < deadline) {
+        result.deadline = start + limit;
+    }
+    return result;
+}
+
+bool TurnBudget::isLimited() const {
+    return deadline != chrono::steady_clock::time_point::max();
+}
+
+bool TurnBudget::isCancelled() const {
+    return token != nullptr && token->isCancelled();
+}
+
+bool TurnBudget::expired() const {
+    return isCancelled() || (isLimited() && chrono::steady_clock::now() >= deadline);
+}
+
+chrono::steady_clock::time_point TurnBudget::getDeadline() const {
+    return deadline;
+}
+
+chrono::steady_clock::duration TurnBudget::elapsed() const {
+    return chrono::steady_clock::now() - start;
+}
+
+chrono::steady_clock::duration TurnBudget::remaining() const {
+    if (!isLimited()) return chrono::steady_clock::duration::max();
+    if (isCancelled()) return chrono::steady_clock::duration::zero();
+    return max(chrono::steady_clock::duration::zero(), deadline - chrono::steady_clock::now());
+}
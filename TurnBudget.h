@@ -0,0 +1,45 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+using namespace std;
+
+// Lets whoever runs a turn stop it early (e.g. a server shutting a game down). Planners never cancel
+// it themselves, they only poll it through their TurnBudget.
+class CancellationToken {
+    private:
+        atomic<bool> cancelled;
+
+    public:
+        CancellationToken();
+
+        void cancel(); // safe to call from any thread
+        void reset();
+        bool isCancelled() const;
+};
+
+// Time a strategy may spend planning one turn, counted from construction. Anytime planners poll
+// expired() and return the best orders found so far once it turns true.
+class TurnBudget {
+    private:
+        chrono::steady_clock::time_point start;
+        chrono::steady_clock::time_point deadline;
+        const CancellationToken* token;
+
+    public:
+        // No deadline and nothing to cancel it
+        TurnBudget();
+        // A limit of zero or less means no deadline; the token (if any) must outlive the budget
+        explicit TurnBudget(chrono::milliseconds limit, const CancellationToken* token = nullptr);
+
+        // Same start and token, with the deadline pulled in to at most limit after the start
+        TurnBudget limitedTo(chrono::milliseconds limit) const;
+
+        bool isLimited() const;
+        bool isCancelled() const;
+        bool expired() const; // cancelled or past the deadline
+
+        chrono::steady_clock::time_point getDeadline() const; // time_point::max() without a deadline
+        chrono::steady_clock::duration elapsed() const;
+        chrono::steady_clock::duration remaining() const;     // zero once expired, duration::max() without a deadline
+};
@@ -0,0 +1,107 @@
+#include "TurnPlan.h"
+#include "Orders.h"
+#include "Player.h"
+#include <stdexcept>
+
+GameView::GameView(Player* player, const TurnBudget& budget) : player(player), budget(budget) {}
+
+Player* GameView::getPlayer() const {
+    return player;
+}
+
+const TurnBudget& GameView::getBudget() const {
+    return budget;
+}
+
+int GameView::getReinforcements() const {
+    return player->getArmies();
+}
+
+const vector<Territory*>& GameView::getTerritories() const {
+    return player->getTerritories();
+}
+
+const vector<Territory*>& GameView::getFrontier() const {
+    return player->getFrontier();
+}
+
+const vector<Territory*>& GameView::getAttackable() const {
+    return player->getAttackable();
+}
+
+Hand* GameView::getHand() const {
+    return player->getHand();
+}
+
+TurnPlan::TurnPlan() = default;
+TurnPlan::TurnPlan(TurnPlan&& other) noexcept
+    : orders(move(other.orders)), playedCards(move(other.playedCards)), deployedArmies(other.takeDeployedArmies()) {}
+
+TurnPlan& TurnPlan::operator=(TurnPlan&& other) noexcept {
+    orders = move(other.orders);
+    playedCards = move(other.playedCards);
+    deployedArmies = other.takeDeployedArmies(); // a moved-from plan must not charge the pool again
+    return *this;
+}
+
+TurnPlan::~TurnPlan() = default; // Order is complete here
+
+void TurnPlan::add(Order* order) {
+    if (!order) throw invalid_argument("Cannot add null order");
+    if (order->getType() == OrderType::Deploy) deployedArmies += order->getOperands().armies;
+    orders.emplace_back(order);
+}
+
+void TurnPlan::playCard(Player* player, Card* card, const CardPlayContext& context) {
+    Order* order = card->createOrder(player, context);
+    if (order) orders.emplace_back(order);
+
+    playedCards.push_back(card->getType());
+    player->getHand()->removeCard(card); // destroys the card
+}
+
+void TurnPlan::playCard(Player* player, CardType type, const CardPlayContext& context) {
+    Order* order = Card(type).createOrder(player, context);
+    if (order) orders.emplace_back(order);
+
+    playedCards.push_back(type);
+    player->getHand()->removeCard(type);
+}
+
+bool TurnPlan::empty() const {
+    return orders.empty() && playedCards.empty();
+}
+
+size_t TurnPlan::size() const {
+    return orders.size();
+}
+
+const vector<unique_ptr<Order>>& TurnPlan::getOrders() const {
+    return orders;
+}
+
+const vector<CardType>& TurnPlan::getPlayedCards() const {
+    return playedCards;
+}
+
+int TurnPlan::getDeployedArmies() const {
+    return deployedArmies;
+}
+
+vector<unique_ptr<Order>> TurnPlan::takeOrders() {
+    vector<unique_ptr<Order>> taken;
+    taken.swap(orders);
+    return taken;
+}
+
+vector<CardType> TurnPlan::takePlayedCards() {
+    vector<CardType> taken;
+    taken.swap(playedCards);
+    return taken;
+}
+
+int TurnPlan::takeDeployedArmies() {
+    int taken = deployedArmies;
+    deployedArmies = 0;
+    return taken;
+}
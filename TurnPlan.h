@@ -0,0 +1,66 @@
+#pragma once
+
+#include <memory>
+#include <vector>
+#include "Cards.h"
+#include "TurnBudget.h"
+using namespace std;
+
+class Order;
+class Player;
+class Hand;
+class Territory;
+
+// What a strategy gets to see when it plans a turn: the player it plays for and the time it has.
+// The board itself is reached through the player's territories, as everywhere else.
+class GameView {
+    private:
+        Player* player;
+        TurnBudget budget;
+
+    public:
+        explicit GameView(Player* player, const TurnBudget& budget = TurnBudget());
+
+        Player* getPlayer() const;
+        const TurnBudget& getBudget() const;
+
+        int getReinforcements() const; // armies still to deploy this turn
+        const vector<Territory*>& getTerritories() const;
+        const vector<Territory*>& getFrontier() const;
+        const vector<Territory*>& getAttackable() const;
+        Hand* getHand() const;
+};
+
+// A whole turn of orders, in the order they were planned, built without touching the player's orders
+// list, the deck or the reinforcement pool. Player::issueOrders moves it into the orders list in one step
+// and only then takes the deployed armies out of the pool and returns the played cards to the deck, so
+// several players can plan side by side.
+class TurnPlan {
+    private:
+        vector<unique_ptr<Order>> orders;
+        vector<CardType> playedCards; // already out of the hand, due back to the deck
+        int deployedArmies = 0;       // armies the added deploys take from the reinforcement pool
+
+    public:
+        TurnPlan();
+        TurnPlan(TurnPlan&& other) noexcept;
+        TurnPlan& operator=(TurnPlan&& other) noexcept;
+        ~TurnPlan();
+
+        void add(Order* order); // takes ownership; a deploy counts against the reinforcement pool
+        // Adds the card's order and takes the card out of the player's hand
+        void playCard(Player* player, Card* card, const CardPlayContext& context);
+        // Same for a card of this type, without going through the hand's card view
+        void playCard(Player* player, CardType type, const CardPlayContext& context);
+
+        bool empty() const;
+        size_t size() const;
+        const vector<unique_ptr<Order>>& getOrders() const;
+        const vector<CardType>& getPlayedCards() const;
+        int getDeployedArmies() const;
+
+        // Hand the contents over, leaving the plan empty
+        vector<unique_ptr<Order>> takeOrders();
+        vector<CardType> takePlayedCards();
+        int takeDeployedArmies();
+};